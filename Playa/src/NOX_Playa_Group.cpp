@@ -52,6 +52,7 @@
 #include "PlayaMPIComm.hpp"
 #include "PlayaOut.hpp"
 #include "PlayaTabs.hpp"
+#include "PlayaJacobianFreeOp.hpp"
 
 using Playa::Out;
 using Playa::Tabs;
@@ -446,6 +447,11 @@ NOX::NOXPlaya::Group::applyJacobianTranspose(const NOX::NOXPlaya::Vector& input,
   {
     return NOX::Abstract::Group::BadDependency;
   }
+  else if (dynamic_cast<const Playa::JacobianFreeOp*>(jacobian.ptr().get()) != 0)
+  {
+    // A Jacobian-free operator can't be transposed
+    return NOX::Abstract::Group::NotDefined;
+  }
   else
   {
     // Compute result = J^T * input
@@ -46,6 +46,8 @@
 #include "Ifpack_Preconditioner.h"
 #include "Ifpack.h"
 #include "EpetraPlayaOperator.hpp"
+#include "PlayaPreconditioningMatrixOp.hpp"
+#include "Epetra_LinearProblem.h"
 #include "Teuchos_basic_oblackholestream.hpp"
 
 
@@ -81,6 +83,9 @@ AztecSolver::AztecSolver(const ParameterList& params)
     aztec_recursive_iterate_(false),
     precParams_(),
     userPrec_(),
+    reusePrec_(false),
+    lastPrecOp_(),
+    lastPrec_(),
     aztec_status(AZ_STATUS_SIZE),
     aztec_proc_config(AZ_PROC_SIZE)
 {
@@ -179,6 +184,9 @@ AztecSolver::AztecSolver(const Teuchos::map<int, int>& aztecOptions,
     aztec_recursive_iterate_(false),
     precParams_(),
     userPrec_(),
+    reusePrec_(false),
+    lastPrecOp_(),
+    lastPrec_(),
     aztec_status(AZ_STATUS_SIZE),
     aztec_proc_config(AZ_PROC_SIZE)
 {
@@ -245,9 +253,33 @@ SolverState<double> AztecSolver::solve(const LinearOperator<double>& op,
   Epetra_Vector* b = EpetraVector::getConcretePtr(bCopy);
   Epetra_Vector* x = EpetraVector::getConcretePtr(xCopy);
 
-	Epetra_CrsMatrix& A = EpetraMatrix::getConcrete(op);
+  /* A matrix-free operator is given to Aztec as an Epetra_Operator, and
+   * preconditioners are built from its preconditioning matrix */
+  LinearOperator<double> precOp = op;
+  RCP<Epetra_Operator> matrixFreeOp;
+  const PreconditioningMatrixOp<double>* pmOp 
+    = dynamic_cast<const PreconditioningMatrixOp<double>*>(op.ptr().get());
+  if (pmOp != 0)
+  {
+    precOp = pmOp->preconditioningMatrix();
+    matrixFreeOp = rcp(new Epetra::Epetra_PlayaOperator(op));
+  }
+
+  Epetra_CrsMatrix* A = 0;
+  if (precOp.ptr().get() != 0) A = &(EpetraMatrix::getConcrete(precOp));
+
+  RCP<Epetra_LinearProblem> problem;
+  if (matrixFreeOp.get() != 0)
+  {
+    problem = rcp(new Epetra_LinearProblem(matrixFreeOp.get(), x, b));
+  }
+  else
+  {
+    problem = rcp(new Epetra_LinearProblem(A, x, b));
+  }
 
-  AztecOO aztec(&A, x, b);
+  AztecOO aztec(*problem);
+  if (matrixFreeOp.get() != 0 && A != 0) aztec.SetPrecMatrix(A);
 
   aztec.SetAllAztecOptions((int*) &(options_[0]));
   aztec.SetAllAztecParams((double*) &(parameters_[0]));
@@ -257,7 +289,18 @@ SolverState<double> AztecSolver::solve(const LinearOperator<double>& op,
   int maxIters = options_[AZ_max_iter];
   double tol = parameters_[AZ_tol];
 
-  if (useML_)
+  bool reuse = reusePrec_ && lastPrec_.get() != 0 && (useML_ || useIfpack_);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!reuse && A==0 && (useML_ || useIfpack_),
+    std::runtime_error, "AztecSolver::solve(): an ML or Ifpack "
+    "preconditioner was requested for a matrix-free operator that has no "
+    "preconditioning matrix");
+
+  if (reuse)
+  {
+    prec = lastPrec_;
+  }
+  else if (useML_)
   {
     std::string precType = precParams_.get<string>("Problem Type");
     ParameterList mlParams;
@@ -274,7 +317,7 @@ SolverState<double> AztecSolver::solve(const LinearOperator<double>& op,
       mlParams.setEntry(name, entry);
     }
     //#endif
-    mlPrec = rcp(new ML_Epetra::MultiLevelPreconditioner(A, mlParams));
+    mlPrec = rcp(new ML_Epetra::MultiLevelPreconditioner(*A, mlParams));
     prec = rcp_dynamic_cast<Epetra_Operator>(mlPrec);
   }
   else if (useIfpack_)
@@ -285,7 +328,7 @@ SolverState<double> AztecSolver::solve(const LinearOperator<double>& op,
 
     ParameterList ifpackParams = precParams_.sublist("Ifpack Settings");
 
-    ifpackPrec = rcp(precFactory.Create(precType, &A, overlap));
+    ifpackPrec = rcp(precFactory.Create(precType, A, overlap));
     prec = rcp_dynamic_cast<Epetra_Operator>(ifpackPrec);
     ifpackPrec->SetParameters(ifpackParams);
     ifpackPrec->Initialize();
@@ -298,6 +341,12 @@ SolverState<double> AztecSolver::solve(const LinearOperator<double>& op,
   }
   
   
+  if (!reuse && (useML_ || useIfpack_))
+  {
+    lastPrec_ = prec;
+    lastPrecOp_ = precOp;
+  }
+
   if (prec.get() != 0) aztec.SetPrecOperator(prec.get());  
   
   aztec.CheckInput();
@@ -44,6 +44,7 @@
 
 #include "PlayaDefs.hpp"
 #include "PlayaLinearSolverBaseDecl.hpp"
+#include "PlayaLinearOperatorDecl.hpp"
 #include "PlayaHandleable.hpp"
 #include "PlayaPrintable.hpp"
 #include "Teuchos_Describable.hpp"
@@ -86,6 +87,10 @@ namespace Playa
     /** Change the convergence tolerance. */
     virtual void updateTolerance(const double& tol);
 
+    /** Set whether solves may reuse the most recently built ML or
+     * Ifpack preconditioner */
+    virtual void setPreconditionerReuse(bool reuse) {reusePrec_ = reuse;}
+
 
     /** Set the preconditioning operator */
     void setUserPrec(const LinearOperator<double>& P,
@@ -152,6 +157,18 @@ namespace Playa
     /** User-defined preconditioner object */
     mutable RCP<Epetra_Operator> userPrec_;
 
+    /** Flag indicating whether solves may reuse the last ML or Ifpack
+     * preconditioner */
+    bool reusePrec_;
+
+    /** The operator from which lastPrec_ was built. The preconditioner
+     * may refer to the matrix, so we keep the matrix alive (it is 
+     * declared first so that it is destroyed after the preconditioner). */
+    mutable LinearOperator<double> lastPrecOp_;
+
+    /** The most recently built ML or Ifpack preconditioner */
+    mutable RCP<Epetra_Operator> lastPrec_;
+
     /** Aztec status */
     mutable Array<double> aztec_status;
 
@@ -51,6 +51,7 @@
 #include "PlayaGenericRightPreconditioner.hpp"
 
 #include "PlayaGenericTwoSidedPreconditioner.hpp"
+#include <algorithm>
 
 
 
@@ -68,14 +69,30 @@ EpetraMatrix::EpetraMatrix(const Epetra_CrsGraph& graph,
   const VectorSpace<double>& domain,
   const VectorSpace<double>& range)
   : LinearOpWithSpaces<double>(domain, range),
-    matrix_(rcp(new Epetra_CrsMatrix(Copy, graph)))
+    matrix_(rcp(new Epetra_CrsMatrix(Copy, graph))),
+    fillState_(Unrecorded),
+    batchSig_(),
+    batchIndices_(),
+    slotRow_(),
+    slotPos_(),
+    batchCursor_(0),
+    rowCursor_(0),
+    slotCursor_(0)
 {}
 
 EpetraMatrix::EpetraMatrix(const RCP<Epetra_CrsMatrix>& mat,
   const VectorSpace<double>& domain,
   const VectorSpace<double>& range)
   : LinearOpWithSpaces<double>(domain, range),
-    matrix_(mat)
+    matrix_(mat),
+    fillState_(Unrecorded),
+    batchSig_(),
+    batchIndices_(),
+    slotRow_(),
+    slotPos_(),
+    batchCursor_(0),
+    rowCursor_(0),
+    slotCursor_(0)
 {}
 
 
@@ -125,6 +142,19 @@ void EpetraMatrix::addToElementBatch(int numRows,
   const double* values,
   const int* skipRow)
 {
+  if (fillState_ == Replaying)
+  {
+    if (replayElementBatch(numRows, rowBlockSize, globalRowIndices,
+        numColumnsPerRow, globalColumnIndices, values, skipRow)) return;
+    fillState_ = Abandoned;
+  }
+  else if (fillState_ == Recording)
+  {
+    recordElementBatch(numRows, rowBlockSize, globalRowIndices,
+      numColumnsPerRow, globalColumnIndices, values, skipRow);
+    return;
+  }
+
   Epetra_CrsMatrix* crs = crsMatrix();
 
   int numRowBlocks = numRows/rowBlockSize;
@@ -151,9 +181,153 @@ void EpetraMatrix::addToElementBatch(int numRows,
 }
 
 
+void EpetraMatrix::recordElementBatch(int numRows, 
+  int rowBlockSize,
+  const int* globalRowIndices,
+  int numColumnsPerRow,
+  const int* globalColumnIndices,
+  const double* values,
+  const int* skipRow)
+{
+  Epetra_CrsMatrix* crs = crsMatrix();
+  bool sorted = crs->Graph().Sorted();
+
+  int numRowBlocks = numRows/rowBlockSize;
+  int row = 0;
+
+  for (int rb=0; rb<numRowBlocks; rb++)
+  {
+    const int* cols = globalColumnIndices + rb*numColumnsPerRow;
+    for (int r=0; r<rowBlockSize; r++, row++)
+    {
+      if (skipRow[row]) continue;
+      const double* rowVals = values + row*numColumnsPerRow;
+      int lrid = crs->LRID(globalRowIndices[row]);
+      TEUCHOS_TEST_FOR_EXCEPTION(lrid < 0, std::runtime_error, 
+        "failed to add to row " << globalRowIndices[row]
+        << " in EpetraMatrix::recordElementBatch(): row is not local");
+
+      int nnz;
+      double* rowData;
+      int* rowCols;
+      crs->ExtractMyRowView(lrid, nnz, rowData, rowCols);
+      slotRow_.append(lrid);
+
+      for (int c=0; c<numColumnsPerRow; c++)
+      {
+        int lcid = crs->LCID(cols[c]);
+        int pos = -1;
+        if (lcid >= 0)
+        {
+          if (sorted)
+          {
+            const int* p = std::lower_bound(rowCols, rowCols+nnz, lcid);
+            if (p != rowCols+nnz && *p == lcid) pos = p - rowCols;
+          }
+          else
+          {
+            for (int k=0; k<nnz; k++) 
+            {
+              if (rowCols[k] == lcid) {pos = k; break;}
+            }
+          }
+        }
+        TEUCHOS_TEST_FOR_EXCEPTION(pos < 0, std::runtime_error, 
+          "failed to add to row " << globalRowIndices[row]
+          << " in EpetraMatrix::recordElementBatch(): column " 
+          << cols[c] << " is not in the matrix graph");
+        rowData[pos] += rowVals[c];
+        slotPos_.append(pos);
+      }
+    }
+  }
+
+  int numCols = numRowBlocks*numColumnsPerRow;
+  batchSig_.append(numRows);
+  batchSig_.append(rowBlockSize);
+  batchSig_.append(numColumnsPerRow);
+  batchSig_.append(batchIndices_.size());
+  batchSig_.append(slotRow_.size());
+  for (int i=0; i<numRows; i++) batchIndices_.append(globalRowIndices[i]);
+  for (int i=0; i<numRows; i++) batchIndices_.append(skipRow[i] != 0);
+  for (int i=0; i<numCols; i++) batchIndices_.append(globalColumnIndices[i]);
+}
+
+
+bool EpetraMatrix::replayElementBatch(int numRows, 
+  int rowBlockSize,
+  const int* globalRowIndices,
+  int numColumnsPerRow,
+  const int* globalColumnIndices,
+  const double* values,
+  const int* skipRow)
+{
+  if (5*batchCursor_ >= batchSig_.size()) return false;
+
+  const int* sig = &(batchSig_[5*batchCursor_]);
+  if (sig[0] != numRows || sig[1] != rowBlockSize 
+    || sig[2] != numColumnsPerRow) return false;
+
+  /* The recorded positions are only valid for exactly the same rows, 
+   * skip mask and columns, so compare all of them before touching the
+   * matrix. */
+  const int* rec = &(batchIndices_[sig[3]]);
+  for (int i=0; i<numRows; i++) 
+  {
+    if (rec[i] != globalRowIndices[i]) return false;
+  }
+  rec += numRows;
+  for (int i=0; i<numRows; i++)
+  {
+    if (rec[i] != (skipRow[i] != 0)) return false;
+  }
+  rec += numRows;
+  int numCols = (numRows/rowBlockSize)*numColumnsPerRow;
+  for (int i=0; i<numCols; i++)
+  {
+    if (rec[i] != globalColumnIndices[i]) return false;
+  }
+
+  Epetra_CrsMatrix* crs = crsMatrix();
+  for (int row=0; row<numRows; row++)
+  {
+    if (skipRow[row]) continue;
+    const double* rowVals = values + row*numColumnsPerRow;
+    int nnz;
+    double* rowData;
+    crs->ExtractMyRowView(slotRow_[rowCursor_++], nnz, rowData);
+    const int* pos = &(slotPos_[slotCursor_]);
+    for (int c=0; c<numColumnsPerRow; c++)
+    {
+      rowData[pos[c]] += rowVals[c];
+    }
+    slotCursor_ += numColumnsPerRow;
+  }
+  batchCursor_++;
+  return true;
+}
+
+
 void EpetraMatrix::zero()
 {
   crsMatrix()->PutScalar(0.0);
+
+  if (lockAssemblyPattern() 
+    && (fillState_ == Recording || fillState_ == Replaying))
+  {
+    fillState_ = Replaying;
+  }
+  else
+  {
+    fillState_ = lockAssemblyPattern() ? Recording : Unrecorded;
+    batchSig_.resize(0);
+    batchIndices_.resize(0);
+    slotRow_.resize(0);
+    slotPos_.resize(0);
+  }
+  batchCursor_ = 0;
+  rowCursor_ = 0;
+  slotCursor_ = 0;
 }
 
 
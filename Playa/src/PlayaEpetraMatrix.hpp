@@ -117,11 +117,26 @@ public:
     const double* values,
     const int* skipRow);
 
-  /** Set all elements to zero, preserving the existing structure */
+  /** Set all elements to zero, preserving the existing structure.
+   * When pattern locking is enabled, this also marks the start of a 
+   * fill pass. */
   virtual void zero() ;
   
   //@}
 
+  /** 
+   * When true, element batches are loaded in "pattern-locked" mode. The
+   * first fill pass after zero() records, for each batch, the local row 
+   * and the position within the row of every entry. Later passes that
+   * repeat the same sequence of batches add straight into those 
+   * positions, skipping the global-to-local translation and column 
+   * search done by SumIntoGlobalValues(). A batch whose row indices,
+   * skipped rows or column indices differ from the recording in any
+   * entry causes the rest of the pass to use the unlocked path 
+   * and the next pass to re-record.
+   */
+  static bool& lockAssemblyPattern() {static bool rtn=false; return rtn;}
+
   /** \name incomplete factorization preconditioning interface */
   //@{
   /** create an incomplete factorization. 
@@ -210,10 +225,55 @@ public:
 
 private:
 
+  /** States of the pattern-locked fill */
+  enum FillState {Unrecorded, Recording, Replaying, Abandoned};
+
   Epetra_CrsMatrix* crsMatrix();
 
+  /** Add a batch through the SumIntoGlobalValues() path, recording 
+   * the positions of the entries */
+  void recordElementBatch(int numRows, 
+    int rowBlockSize,
+    const int* globalRowIndices,
+    int numColumnsPerRow,
+    const int* globalColumnIndices,
+    const double* values,
+    const int* skipRow);
+
+  /** Add a batch using the recorded positions. Returns false, having
+   * changed nothing, if the batch does not match the recording. */
+  bool replayElementBatch(int numRows, 
+    int rowBlockSize,
+    const int* globalRowIndices,
+    int numColumnsPerRow,
+    const int* globalColumnIndices,
+    const double* values,
+    const int* skipRow);
+
   RCP<Epetra_CrsMatrix> matrix_;
 
+  FillState fillState_;
+
+  /** Signature of each recorded batch: numRows, rowBlockSize, 
+   * numColumnsPerRow, the start of the batch's indices in 
+   * batchIndices_, and the end of the batch's rows in slotRow_ */
+  Array<int> batchSig_;
+
+  /** Row indices, skip mask and column indices of each recorded batch */
+  Array<int> batchIndices_;
+
+  /** Local row index of each recorded row */
+  Array<int> slotRow_;
+
+  /** Position within its row of each recorded entry */
+  Array<int> slotPos_;
+
+  int batchCursor_;
+
+  int rowCursor_;
+
+  int slotCursor_;
+
   const Epetra_Map& getRangeMap() const;
   const Epetra_Map& getDomainMap() const;
 };
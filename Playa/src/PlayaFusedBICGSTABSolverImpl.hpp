@@ -0,0 +1,244 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef PLAYA_FUSEDBICGSTABSOLVER_IMPL_HPP
+#define PLAYA_FUSEDBICGSTABSOLVER_IMPL_HPP
+
+#include "PlayaFusedBICGSTABSolverDecl.hpp"
+#include "PlayaVectorOpsDecl.hpp"
+#include "Teuchos_Utils.hpp"
+#include "PlayaSimpleScaledOpDecl.hpp"
+#include "PlayaSimpleComposedOpDecl.hpp"
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorOpsImpl.hpp"
+#include "PlayaLinearOperatorImpl.hpp"
+#include "PlayaLinearSolverBaseImpl.hpp"
+#include "PlayaSimpleScaledOpImpl.hpp"
+#include "PlayaSimpleComposedOpImpl.hpp"
+#include "PlayaSimpleTransposedOpImpl.hpp"
+#endif
+
+
+
+namespace Playa
+{
+using namespace Teuchos;
+
+
+/* */
+template <class Scalar> inline
+FusedBICGSTABSolver<Scalar>
+::FusedBICGSTABSolver(const ParameterList& params)
+  : KrylovSolver<Scalar>(params) {;}
+
+/* */
+template <class Scalar> inline
+FusedBICGSTABSolver<Scalar>::FusedBICGSTABSolver(const ParameterList& params,
+  const PreconditionerFactory<Scalar>& precond)
+  : KrylovSolver<Scalar>(params, precond) {;}
+
+/* Write to a stream  */
+template <class Scalar> inline
+void FusedBICGSTABSolver<Scalar>::print(std::ostream& os) const 
+{
+  os << description() << "[" << std::endl;
+  os << this->parameters() << std::endl;
+  os << "]" << std::endl;
+}
+
+    
+template <class Scalar> inline
+SolverState<Scalar> FusedBICGSTABSolver<Scalar>
+::solveUnprec(const LinearOperator<Scalar>& op,
+  const Vector<Scalar>& b,
+  Vector<Scalar>& soln) const
+{
+  int maxiters = this->getMaxiters();
+  Scalar tol = this->getTol();
+  int verbosity = this->verb();
+
+  /* same initial guess as BICGSTABSolver */
+  Vector<Scalar> x = b.copy();
+  Vector<Scalar> r = b.space().createMember();
+  Vector<Scalar> v = b.space().createMember();
+
+  // r =  b - op*x
+  op.apply(x, v);
+  r.acceptCopyOf(b);
+  r.update(-1.0, v);
+
+  Vector<Scalar> r0Hat = r.copy();
+  Vector<Scalar> p = r.copy();
+  Vector<Scalar> s = b.space().createMember();
+  Vector<Scalar> t = b.space().createMember();
+
+  /* (b,b), (r,r) and rho=(r0Hat,r) in one reduction */
+  Array<Scalar> dots(5);
+  Array<Vector<Scalar> > initLeft = tuple(b, r, r0Hat);
+  Array<Vector<Scalar> > initRight = tuple(b, r, r);
+  fusedDots(initLeft, initRight, dots);
+  Scalar normOfB = sqrt(dots[0]);
+  Scalar rho = dots[2];
+
+  /* check for trivial case of zero rhs */
+  if (normOfB < tol) 
+  {
+    soln = b.space().createMember();
+    soln.zero();
+    return SolverState<Scalar>(SolveConverged, "RHS was zero", 0, 0.0);
+  }
+
+  Scalar resid = sqrt(dots[1])/normOfB;
+  if (resid < tol) 
+  {
+    soln = x;
+    return SolverState<Scalar>(SolveConverged, "initial resid was zero", 
+      0, 0.0);
+  }
+
+  /* the inner products needed after the second matrix-vector 
+   * product: (t,s), (t,t), (s,s), (r0Hat,s), (r0Hat,t) */
+  Array<Vector<Scalar> > left = tuple(t, t, s, r0Hat, r0Hat);
+  Array<Vector<Scalar> > right = tuple(s, t, s, s, t);
+
+  int myRank = MPIComm::world().getRank();
+
+  for (int k=1; k<=maxiters; k++)
+  {
+    // v = A*p
+    op.apply(p, v);
+
+    Scalar den = v.dot(r0Hat);
+    if (Utils::chop(sqrt(fabs(den))/normOfB)==0) 
+    {
+      SolverState<Scalar> rtn(SolveCrashed, 
+        "BICGSTAB failure mode 1", k, resid);
+      return rtn;
+    }
+    Scalar alpha = rho/den;
+
+    // s = r - alpha*v
+    s.acceptCopyOf(r);
+    s.update(-alpha, v);
+
+    // t = A*s
+    op.apply(s, t);
+
+    fusedDots(left, right, dots);
+    Scalar ts = dots[0];
+    Scalar tt = dots[1];
+    Scalar ss = dots[2];
+
+    // check for convergence on the intermediate residual
+    resid = sqrt(fabs(ss))/normOfB;
+    if (resid < tol) 
+    {
+      x.update(alpha, p);
+      soln = x; 
+      SolverState<Scalar> rtn(SolveConverged, "yippee!!", k, resid);
+      return rtn;
+    }
+
+    if (Utils::chop(sqrt(fabs(tt))/normOfB)==0)  
+    {
+      SolverState<Scalar> rtn(SolveCrashed, 
+        "BICGSTAB failure mode 2", k, resid);
+      return rtn;
+    }
+    Scalar w = ts/tt;
+
+    // x = x + alpha*p + w*s,  r = s - w*t
+    x.update(alpha, p, w, s, 1.0);
+    r.acceptCopyOf(s);
+    r.update(-w, t);
+
+    /* ||r||^2 = (s,s) - 2w(t,s) + w^2(t,t), which with this choice of
+     * w reduces to (s,s) - w(t,s) */
+    resid = sqrt(fabs(ss - w*ts))/normOfB;
+
+    if (myRank==0 && verbosity > 1 ) 
+    {
+      Out::os() << "Fused BICGSTAB: iteration=";
+      Out::os().width(8);
+      Out::os() << k;
+      Out::os().width(20);
+      Out::os() << " resid=" << resid << std::endl;
+    }
+
+    if (resid < tol) 
+    {
+      /* the recurrence can underestimate the residual once it has 
+       * lost accuracy, so confirm with an explicit reduction */
+      Scalar rNorm = r.norm2()/normOfB;
+      if (rNorm < tol)
+      {
+        soln = x;
+        SolverState<Scalar> rtn(SolveConverged, "yippee!!", k, rNorm);
+        return rtn;
+      }
+    }
+
+    den = w*rho;
+    if (Utils::chop(sqrt(fabs(den))/normOfB)==0) 
+    {
+      SolverState<Scalar> rtn(SolveCrashed, 
+        "BICGSTAB failure mode 3", k, resid);
+      return rtn;
+    }
+    Scalar rhoNew = dots[3] - w*dots[4];
+    Scalar beta = (rhoNew/rho)*(alpha/w);
+    rho = rhoNew;
+
+    // p = r + beta*(p - w*v)
+    p.update(1.0, r, -beta*w, v, beta);
+  }
+    
+  SolverState<Scalar> rtn(SolveFailedToConverge, 
+    "BICGSTAB failed to converge", 
+    maxiters, resid);
+  return rtn;
+}
+
+
+}
+
+#endif
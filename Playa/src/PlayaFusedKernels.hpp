@@ -0,0 +1,159 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef PLAYA_FUSEDKERNELS_HPP
+#define PLAYA_FUSEDKERNELS_HPP
+
+#include "PlayaDefs.hpp"
+#include <vector>
+
+/*
+ * Loop kernels for the fused vector operations on Vector 
+ * (updateAndDot(), dots(), updateAndNorm2()), acting on the local 
+ * data of single-chunk vectors. Each kernel makes one pass over memory
+ * where the unfused operations make two or more. Sums are carried in
+ * four independent accumulators, which lets the compiler vectorize 
+ * them without reassociating floating point arithmetic. When built 
+ * with OpenMP, loops longer than threadThreshold() are split over
+ * threads.
+ */
+
+namespace PlayaFusedKernels
+{
+/** Loop length below which kernels are not threaded */
+inline int& threadThreshold() {static int rtn=50000; return rtn;}
+
+/** z = alpha*x + gamma*z, returning the local part of (z,y). The 
+ * pointer y may alias z. */
+template <class Scalar> inline
+Scalar updateAndDot(int n, const Scalar& alpha, const Scalar* x, 
+  const Scalar& gamma, Scalar* z, const Scalar* y)
+{
+  Scalar s0 = 0.0;
+  Scalar s1 = 0.0;
+  Scalar s2 = 0.0;
+  Scalar s3 = 0.0;
+  int nq = n/4;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:s0,s1,s2,s3) if (n > threadThreshold())
+#endif
+  for (int b=0; b<nq; b++)
+  {
+    int i = 4*b;
+    Scalar z0 = alpha*x[i] + gamma*z[i];
+    Scalar z1 = alpha*x[i+1] + gamma*z[i+1];
+    Scalar z2 = alpha*x[i+2] + gamma*z[i+2];
+    Scalar z3 = alpha*x[i+3] + gamma*z[i+3];
+    z[i] = z0;
+    z[i+1] = z1;
+    z[i+2] = z2;
+    z[i+3] = z3;
+    s0 += z0*y[i];
+    s1 += z1*y[i+1];
+    s2 += z2*y[i+2];
+    s3 += z3*y[i+3];
+  }
+  for (int i=4*nq; i<n; i++)
+  {
+    z[i] = alpha*x[i] + gamma*z[i];
+    s0 += z[i]*y[i];
+  }
+  return (s0 + s1) + (s2 + s3);
+}
+
+/** z = alpha*x + gamma*z, returning the local part of (z,z) */
+template <class Scalar> inline
+Scalar updateAndNormSq(int n, const Scalar& alpha, const Scalar* x, 
+  const Scalar& gamma, Scalar* z)
+{
+  return updateAndDot(n, alpha, x, gamma, z, z);
+}
+
+/** Local parts of the dot products (x, y[j]) for j=0..m-1, added into
+ * result. The loop is blocked so that each block of x is reused from 
+ * cache for all of the y[j]. */
+template <class Scalar> inline
+void multiDot(int n, const Scalar* x, int m, const Scalar* const* y, 
+  Scalar* result)
+{
+  const int blockSize = 512;
+  int nBlocks = (n + blockSize - 1)/blockSize;
+#ifdef _OPENMP
+#pragma omp parallel if (n > threadThreshold())
+#endif
+  {
+    std::vector<Scalar> sums(m, 0.0);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+    for (int b=0; b<nBlocks; b++)
+    {
+      int start = b*blockSize;
+      int end = start + blockSize;
+      if (end > n) end = n;
+      for (int j=0; j<m; j++)
+      {
+        const Scalar* yj = y[j];
+        Scalar s0 = 0.0;
+        Scalar s1 = 0.0;
+        Scalar s2 = 0.0;
+        Scalar s3 = 0.0;
+        int i = start;
+        for (; i+4<=end; i+=4)
+        {
+          s0 += x[i]*yj[i];
+          s1 += x[i+1]*yj[i+1];
+          s2 += x[i+2]*yj[i+2];
+          s3 += x[i+3]*yj[i+3];
+        }
+        for (; i<end; i++) s0 += x[i]*yj[i];
+        sums[j] += (s0 + s1) + (s2 + s3);
+      }
+    }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    for (int j=0; j<m; j++) result[j] += sums[j];
+  }
+}
+}
+
+#endif
@@ -0,0 +1,134 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "PlayaJacobianFreeOp.hpp"
+#include "PlayaNonlinearOperatorBase.hpp"
+#include "PlayaOut.hpp"
+#include "PlayaTabs.hpp"
+#include "Teuchos_ScalarTraits.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include <cmath>
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorImpl.hpp"
+#include "PlayaLinearOperatorImpl.hpp"
+#endif
+
+using namespace Playa;
+using namespace Teuchos;
+
+
+static Time& jfApplyTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("Jacobian-free apply"); 
+  return *rtn;
+}
+
+
+JacobianFreeOp::JacobianFreeOp(const NonlinearOperatorBase<double>* F,
+  const Vector<double>& evalPt,
+  const Vector<double>& functionValue,
+  const LinearOperator<double>& precMatrix)
+  : LinearOpWithSpaces<double>(evalPt.space(), functionValue.space()),
+    F_(F), u_(evalPt), Fu_(functionValue), uNorm_(evalPt.norm2()),
+    precMatrix_(precMatrix)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(F_==0, std::runtime_error,
+    "null nonlinear operator in JacobianFreeOp ctor");
+}
+
+
+void JacobianFreeOp::apply(Teuchos::ETransp transApplyType,
+  const Vector<double>& in,
+  Vector<double> out) const
+{
+  TimeMonitor timer(jfApplyTimer());
+  Tabs tab(0);
+  PLAYA_MSG2(this->verb(), tab << "JacobianFreeOp::apply()");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(transApplyType != Teuchos::NO_TRANS, 
+    std::runtime_error,
+    "JacobianFreeOp::apply() cannot apply the transpose of a Jacobian "
+    "that is not assembled");
+
+  double vNorm = in.norm2();
+  if (vNorm == 0.0)
+  {
+    out.zero();
+    return;
+  }
+
+  double h = std::sqrt(ScalarTraits<double>::eps()*(1.0 + uNorm_))/vNorm;
+  PLAYA_MSG3(this->verb(), tab << "difference step h=" << h);
+
+  Vector<double> uPert = u_.copy();
+  uPert.update(h, in);
+  Vector<double> FPert = F_->getFunctionValueAt(uPert);
+
+  out.acceptCopyOf(FPert);
+  out.update(-1.0, Fu_);
+  out.scale(1.0/h);
+
+  PLAYA_MSG2(this->verb(), tab << "done JacobianFreeOp::apply()");
+}
+
+
+std::string JacobianFreeOp::description() const 
+{
+  return "JacobianFreeOp[precMatrix=" 
+    + std::string(precMatrix_.ptr().get()==0 ? "none" : "given") + "]";
+}
+
+
+void JacobianFreeOp::print(std::ostream& os) const 
+{
+  Tabs tab(0);
+  os << tab << "JacobianFreeOp[" << std::endl;
+  Tabs tab1;
+  os << tab1 << "|u| = " << uNorm_ << std::endl;
+  if (precMatrix_.ptr().get() != 0)
+  {
+    os << tab1 << "preconditioning matrix = " << std::endl;
+    precMatrix_.print(os);
+  }
+  os << tab << "]" << std::endl;
+}
@@ -0,0 +1,116 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef PLAYA_JACOBIAN_FREE_OP_HPP
+#define PLAYA_JACOBIAN_FREE_OP_HPP
+
+#include "PlayaDefs.hpp"
+#include "PlayaLinearOpWithSpacesDecl.hpp"
+#include "PlayaLinearOperatorDecl.hpp"
+#include "PlayaPreconditioningMatrixOp.hpp"
+#include "PlayaPrintable.hpp"
+
+
+namespace Playa
+{
+using namespace Teuchos;
+
+template <class Scalar> class NonlinearOperatorBase;
+
+/** 
+ * JacobianFreeOp applies the Jacobian of a nonlinear operator \f$F\f$
+ * at a point \f$u\f$ by a forward difference of function values,
+ * \f[ J(u) v \approx \frac{F(u + h v) - F(u)}{h}, \f]
+ * with \f$h = \sqrt{\epsilon (1 + \|u\|)}/\|v\|\f$, so that Newton-Krylov
+ * methods can be used without assembling the Jacobian. Each application 
+ * costs one function evaluation. Only the untransposed operator can be
+ * applied.
+ *
+ * An optional preconditioning matrix, usually the assembled Jacobian 
+ * of a cheaper discretization, can be supplied. Solvers that recognize 
+ * PreconditioningMatrixOp build their preconditioners from it.
+ *
+ * The operator does not own \f$F\f$, which must outlive it.
+ */
+class JacobianFreeOp : public LinearOpWithSpaces<double>,
+  public PreconditioningMatrixOp<double>,
+  public Printable
+{
+public:
+  /** 
+   * Construct the Jacobian of F about the point evalPt.
+   * @param F the nonlinear operator
+   * @param evalPt the point at which the Jacobian is taken
+   * @param functionValue the value of F at evalPt
+   * @param precMatrix the matrix from which preconditioners are built,
+   * or null for no preconditioning.
+   */
+  JacobianFreeOp(const NonlinearOperatorBase<double>* F,
+    const Vector<double>& evalPt,
+    const Vector<double>& functionValue,
+    const LinearOperator<double>& precMatrix);
+
+  /** */
+  void apply(Teuchos::ETransp transApplyType,
+    const Vector<double>& in,
+    Vector<double> out) const ;
+
+  /** */
+  LinearOperator<double> preconditioningMatrix() const 
+    {return precMatrix_;}
+
+  /** */
+  std::string description() const ;
+
+  /** */
+  void print(std::ostream& os) const ;
+
+private:
+  const NonlinearOperatorBase<double>* F_;
+  Vector<double> u_;
+  Vector<double> Fu_;
+  double uNorm_;
+  LinearOperator<double> precMatrix_;
+};
+
+}
+
+#endif
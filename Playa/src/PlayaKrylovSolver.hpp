@@ -45,6 +45,7 @@
 #include "PlayaDefs.hpp"
 #include "PlayaIterativeSolver.hpp"
 #include "PlayaPreconditionerFactory.hpp"
+#include "PlayaPreconditioningMatrixOp.hpp"
 #include "PlayaILUKPreconditionerFactory.hpp"
 #include "PlayaSimpleComposedOpDecl.hpp"
 
@@ -68,6 +69,10 @@ public:
   /** */
   virtual ~KrylovSolver(){;}
 
+  /** Set whether solves may reuse the most recently built 
+   * preconditioner */
+  virtual void setPreconditionerReuse(bool reuse) {reusePrec_ = reuse;}
+
   /** */
   virtual SolverState<Scalar> solve(const LinearOperator<Scalar>& op,
     const Vector<Scalar>& rhs,
@@ -81,12 +86,17 @@ protected:
 
 private:
   PreconditionerFactory<Scalar> precond_;
+
+  bool reusePrec_;
+
+  mutable Preconditioner<Scalar> lastPrec_;
 };
 
   
 template <class Scalar> inline
 KrylovSolver<Scalar>::KrylovSolver(const ParameterList& params)
-  : IterativeSolver<Scalar>(params), precond_()
+  : IterativeSolver<Scalar>(params), precond_(), reusePrec_(false),
+    lastPrec_()
 {
   if (!params.isParameter("Precond")) return;
 
@@ -101,7 +111,8 @@ KrylovSolver<Scalar>::KrylovSolver(const ParameterList& params)
 template <class Scalar> inline
 KrylovSolver<Scalar>::KrylovSolver(const ParameterList& params,
   const PreconditionerFactory<Scalar>& precond)
-  : IterativeSolver<Scalar>(params), precond_(precond)
+  : IterativeSolver<Scalar>(params), precond_(precond), reusePrec_(false),
+    lastPrec_()
 {
   TEUCHOS_TEST_FOR_EXCEPTION(params.isParameter("Precond"), std::runtime_error,
     "ambiguous preconditioner specification in "
@@ -117,13 +128,29 @@ SolverState<Scalar> KrylovSolver<Scalar>
   const Vector<Scalar>& rhs,
   Vector<Scalar>& soln) const
 {
-  if (precond_.ptr().get()==0) 
+  /* Operators such as matrix-free Jacobians supply a separate matrix
+   * from which to build the preconditioner */
+  LinearOperator<Scalar> precOp = op;
+  const PreconditioningMatrixOp<Scalar>* pmOp 
+    = dynamic_cast<const PreconditioningMatrixOp<Scalar>*>(op.ptr().get());
+  if (pmOp != 0) precOp = pmOp->preconditioningMatrix();
+
+  if (precond_.ptr().get()==0 || precOp.ptr().get()==0) 
   {
     return solveUnprec(op, rhs, soln);
   }
 
 
-  Preconditioner<Scalar> p = precond_.createPreconditioner(op);
+  Preconditioner<Scalar> p;
+  if (reusePrec_ && lastPrec_.ptr().get() != 0)
+  {
+    p = lastPrec_;
+  }
+  else
+  {
+    p = precond_.createPreconditioner(precOp);
+    lastPrec_ = p;
+  }
     
   if (!p.hasRight())
   {
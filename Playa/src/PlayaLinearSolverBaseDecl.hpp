@@ -82,6 +82,14 @@ namespace Playa
     /** Change the convergence tolerance. Default does nothing. */
     virtual void updateTolerance(const double& tol) {;}
 
+    /** Set whether subsequent solves may reuse the preconditioner built
+     * in the most recent solve instead of building a new one. This is 
+     * for callers such as Newton solvers that lag the Jacobian, and know 
+     * when the operator has not changed or changed only slightly. 
+     * Default does nothing, so that a new preconditioner is built on
+     * every solve. */
+    virtual void setPreconditionerReuse(bool reuse) {;}
+
     /** Set a user-defined preconditioning operator. Default is an error. */
     virtual void setUserPrec(const PreconditionerFactory<Scalar>& pf);
 
@@ -45,6 +45,8 @@
 #include "PlayaAztecSolver.hpp"
 #include "PlayaBelosSolver.hpp"
 #include "PlayaBICGSTABSolverDecl.hpp"
+#include "PlayaFusedBICGSTABSolverDecl.hpp"
+#include "PlayaPipelinedCGSolverDecl.hpp"
 #include "PlayaBlockTriangularSolverDecl.hpp"
 #include "Teuchos_XMLParameterListReader.hpp"
 #include "Teuchos_ParameterXMLFileReader.hpp"
@@ -54,6 +56,8 @@
 #include "PlayaLinearOperatorImpl.hpp"
 #include "PlayaLinearSolverImpl.hpp"
 #include "PlayaBICGSTABSolverImpl.hpp"
+#include "PlayaFusedBICGSTABSolverImpl.hpp"
+#include "PlayaPipelinedCGSolverImpl.hpp"
 #include "PlayaBlockTriangularSolverImpl.hpp"
 #endif
 
@@ -97,6 +101,14 @@ LinearSolver<double> LinearSolverBuilder::createSolver(const ParameterList& para
     {
       return new BICGSTABSolver<double>(solverSublist);
     }
+    else if (solverMethod=="Fused BICGSTAB") 
+    {
+      return new FusedBICGSTABSolver<double>(solverSublist);
+    }
+    else if (solverMethod=="Pipelined CG") 
+    {
+      return new PipelinedCGSolver<double>(solverSublist);
+    }
     else if (solverMethod=="GMRES")
     {
       TEUCHOS_TEST_FOR_EXCEPTION(true, RuntimeError, "Playa GMRES solver not implemented");
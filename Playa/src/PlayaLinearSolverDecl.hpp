@@ -87,6 +87,11 @@ public:
   /** Change the convergence tolerance. Default does nothing. */
   void updateTolerance(const double& tol) {this->ptr()->updateTolerance(tol);}
 
+  /** Set whether solves may reuse the most recently built 
+   * preconditioner. Default does nothing. */
+  void setPreconditionerReuse(bool reuse) 
+    {this->ptr()->setPreconditionerReuse(reuse);}
+
   /** Set a user-defined preconditioner */
   void setUserPrec(const LinearOperator<Scalar>& op,
     const LinearSolver<Scalar>& pSolver) ;
@@ -63,7 +63,41 @@ using namespace Teuchos;
  * <li> int "Max Iterations" number of iterations to allow before failure. Default value 20.
  * <li> int "Max Backtracks" number of step reductions to allow before failure. Default value 20.
  * <li> int "Verbosity" amount of diagnostic output. Default value 0.
+ * <li> int "Jacobian Rebuild Interval" number of Newton iterations for 
+ * which a Jacobian is reused before it is rebuilt. Default value 1, 
+ * meaning the Jacobian is rebuilt on every iteration.
+ * <li> double "Jacobian Rebuild Ratio" the Jacobian is rebuilt before the
+ * interval has elapsed whenever the contraction |F_{k+1}|/|F_k| exceeds 
+ * this ratio. Default value 0.5.
+ * <li> int "Preconditioner Rebuild Interval" number of Jacobian builds 
+ * for which the linear solver may reuse its preconditioner. Default 
+ * value 1. The preconditioner is never rebuilt while the Jacobian is 
+ * being reused. Only linear solvers implementing 
+ * LinearSolverBase::setPreconditionerReuse() honor this setting.
+ * <li> string "Forcing Term" either "Constant", in which case the 
+ * linear solver's own tolerance is used, or "Eisenstat-Walker", in which
+ * case the linear tolerance is set on each iteration by choice 2 of 
+ * Eisenstat and Walker, 
+ * \f$\eta_k = \gamma (|F_k|/|F_{k-1}|)^\alpha\f$. Default "Constant".
+ * <li> double "Forcing Term Initial" the first Eisenstat-Walker 
+ * tolerance. Default value 0.1.
+ * <li> double "Forcing Term Gamma" Eisenstat-Walker \f$\gamma\f$. 
+ * Default value 0.9.
+ * <li> double "Forcing Term Alpha" Eisenstat-Walker \f$\alpha\f$. 
+ * Default value 2.0.
+ * <li> double "Forcing Term Max" upper bound on the Eisenstat-Walker 
+ * tolerance. Default value 0.9.
  * </ul>
+ *
+ * When the Jacobian or preconditioner is stale and either the linear solve
+ * or the line search fails, the step is retried once with a freshly built
+ * Jacobian and preconditioner before failure is reported. A Jacobian 
+ * built on the failing iteration is kept, and only the preconditioner is
+ * rebuilt.
+ *
+ * The numbers of Jacobians and preconditioners built by the most recent
+ * solve are available through numJacobianBuilds() and 
+ * numPreconditionerBuilds().
  */
 template <class Scalar>
 class NewtonArmijoSolver : public NonlinearSolverBase<Scalar> 
@@ -83,6 +117,12 @@ public:
   SolverState<Scalar> solve(const NonlinearOperator<Scalar>& F,
     Vector<Scalar>& soln) const ;
 
+  /** Number of Jacobians built during the most recent solve */
+  int numJacobianBuilds() const {return numJacBuilds_;}
+
+  /** Number of preconditioners built during the most recent solve */
+  int numPreconditionerBuilds() const {return numPrecBuilds_;}
+
   /* */
   GET_RCP(NonlinearSolverBase<Scalar>);
 
@@ -95,6 +135,16 @@ private:
   int maxIters_;
   int maxLineSearch_;
   int verb_;
+  int jacRebuildInterval_;
+  ScalarMag jacRebuildRatio_;
+  int precRebuildInterval_;
+  bool useEW_;
+  ScalarMag etaInit_;
+  ScalarMag etaGamma_;
+  ScalarMag etaAlpha_;
+  ScalarMag etaMax_;
+  mutable int numJacBuilds_;
+  mutable int numPrecBuilds_;
     
 };
 
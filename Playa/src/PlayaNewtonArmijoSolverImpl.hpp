@@ -47,6 +47,8 @@
 #include "PlayaTabs.hpp"
 #include "PlayaOut.hpp"
 #include "Teuchos_ParameterList.hpp"
+#include <cmath>
+#include <algorithm>
 
 #ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
 #include "PlayaLinearCombinationImpl.hpp"
@@ -74,7 +76,17 @@ NewtonArmijoSolver<Scalar>::NewtonArmijoSolver(
       stepReduction_(0.5),
       maxIters_(20),
       maxLineSearch_(20),
-      verb_(0)
+      verb_(0),
+      jacRebuildInterval_(1),
+      jacRebuildRatio_(0.5),
+      precRebuildInterval_(1),
+      useEW_(false),
+      etaInit_(0.1),
+      etaGamma_(0.9),
+      etaAlpha_(2.0),
+      etaMax_(0.9),
+      numJacBuilds_(0),
+      numPrecBuilds_(0)
   {
     if (params.isParameter("Tau Relative")) tauR_ = params.get<Scalar>("Tau Relative");
     if (params.isParameter("Tau Absolute")) tauA_ = params.get<Scalar>("Tau Absolute");
@@ -83,6 +95,26 @@ NewtonArmijoSolver<Scalar>::NewtonArmijoSolver(
     if (params.isParameter("Max Iterations")) maxIters_ = params.get<int>("Max Iterations");
     if (params.isParameter("Max Backtracks")) maxLineSearch_ = params.get<int>("Max Backtracks");
     if (params.isParameter("Verbosity")) verb_ = params.get<int>("Verbosity");
+    if (params.isParameter("Jacobian Rebuild Interval")) jacRebuildInterval_ = params.get<int>("Jacobian Rebuild Interval");
+    if (params.isParameter("Jacobian Rebuild Ratio")) jacRebuildRatio_ = params.get<double>("Jacobian Rebuild Ratio");
+    if (params.isParameter("Preconditioner Rebuild Interval")) precRebuildInterval_ = params.get<int>("Preconditioner Rebuild Interval");
+    if (params.isParameter("Forcing Term Initial")) etaInit_ = params.get<double>("Forcing Term Initial");
+    if (params.isParameter("Forcing Term Gamma")) etaGamma_ = params.get<double>("Forcing Term Gamma");
+    if (params.isParameter("Forcing Term Alpha")) etaAlpha_ = params.get<double>("Forcing Term Alpha");
+    if (params.isParameter("Forcing Term Max")) etaMax_ = params.get<double>("Forcing Term Max");
+    if (params.isParameter("Forcing Term"))
+    {
+      std::string ft = params.get<std::string>("Forcing Term");
+      TEUCHOS_TEST_FOR_EXCEPTION(ft != "Constant" && ft != "Eisenstat-Walker",
+        std::runtime_error, "NewtonArmijoSolver: forcing term [" << ft 
+        << "] not recognized; expected Constant or Eisenstat-Walker");
+      useEW_ = (ft == "Eisenstat-Walker");
+    }
+
+    TEUCHOS_TEST_FOR_EXCEPTION(jacRebuildInterval_ < 1, std::runtime_error,
+      "NewtonArmijoSolver: Jacobian Rebuild Interval must be positive");
+    TEUCHOS_TEST_FOR_EXCEPTION(precRebuildInterval_ < 1, std::runtime_error,
+      "NewtonArmijoSolver: Preconditioner Rebuild Interval must be positive");
   }
 
 template <class Scalar> inline
@@ -104,6 +136,21 @@ SolverState<Scalar> NewtonArmijoSolver<Scalar>::solve(const NonlinearOperator<Sc
   ScalarMag r0 = resid.norm2();
   ScalarMag normF0 = r0;
 
+  /* Jacobian and preconditioner lagging state. The Jacobian J is kept
+   * between iterations and rebuilt every jacRebuildInterval_ iterations,
+   * or sooner if the contraction rate degrades. The preconditioner is 
+   * rebuilt every precRebuildInterval_ Jacobian builds. */
+  LinearOperator<Scalar> J;
+  int jacAge = 0;
+  int precAge = 0;
+  numJacBuilds_ = 0;
+  numPrecBuilds_ = 0;
+  bool rebuildJac = true;
+
+  /* Eisenstat-Walker forcing term */
+  ScalarMag eta = etaInit_;
+  ScalarMag normFPrev = normF0;
+
   for (int i=0; i<maxIters_; i++)
   {
     Tabs tab1;
@@ -117,54 +164,127 @@ SolverState<Scalar> NewtonArmijoSolver<Scalar>::solve(const NonlinearOperator<Sc
       PLAYA_MSG3(verb_, tab1 << "Absolute tolerance tauA=" << setw(12) << tauA_);
       PLAYA_MSG3(verb_, tab1 << "  F0*tauR+tauA=" << setw(12) << r0*tauR_ + tauA_);
       PLAYA_MSG2(verb_, tab1 << "converged!");
+      PLAYA_MSG2(verb_, tab1 << "Jacobian builds: " << numJacBuilds_
+        << " preconditioner builds: " << numPrecBuilds_);
       PLAYA_MSG1(verb_, tab0 << " done Playa::NewtonArmijoSolver::solve()");
       soln = F.currentEvalPt().copy();
       return SolverState<Scalar>(SolveConverged, "NewtonArmijoSolver::solve converged",
         i, normF0);
     }
-    LinearOperator<Scalar> J = F.getJacobian();
 
+    if (useEW_)
+    {
+      if (i > 0)
+      {
+        ScalarMag etaNew = etaGamma_ * std::pow(normF0/normFPrev, etaAlpha_);
+        /* safeguard against the tolerance dropping too quickly */
+        ScalarMag etaSafe = etaGamma_ * std::pow(eta, etaAlpha_);
+        if (etaSafe > 0.1) etaNew = std::max(etaNew, etaSafe);
+        eta = etaNew;
+      }
+      /* don't oversolve once we're close to the nonlinear tolerance, 
+       * but never let the linear tolerance exceed etaMax_ */
+      eta = std::min(etaMax_, std::max(eta, 0.5*(r0*tauR_ + tauA_)/normF0));
+      PLAYA_MSG3(verb_, tab1 << "forcing term eta=" << setw(12) << eta);
+      linSolver_.updateTolerance(eta);
+    }
+
+    soln = F.currentEvalPt().copy();
 
-    SolverState<Scalar> linSolverState = linSolver_.solve(J, resid, newtonStep);
-    if (linSolverState.finalState() != SolveConverged)
+    bool rebuildPrec = false;
+    if (rebuildJac || jacAge >= jacRebuildInterval_)
     {
-      PLAYA_MSG1(verb_, tab0 << " done Playa::NewtonArmijoSolver::solve()");
-      return SolverState<Scalar>(SolveCrashed, 
-        "NewtonArmijoSolver::solve: linear solve failed with message [" 
-        + linSolverState.finalMsg() + "]", i, normF0);
+      J = F.getJacobian();
+      numJacBuilds_++;
+      jacAge = 0;
+      if (numPrecBuilds_==0 || precAge >= precRebuildInterval_)
+      {
+        rebuildPrec = true;
+        numPrecBuilds_++;
+        precAge = 0;
+      }
+      precAge++;
     }
-      
-    
-    Scalar t = ST::one();
+    rebuildJac = false;
+    jacAge++;
 
+    /* If the step fails with a stale Jacobian or preconditioner, try 
+     * again once with fresh ones before giving up. A Jacobian built on 
+     * this iteration is kept, and only the preconditioner is rebuilt. */
+    Vector<Scalar> residAtSoln = resid.copy();
     bool stepAccepted = false;
-    soln = F.currentEvalPt().copy();
-    
-    for (int j=0; j<maxLineSearch_; j++)
+    std::string failMsg;
+    for (int attempt=0; attempt<2 && !stepAccepted; attempt++)
     {
-      Tabs tab2;
-      Vector<Scalar> tmp = soln - t*newtonStep;
-      F.setEvalPt( tmp );
-      resid = F.getFunctionValue();
-      ScalarMag normF1 = resid.norm2();
-      PLAYA_MSG2(verb_, tab2 << "step t=" << setw(12) << t << " |F|=" << setw(12) << normF1);
-      if (normF1 < (ST::one() - alpha_*t)*normF0)
+      if (attempt > 0)
+      {
+        if (jacAge == 1 && rebuildPrec) break;
+        Tabs tab2;
+        F.setEvalPt(soln);
+        if (jacAge == 1)
+        {
+          PLAYA_MSG2(verb_, tab2 << failMsg 
+            << "; retrying with a fresh preconditioner");
+          resid = residAtSoln.copy();
+        }
+        else
+        {
+          PLAYA_MSG2(verb_, tab2 << failMsg 
+            << "; retrying with fresh Jacobian and preconditioner");
+          J = F.getJacobian();
+          resid = F.getFunctionValue();
+          numJacBuilds_++;
+          jacAge = 1;
+        }
+        numPrecBuilds_++;
+        precAge = 1;
+        rebuildPrec = true;
+      }
+
+      linSolver_.setPreconditionerReuse(!rebuildPrec);
+      SolverState<Scalar> linSolverState = linSolver_.solve(J, resid, newtonStep);
+      linSolver_.setPreconditionerReuse(false);
+      if (linSolverState.finalState() != SolveConverged)
+      {
+        failMsg = "NewtonArmijoSolver::solve: linear solve failed with message [" 
+          + linSolverState.finalMsg() + "]";
+        continue;
+      }
+    
+      Scalar t = ST::one();
+    
+      for (int j=0; j<maxLineSearch_; j++)
       {
-        stepAccepted = true;
-        normF0 = normF1;
-        break;
+        Tabs tab2;
+        Vector<Scalar> tmp = soln - t*newtonStep;
+        F.setEvalPt( tmp );
+        resid = F.getFunctionValue();
+        ScalarMag normF1 = resid.norm2();
+        PLAYA_MSG2(verb_, tab2 << "step t=" << setw(12) << t << " |F|=" << setw(12) << normF1);
+        if (normF1 < (ST::one() - alpha_*t)*normF0)
+        {
+          stepAccepted = true;
+          normFPrev = normF0;
+          normF0 = normF1;
+          break;
+        }
+        t = stepReduction_*t;
       }
-      t = stepReduction_*t;
+      if (!stepAccepted) failMsg = "NewtonArmijoSolver: line search failed";
     }
     
     if (!stepAccepted)
     {
       PLAYA_MSG1(verb_, tab0 << " done Playa::NewtonArmijoSolver::solve()");
-      return SolverState<Scalar>(SolveCrashed, 
-        "NewtonArmijoSolver: line search failed",i, normF0);
+      return SolverState<Scalar>(SolveCrashed, failMsg, i, normF0);
     }
+
+    /* rebuild early if a lagged Jacobian is no longer contracting well */
+    if (normF0 > jacRebuildRatio_*normFPrev) rebuildJac = true;
   }
   
+  PLAYA_MSG2(verb_, tab0 << "Jacobian builds: " << numJacBuilds_
+    << " preconditioner builds: " << numPrecBuilds_);
   PLAYA_MSG1(verb_, tab0 << " done Playa::NewtonArmijoSolver::solve()");
   return SolverState<Scalar>(SolveFailedToConverge, "NewtonArmijoSolver: convergence failure after "
     + Teuchos::toString(maxIters_) + " steps.", maxIters_, normF0); 
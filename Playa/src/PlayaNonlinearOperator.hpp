@@ -87,7 +87,24 @@ public:
       return this->ptr()->getFunctionValue();
     }
 
-      
+
+  /** */
+  Vector<double> getFunctionValueAt(const Vector<double>& x) const 
+    {
+      return this->ptr()->getFunctionValueAt(x);
+    }
+
+  /** */
+  void setJacobianFree(bool jacobianFree) const 
+    {
+      this->ptr()->setJacobianFree(jacobianFree);
+    }
+
+  /** */
+  bool isJacobianFree() const 
+    {
+      return this->ptr()->isJacobianFree();
+    }
 
   /** */
   Vector<double> getInitialGuess() const 
@@ -49,6 +49,7 @@
 #include "PlayaVectorDecl.hpp"
 #include "PlayaLinearOperatorDecl.hpp"
 #include "PlayaLinearCombinationDecl.hpp"
+#include "PlayaJacobianFreeOp.hpp"
 
 namespace Playa
 {
@@ -67,6 +68,7 @@ public:
    * domain and range spaces at the beginning of construction time */
   NonlinearOperatorBase() 
     : domain_(), range_(), 
+      jacobianFree_(false),
       jacobianIsValid_(false),
       residualIsValid_(false),
       currentEvalPt_(),
@@ -78,6 +80,7 @@ public:
   NonlinearOperatorBase(const VectorSpace<Scalar>& domain,
     const VectorSpace<Scalar>& range) 
     : domain_(domain.ptr()), range_(range.ptr()), 
+      jacobianFree_(false),
       jacobianIsValid_(false),
       residualIsValid_(false),
       currentEvalPt_(),
@@ -116,14 +119,29 @@ public:
    * evaluated */
   const Vector<double>& currentEvalPt() const {return currentEvalPt_;}
 
-  /** Return the Jacobian at the current evaluation point */
+  /** Return the Jacobian at the current evaluation point. In 
+   * Jacobian-free mode this is a JacobianFreeOp, and only the function
+   * value and the preconditioning matrix are computed. */
   LinearOperator<double> getJacobian() const 
     {
       if (this->verb() > 1)
       {
         Out::os() << "NonlinearOperatorBase getting Jacobian" << std::endl;
       }
-      if (!jacobianIsValid_)
+      if (!jacobianIsValid_ && jacobianFree_)
+      {
+        if (this->verb() > 3)
+        {
+          Out::os() << "...creating Jacobian-free J" << std::endl;
+        }
+        Vector<double> F = getFunctionValue();
+        RCP<LinearOperatorBase<Scalar> > J 
+          = rcp(new JacobianFreeOp(this, currentEvalPt_.copy(),
+              F.copy(), computePreconditioningMatrix()));
+        currentJ_ = J;
+        jacobianIsValid_ = true;
+      }
+      else if (!jacobianIsValid_)
       {
         if (this->verb() > 3)
         {
@@ -186,6 +204,44 @@ public:
     }
 
 
+  /** Evaluate the function at x, leaving the current evaluation point
+   * and any cached function value unchanged. This is efficient only for
+   * operators that override computeFunctionValue(); otherwise the 
+   * cached Jacobian is also discarded. */
+  Vector<double> getFunctionValueAt(const Vector<double>& x) const 
+    {
+      if (this->verb() > 1)
+      {
+        Out::os() << "NonlinearOperatorBase getting function value at "
+          "a trial point" << std::endl;
+      }
+      Vector<double> savedPt = currentEvalPt_.copy();
+      Vector<double> savedF = currentFunctionValue_;
+      if (savedF.ptr().get() != 0) 
+        currentFunctionValue_ = savedF.copy();
+
+      currentEvalPt_.acceptCopyOf(x);
+      Vector<double> rtn = computeFunctionValue();
+
+      currentEvalPt_.acceptCopyOf(savedPt);
+      currentFunctionValue_ = savedF;
+      if (savedPt.ptr().get() != 0) evalPtRestored(currentEvalPt_);
+      if (!jacobianFree_) jacobianIsValid_ = false;
+      return rtn;
+    }
+
+  /** Switch Jacobian-free mode on or off. In Jacobian-free mode 
+   * getJacobian() returns a JacobianFreeOp that applies J by 
+   * differencing function values instead of an assembled matrix. */
+  void setJacobianFree(bool jacobianFree) const 
+    {
+      jacobianFree_ = jacobianFree;
+      jacobianIsValid_ = false;
+    }
+
+  /** Indicate whether Jacobian-free mode is on */
+  bool isJacobianFree() const {return jacobianFree_;}
+
   /** Return an initial guess appropriate to this problem */
   virtual Vector<double> getInitialGuess() const = 0 ;
 
@@ -202,6 +258,19 @@ protected:
       return currentFunctionValue_;
     }
 
+  /** Called when getFunctionValueAt() has put back the current
+   * evaluation point x. Operators that keep their own copy of the 
+   * evaluation point, for instance in a discrete function seen by the
+   * user, should resynchronize it here. The default does nothing. */
+  virtual void evalPtRestored(const Vector<Scalar>& x) const {;}
+
+  /** Compute the matrix from which preconditioners for the Jacobian-free
+   * operator are built. The default returns a null operator, so that 
+   * Jacobian-free solves are unpreconditioned. */
+  virtual LinearOperator<Scalar> computePreconditioningMatrix() const 
+    {
+      return LinearOperator<Scalar>();
+    }
       
   /** Set the domain and range. This is protected so that solver
    * developers don't try to change the spaces on the fly */
@@ -220,6 +289,9 @@ private:
   /** */
   RCP<const VectorSpaceBase<Scalar> > range_;
 
+  /** */
+  mutable bool jacobianFree_;
+
   /** */
   mutable bool jacobianIsValid_;
 
@@ -161,10 +161,9 @@ namespace Playa
 	    Tabs tab2;
 	    Vector<double> Ap = A*p;
 	    double alpha = rtr/(p*Ap);
-	    x += alpha*p;
-	    r -= alpha*Ap;
-	    double rtrNew = r*r;
-	    rNorm = sqrt(rtrNew);
+	    x.update(alpha, p);
+	    rNorm = r.updateAndNorm2(-alpha, Ap);
+	    double rtrNew = rNorm*rNorm;
 	    PLAYA_ROOT_MSG2(verb, tab2 << "iter=" << setw(10) 
 			    << k << setw(20) << "||r||=" << rNorm);
 	    /* check relative residual */
@@ -177,7 +176,7 @@ namespace Playa
 	      }
 	    double beta = rtrNew/rtr;
 	    rtr = rtrNew;
-	    p = r + beta*p;
+	    p.update(1.0, r, beta);
 	  }
       }
 
@@ -0,0 +1,212 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef PLAYA_PIPELINEDCGSOLVER_IMPL_HPP
+#define PLAYA_PIPELINEDCGSOLVER_IMPL_HPP
+
+#include "PlayaPipelinedCGSolverDecl.hpp"
+#include "PlayaVectorOpsDecl.hpp"
+#include "Teuchos_Utils.hpp"
+#include "PlayaSimpleScaledOpDecl.hpp"
+#include "PlayaSimpleComposedOpDecl.hpp"
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorOpsImpl.hpp"
+#include "PlayaLinearOperatorImpl.hpp"
+#include "PlayaLinearSolverBaseImpl.hpp"
+#include "PlayaSimpleScaledOpImpl.hpp"
+#include "PlayaSimpleComposedOpImpl.hpp"
+#include "PlayaSimpleTransposedOpImpl.hpp"
+#endif
+
+
+
+namespace Playa
+{
+using namespace Teuchos;
+
+
+/* */
+template <class Scalar> inline
+PipelinedCGSolver<Scalar>
+::PipelinedCGSolver(const ParameterList& params)
+  : KrylovSolver<Scalar>(params) {;}
+
+/* */
+template <class Scalar> inline
+PipelinedCGSolver<Scalar>::PipelinedCGSolver(const ParameterList& params,
+  const PreconditionerFactory<Scalar>& precond)
+  : KrylovSolver<Scalar>(params, precond) {;}
+
+/* Write to a stream  */
+template <class Scalar> inline
+void PipelinedCGSolver<Scalar>::print(std::ostream& os) const 
+{
+  os << description() << "[" << std::endl;
+  os << this->parameters() << std::endl;
+  os << "]" << std::endl;
+}
+
+    
+template <class Scalar> inline
+SolverState<Scalar> PipelinedCGSolver<Scalar>
+::solveUnprec(const LinearOperator<Scalar>& op,
+  const Vector<Scalar>& b,
+  Vector<Scalar>& soln) const
+{
+  int maxiters = this->getMaxiters();
+  Scalar tol = this->getTol();
+  int verbosity = this->verb();
+
+  Scalar normOfB = b.norm2();
+
+  /* check for trivial case of zero rhs */
+  if (normOfB < tol) 
+  {
+    soln = b.space().createMember();
+    soln.zero();
+    return SolverState<Scalar>(SolveConverged, "RHS was zero", 0, 0.0);
+  }
+
+  /* if the solution vector isn't initialized, start from the RHS */
+  Vector<Scalar> x;
+  if (soln.ptr().get()==0) x = b.copy();
+  else x = soln.copy();
+
+  // r = b - op*x, w = op*r
+  Vector<Scalar> r = b.space().createMember();
+  Vector<Scalar> w = b.space().createMember();
+  op.apply(x, w);
+  r.acceptCopyOf(b);
+  r.update(-1.0, w);
+  op.apply(r, w);
+
+  Vector<Scalar> q = b.space().createMember();
+  Vector<Scalar> z = b.space().createMember();
+  Vector<Scalar> s = b.space().createMember();
+  Vector<Scalar> p = b.space().createMember();
+
+  /* the pairs whose inner products are fused into one reduction:
+   * gamma=(r,r) and delta=(w,r) */
+  Array<Vector<Scalar> > left = tuple(r, w);
+  Array<Vector<Scalar> > right = tuple(r, r);
+  Array<Scalar> dots(2);
+
+  int myRank = MPIComm::world().getRank();
+
+  Scalar resid = -1.0;
+  Scalar gammaOld = 0.0;
+  Scalar alphaOld = 0.0;
+
+  for (int k=0; k<=maxiters; k++)
+  {
+    fusedDots(left, right, dots);
+    Scalar gamma = dots[0];
+    Scalar delta = dots[1];
+
+    // check for convergence
+    resid = sqrt(fabs(gamma))/normOfB;
+    if (myRank==0 && verbosity > 1 ) 
+    {
+      Out::os() << "Pipelined CG: iteration=";
+      Out::os().width(8);
+      Out::os() << k;
+      Out::os().width(20);
+      Out::os() << " resid=" << resid << std::endl;
+    }
+    if (resid < tol)
+    {
+      soln = x;
+      SolverState<Scalar> rtn(SolveConverged, "yippee!!", k, resid);
+      return rtn;
+    }
+    if (k==maxiters) break;
+
+    // q = A*w. With a nonblocking reduction this product would be 
+    // overlapped with the reduction above. 
+    op.apply(w, q);
+
+    Scalar beta = 0.0;
+    Scalar den = delta;
+    if (k > 0)
+    {
+      beta = gamma/gammaOld;
+      den = delta - beta*gamma/alphaOld;
+    }
+    if (Utils::chop(sqrt(fabs(den))/normOfB)==0) 
+    {
+      SolverState<Scalar> rtn(SolveCrashed, 
+        "Pipelined CG breakdown", k, resid);
+      return rtn;
+    }
+    Scalar alpha = gamma/den;
+
+    if (k==0)
+    {
+      z.acceptCopyOf(q);
+      s.acceptCopyOf(w);
+      p.acceptCopyOf(r);
+    }
+    else
+    {
+      z.update(1.0, q, beta);
+      s.update(1.0, w, beta);
+      p.update(1.0, r, beta);
+    }
+
+    x.update(alpha, p);
+    r.update(-alpha, s);
+    w.update(-alpha, z);
+
+    gammaOld = gamma;
+    alphaOld = alpha;
+  }
+    
+  SolverState<Scalar> rtn(SolveFailedToConverge, 
+    "Pipelined CG failed to converge", 
+    maxiters, resid);
+  return rtn;
+}
+
+
+}
+
+#endif
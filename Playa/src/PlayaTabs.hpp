@@ -122,8 +122,16 @@ public:
   static bool& showDepth() {static bool rtn = true; return rtn;}
 
 private:
-  /** */
-  static int& tabLevel() {static int rtn = 0; return rtn;}
+  /** The tab level is kept per thread, so that output from code run
+   * by worker threads does not corrupt the master thread's level. */
+  static int& tabLevel() 
+    {
+      static int rtn = 0; 
+#ifdef _OPENMP
+#pragma omp threadprivate(rtn)
+#endif
+      return rtn;
+    }
 
   /** */
   static int& tabSize() {static int rtn = 2; return rtn;}
@@ -48,6 +48,7 @@
 #include "PlayaVectorSpaceDecl.hpp"
 #include "PlayaVectorFunctorsDecl.hpp"
 #include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_Array.hpp"
 
 namespace Playa
 {
@@ -390,6 +391,39 @@ public:
    */
   Scalar normInf() const ;
 
+  /** 
+   * \brief Update this vector and take its dot product with another
+   * vector in a single pass over memory:
+   * \f$ this=\alpha x + \gamma \,this \f$, returning \f$ (this, y) \f$.
+   * The vector y may be this vector.
+   */
+  Scalar updateAndDot(const Scalar& alpha, const Vector<Scalar>& x, 
+    const Scalar& gamma, const Vector<Scalar>& y);
+
+  /** 
+   * \brief Update this vector and compute its 2-norm in a single pass 
+   * over memory: \f$ this=\alpha x + \gamma \,this \f$, returning 
+   * \f$ \|this\|_2 \f$.
+   */
+  Scalar updateAndNorm2(const Scalar& alpha, const Vector<Scalar>& x, 
+    const Scalar& gamma=1.0);
+
+  /** 
+   * \brief Take dot products of this vector with several other vectors
+   * in a single pass over this vector and with a single global 
+   * reduction: result[j] = (this, y[j]).
+   */
+  void dots(const Teuchos::Array<Vector<Scalar> >& y, 
+    Teuchos::Array<Scalar>& result) const ;
+
+  /** 
+   * \brief Add the on-processor parts of the dot products (this, y[j])
+   * into result[j], without a global reduction. This is the local 
+   * kernel shared by dots() and fusedDots().
+   */
+  void localDots(const Teuchos::Array<Vector<Scalar> >& y, 
+    Scalar* result) const ;
+
   /**
    *  \brief Set all elements to zero 
    */
@@ -471,6 +505,14 @@ protected:
 
 private:
 
+  /** The on-processor part of updateAndDot() */
+  Scalar localUpdateAndDot(const Scalar& alpha, const Vector<Scalar>& x, 
+    const Scalar& gamma, const Vector<Scalar>& y);
+
+  /** The on-processor part of a dot product, computed chunk by chunk.
+   * This is the fallback for vectors without single-chunk storage. */
+  static Scalar localChunkedDot(const Vector<Scalar>& x, 
+    const Vector<Scalar>& y);
 };
 
 
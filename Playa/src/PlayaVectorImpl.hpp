@@ -47,6 +47,7 @@
 #include "PlayaBlockVectorBaseDecl.hpp"
 #include "PlayaVectorFunctorsImpl.hpp"
 #include "PlayaSingleChunkVector.hpp"
+#include "PlayaFusedKernels.hpp"
 #include "PlayaLoadableVector.hpp"
 #include "PlayaPrintable.hpp"
 #include "PlayaExceptions.hpp"
@@ -794,6 +795,157 @@ Scalar Vector<Scalar>::normInf() const
 }
 
 
+//===========================================================================
+template <class Scalar> inline 
+Scalar Vector<Scalar>::updateAndDot(const Scalar& alpha, 
+  const Vector<Scalar>& x, 
+  const Scalar& gamma, const Vector<Scalar>& y)
+{
+  TimeMonitor t(*opTimer());
+  PLAYA_CHECK_SPACES(this->space(), x.space());
+  PLAYA_CHECK_SPACES(this->space(), y.space());
+
+  Scalar local = localUpdateAndDot(alpha, x, gamma, y);
+  Scalar rtn = local;
+  this->comm().allReduce(&local, &rtn, 1, MPIDataType::doubleType(), 
+    MPIOp::sumOp());
+  return rtn;
+}
+
+//===========================================================================
+template <class Scalar> inline 
+Scalar Vector<Scalar>::updateAndNorm2(const Scalar& alpha, 
+  const Vector<Scalar>& x, const Scalar& gamma)
+{
+  return ::sqrt(updateAndDot(alpha, x, gamma, *this));
+}
+
+//===========================================================================
+template <class Scalar> inline 
+void Vector<Scalar>::dots(const Teuchos::Array<Vector<Scalar> >& y, 
+  Teuchos::Array<Scalar>& result) const 
+{
+  TimeMonitor t(*opTimer());
+  for (int j=0; j<y.size(); j++)
+  {
+    PLAYA_CHECK_SPACES(this->space(), y[j].space());
+  }
+
+  Teuchos::Array<Scalar> local(y.size(), 0.0);
+  result.resize(y.size());
+  if (y.size()==0) return;
+
+  localDots(y, &(local[0]));
+  this->comm().allReduce(&(local[0]), &(result[0]), y.size(), 
+    MPIDataType::doubleType(), MPIOp::sumOp());
+}
+
+//===========================================================================
+template <class Scalar> inline 
+Scalar Vector<Scalar>::localUpdateAndDot(const Scalar& alpha, 
+  const Vector<Scalar>& x, 
+  const Scalar& gamma, const Vector<Scalar>& y)
+{
+  if (dynamic_cast<BlockVectorBase<Scalar>* >(this->ptr().get()) != 0)
+  {
+    Scalar rtn = 0.0;
+    for (int i=0; i<this->numBlocks(); i++)
+    {
+      rtn += getNonConstBlock(i).localUpdateAndDot(alpha, x.getBlock(i),
+        gamma, y.getBlock(i));
+    }
+    return rtn;
+  }
+
+  SingleChunkVector<Scalar>* me 
+    = dynamic_cast<SingleChunkVector<Scalar>* >(this->ptr().get());
+  const SingleChunkVector<Scalar>* xs 
+    = dynamic_cast<const SingleChunkVector<Scalar>* >(x.ptr().get());
+  const SingleChunkVector<Scalar>* ys 
+    = dynamic_cast<const SingleChunkVector<Scalar>* >(y.ptr().get());
+
+  if (me != 0 && xs != 0 && ys != 0)
+  {
+    int n = me->chunkSize();
+    if (n==0) return 0.0;
+    return PlayaFusedKernels::updateAndDot(n, alpha, xs->dataPtr(), 
+      gamma, me->dataPtr(), ys->dataPtr());
+  }
+
+  this->ptr()->update(alpha, x.ptr().get(), gamma);
+  return localChunkedDot(*this, y);
+}
+
+//===========================================================================
+template <class Scalar> inline 
+void Vector<Scalar>::localDots(const Teuchos::Array<Vector<Scalar> >& y, 
+  Scalar* result) const 
+{
+  int m = y.size();
+  if (dynamic_cast<const BlockVectorBase<Scalar>* >(this->ptr().get()) != 0)
+  {
+    Teuchos::Array<Vector<Scalar> > yBlocks(m);
+    for (int i=0; i<this->numBlocks(); i++)
+    {
+      for (int j=0; j<m; j++) yBlocks[j] = y[j].getBlock(i);
+      getBlock(i).localDots(yBlocks, result);
+    }
+    return;
+  }
+
+  const SingleChunkVector<Scalar>* me 
+    = dynamic_cast<const SingleChunkVector<Scalar>* >(this->ptr().get());
+  Teuchos::Array<const Scalar*> yPtrs(m);
+  bool allSingleChunk = (me != 0);
+  for (int j=0; j<m && allSingleChunk; j++)
+  {
+    const SingleChunkVector<Scalar>* ys 
+      = dynamic_cast<const SingleChunkVector<Scalar>* >(y[j].ptr().get());
+    if (ys == 0) allSingleChunk = false;
+    else if (me->chunkSize() > 0) yPtrs[j] = ys->dataPtr();
+  }
+
+  if (allSingleChunk)
+  {
+    int n = me->chunkSize();
+    if (n==0) return;
+    PlayaFusedKernels::multiDot(n, me->dataPtr(), m, &(yPtrs[0]), result);
+    return;
+  }
+
+  for (int j=0; j<m; j++) result[j] += localChunkedDot(*this, y[j]);
+}
+
+//===========================================================================
+template <class Scalar> inline 
+Scalar Vector<Scalar>::localChunkedDot(const Vector<Scalar>& x, 
+  const Vector<Scalar>& y)
+{
+  /* the chunk iterator belongs to the vector, so a vector paired with
+   * itself must be traversed only once */
+  bool same = x.ptr().get() == y.ptr().get();
+  Scalar rtn = 0.0;
+  while (x.hasMoreChunks())
+  {
+    ConstDataChunk<Scalar> xChunk = x.nextConstChunk();
+    const Scalar* xv = xChunk.values();
+    if (same)
+    {
+      for (int i=0; i<xChunk.size(); i++) rtn += xv[i]*xv[i];
+    }
+    else
+    {
+      ConstDataChunk<Scalar> yChunk = y.nextConstChunk();
+      const Scalar* yv = yChunk.values();
+      for (int i=0; i<xChunk.size(); i++) rtn += xv[i]*yv[i];
+    }
+  }
+  x.rewind();
+  y.rewind();
+  return rtn;
+}
+
+
 
 
 //===========================================================================
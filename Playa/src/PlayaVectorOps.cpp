@@ -62,6 +62,11 @@ template double minlocWithBound(const double& lowerBound,
 /** */
 template double maxlocWithBound(const double& upperBound, 
   const Vector<double>& x, int& gni);
+
+/** */
+template void fusedDots(const Teuchos::Array<Vector<double> >& x, 
+  const Teuchos::Array<Vector<double> >& y,
+  Teuchos::Array<double>& dots);
   
 
 }
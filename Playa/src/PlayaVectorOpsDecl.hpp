@@ -43,6 +43,7 @@
 #define PLAYA_VECTOROPSDECL_HPP
 
 #include "PlayaDefs.hpp"
+#include "Teuchos_Array.hpp"
 
 namespace Playa
 {
@@ -95,6 +96,15 @@ Scalar norm1Dist(const Vector<Scalar>& x, const Vector<Scalar>& y);
 template <class Scalar>
 Scalar normInfDist(const Vector<Scalar>& x, const Vector<Scalar>& y);
 
+/** \relates Vector 
+ * \brief Compute the dot products x[i]*y[i] for several pairs of vectors
+ * with a single global reduction. Krylov solvers use this to combine
+ * the inner products needed in an iteration into one all-reduce. */
+template <class Scalar>
+void fusedDots(const Teuchos::Array<Vector<Scalar> >& x, 
+  const Teuchos::Array<Vector<Scalar> >& y,
+  Teuchos::Array<Scalar>& dots);
+
 }
 
  
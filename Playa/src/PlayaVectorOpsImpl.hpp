@@ -127,6 +127,38 @@ Scalar normInfDist(const Vector<Scalar>& x, const Vector<Scalar>& y)
     PlayaFunctors::NormInfDist<Scalar>(x.comm()), y);
 }
 
+/* */
+template <class Scalar>
+void fusedDots(const Teuchos::Array<Vector<Scalar> >& x, 
+  const Teuchos::Array<Vector<Scalar> >& y,
+  Teuchos::Array<Scalar>& dots)
+{
+  TimeMonitor t(*Vector<Scalar>::opTimer());
+
+  TEUCHOS_TEST_FOR_EXCEPTION(x.size() != y.size(), std::runtime_error,
+    "mismatched argument lengths " << x.size() << " and " << y.size()
+    << " in fusedDots()");
+
+  int n = x.size();
+  Teuchos::Array<Scalar> local(n, 0.0);
+  dots.resize(n);
+  if (n==0) return;
+
+  for (int j=0; j<n; j++)
+  {
+    TEUCHOS_TEST_FOR_EXCEPTION(!x[j].space().isCompatible(y[j].space()),
+      std::runtime_error,
+      "Spaces x=" << x[j].space() << " and y="
+      << y[j].space() << " are not compatible in fusedDots()");
+
+    Teuchos::Array<Vector<Scalar> > yj(1, y[j]);
+    x[j].localDots(yj, &(local[j]));
+  }
+
+  x[0].comm().allReduce(&(local[0]), &(dots[0]), n, 
+    MPIDataType::doubleType(), MPIOp::sumOp());
+}
+
 /** \relates Vector \brief Compute the Euclidean norm of a vector */
 template <class Scalar>
 Scalar norm2(const Vector<Scalar>& x) {return x.norm2();}
@@ -0,0 +1,210 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+/* @HEADER@ */
+
+
+#include <cstdlib>
+#include "Teuchos_GlobalMPISession.hpp"
+#include "PlayaLoadableMatrix.hpp"
+#include "PlayaEpetraVectorType.hpp"
+#include "PlayaEpetraVectorSpace.hpp"
+#include "PlayaEpetraMatrix.hpp"
+#include "PlayaIncrementallyConfigurableMatrixFactory.hpp"
+#include "Teuchos_Time.hpp"
+#include "PlayaMPIComm.hpp"
+#include "PlayaOut.hpp"
+#include "PlayaLinearCombinationImpl.hpp"
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorImpl.hpp"
+#include "PlayaLinearOperatorImpl.hpp"
+#endif
+
+using namespace Teuchos;
+using namespace Playa;
+using namespace PlayaExprTemplates;
+using std::endl;
+
+/* 
+ * Loads a 1D stiffness matrix element by element, in batches, with and 
+ * without pattern locking, and checks that the results agree. The 
+ * last locked passes visit the batches in a different order, permute
+ * the elements inside each batch while keeping the first one in place,
+ * and skip a row, all of which must be detected and handled by falling
+ * back to the unlocked path.
+ */
+
+enum FillOrder {Forward, Reverse, Permuted};
+
+void fill(LoadableMatrix<double>* mat, int nElems, int batchSize, 
+  FillOrder order, bool skipLastRow=false)
+{
+  int nBatches = nElems/batchSize;
+  Array<int> rows(2*batchSize);
+  Array<int> cols(2*batchSize);
+  Array<double> vals(4*batchSize);
+  Array<int> skip(2*batchSize, 0);
+  if (skipLastRow) skip[2*batchSize-1] = 1;
+
+  mat->zero();
+  for (int b=0; b<nBatches; b++)
+  {
+    int bb = (order==Reverse) ? nBatches-1-b : b;
+    for (int e=0; e<batchSize; e++)
+    {
+      int ee = e;
+      if (order==Permuted && e > 0) ee = batchSize - e;
+      int elem = bb*batchSize + ee;
+      double k = 1.0 + 0.001*elem;
+      for (int r=0; r<2; r++) 
+      {
+        rows[2*e+r] = elem + r;
+        cols[2*e+r] = elem + r;
+        vals[4*e+2*r+r] = k;
+        vals[4*e+2*r+1-r] = -k;
+      }
+    }
+    mat->addToElementBatch(2*batchSize, 2, &(rows[0]), 2, &(cols[0]), 
+      &(vals[0]), &(skip[0]));
+  }
+}
+
+int main(int argc, char *argv[]) 
+{
+  int stat = 0;
+  try
+  {
+    GlobalMPISession session(&argc, &argv);
+
+    int nElems = 100000;
+    int batchSize = 100;
+    int nPasses = 10;
+    int nNodes = nElems + 1;
+
+    VectorType<double> type = new EpetraVectorType();
+    VectorSpace<double> space 
+      = type.createEvenlyPartitionedSpace(MPIComm::self(), nNodes);
+
+    RCP<MatrixFactory<double> > mFact 
+      = type.createMatrixFactory(space, space);
+    IncrementallyConfigurableMatrixFactory* icmf 
+      = dynamic_cast<IncrementallyConfigurableMatrixFactory*>(mFact.get());
+    for (int e=0; e<nElems; e++)
+    {
+      Array<int> idx = tuple(e, e+1);
+      icmf->initializeNonzerosInRow(e, 2, &(idx[0]));
+      icmf->initializeNonzerosInRow(e+1, 2, &(idx[0]));
+    }
+    icmf->finalize();
+
+    LinearOperator<double> A = mFact->createMatrix();
+    LoadableMatrix<double>* mat = A.matrix().get();
+
+    Vector<double> x = space.createMember();
+    x.randomize();
+
+    EpetraMatrix::lockAssemblyPattern() = false;
+    Time unlockedTimer("unlocked");
+    for (int p=0; p<nPasses; p++)
+    {
+      unlockedTimer.start();
+      fill(mat, nElems, batchSize, Forward);
+      unlockedTimer.stop();
+    }
+    Vector<double> y0 = A*x;
+
+    EpetraMatrix::lockAssemblyPattern() = true;
+    Time lockedTimer("locked");
+    double err = 0.0;
+    for (int p=0; p<nPasses; p++)
+    {
+      lockedTimer.start();
+      fill(mat, nElems, batchSize, Forward);
+      lockedTimer.stop();
+      Vector<double> y = A*x;
+      err = std::max(err, (y-y0).norm2());
+    }
+
+    fill(mat, nElems, batchSize, Reverse);
+    Vector<double> y1 = A*x;
+    err = std::max(err, (y1-y0).norm2());
+
+    fill(mat, nElems, batchSize, Forward);
+    Vector<double> y2 = A*x;
+    err = std::max(err, (y2-y0).norm2());
+
+    fill(mat, nElems, batchSize, Forward);
+    fill(mat, nElems, batchSize, Permuted);
+    Vector<double> y3 = A*x;
+    err = std::max(err, (y3-y0).norm2());
+
+    fill(mat, nElems, batchSize, Forward);
+    fill(mat, nElems, batchSize, Forward, true);
+    Vector<double> y4 = A*x;
+    EpetraMatrix::lockAssemblyPattern() = false;
+
+    fill(mat, nElems, batchSize, Forward, true);
+    Vector<double> y5 = A*x;
+    err = std::max(err, (y4-y5).norm2());
+
+    Out::os() << "unlocked fill time = " 
+              << unlockedTimer.totalElapsedTime()/nPasses << endl;
+    Out::os() << "locked fill time   = " 
+              << lockedTimer.totalElapsedTime()/nPasses 
+              << " (first pass records)" << endl;
+    Out::os() << "error = " << err << endl;
+
+    double tol = 1.0e-10;
+    if (err > tol*y0.norm2()) 
+    {
+      stat = -1;
+      Out::os() << "pattern-locked fill test FAILED" << endl;
+    }
+    else
+    {
+      Out::os() << "pattern-locked fill test PASSED" << endl;
+    }
+  }
+  catch(std::exception& e)
+  {
+    stat = -1;
+    Out::os() << "Caught exception: " << e.what() << endl;
+  }
+  return stat;
+}
@@ -146,6 +146,8 @@ int main(int argc, char *argv[])
     LinearSolver<double> aztec_ml = LinearSolverBuilder::createSolver("aztec-ml.xml");
     LinearSolver<double> aztec_ifpack = LinearSolverBuilder::createSolver("aztec-ifpack.xml");
     LinearSolver<double> bicgstab = LinearSolverBuilder::createSolver("bicgstab.xml");
+    LinearSolver<double> fusedBicgstab = LinearSolverBuilder::createSolver("fused-bicgstab.xml");
+    LinearSolver<double> pipelinedCG = LinearSolverBuilder::createSolver("pipelined-cg.xml");
 
     bool allOK = true;
 
@@ -165,6 +167,12 @@ int main(int argc, char *argv[])
     Out::root() << "Running BICGSTAB" << std::endl;
     allOK = runit(epetra, bicgstab) && allOK;
 
+    Out::root() << "Running fused BICGSTAB" << std::endl;
+    allOK = runit(epetra, fusedBicgstab) && allOK;
+
+    Out::root() << "Running pipelined CG" << std::endl;
+    allOK = runit(epetra, pipelinedCG) && allOK;
+
 #ifdef BLAH
     if (nProc == 1)
     {
@@ -0,0 +1,251 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                 Playa: Programmable Linear Algebra
+//                 Copyright 2012 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "PlayaGlobalAnd.hpp"
+#include "PlayaEpetraVectorType.hpp"
+#include "PlayaSerialVectorType.hpp"
+#include "PlayaVectorDecl.hpp"
+#include "PlayaVectorSpaceDecl.hpp"
+#include "PlayaVectorType.hpp"
+#include "PlayaOut.hpp"
+#include "PlayaRand.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_Time.hpp"
+#include "PlayaMPIComm.hpp"
+#include "PlayaLinearCombinationImpl.hpp"
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorImpl.hpp"
+#include "PlayaBlockIteratorImpl.hpp"
+#endif
+
+using std::endl;
+using std::setw;
+using namespace Playa;
+using namespace PlayaExprTemplates;
+
+/*
+ * Microbenchmark for the fused vector operations updateAndDot(),
+ * dots() and updateAndNorm2(). Each is compared to the equivalent 
+ * sequence of unfused operations. The timing is reported as effective
+ * memory bandwidth, counting the vector data each variant must read and
+ * write. The results of the fused and unfused variants are also checked
+ * against each other.
+ */
+
+/* Report bandwidth in GB/s for nDoubles doubles moved per repetition */
+static double gbPerSec(double nDoubles, int nReps, const Time& t)
+{
+  double secs = std::max(t.totalElapsedTime(), 1.0e-12);
+  return nDoubles * sizeof(double) * nReps / secs / 1.0e9;
+}
+
+static bool relClose(double a, double b, double tol)
+{
+  return ::fabs(a-b) <= tol*(1.0 + ::fabs(a));
+}
+
+bool runTest(const std::string& name, const VectorType<double>& vecType,
+  int nLocal)
+{
+  bool pass = true;
+  int nProc = MPIComm::world().getNProc();
+  int nReps = 20;
+  int m = 4;
+  double tol = 1.0e-10;
+  double n = nLocal;
+
+  VectorSpace<double> space 
+    = vecType.createEvenlyPartitionedSpace(MPIComm::world(), nLocal*nProc);
+  Rand::setLocalSeed(space.comm(), 314159);
+
+  Vector<double> x = space.createMember();
+  x.randomize();
+  Vector<double> z1 = space.createMember();
+  z1.randomize();
+  Vector<double> z2 = z1.copy();
+  Array<Vector<double> > y(m);
+  for (int j=0; j<m; j++) 
+  {
+    y[j] = space.createMember();
+    y[j].randomize();
+  }
+
+  /* small coefficients keep the values bounded over the repetitions */
+  double alpha = 1.0e-3;
+  double gamma = 0.999;
+
+  Out::root() << name << ": local size=" << nLocal << endl;
+
+  /* axpby plus dot */
+  Time tUnfused("update+dot");
+  Time tFused("updateAndDot");
+  double d1 = 0.0;
+  double d2 = 0.0;
+  for (int r=0; r<nReps; r++)
+  {
+    tUnfused.start();
+    z1.update(alpha, x, gamma);
+    d1 = z1.dot(y[0]);
+    tUnfused.stop();
+
+    tFused.start();
+    d2 = z2.updateAndDot(alpha, x, gamma, y[0]);
+    tFused.stop();
+  }
+  Out::root() << "   axpby+dot:  unfused " << setw(10) 
+              << gbPerSec(5*n, nReps, tUnfused) << " GB/s, fused " 
+              << setw(10) << gbPerSec(4*n, nReps, tFused) << " GB/s" 
+              << endl;
+  if (!relClose(d1, d2, tol)) 
+  {
+    Out::root() << "******** ERROR: dot products differ: " << d1 
+                << " " << d2 << endl;
+    pass = false;
+  }
+  
+  /* several dots against one vector */
+  Time tSeparate("separate dots");
+  Time tMulti("dots");
+  Array<double> sep(m);
+  Array<double> multi;
+  for (int r=0; r<nReps; r++)
+  {
+    tSeparate.start();
+    for (int j=0; j<m; j++) sep[j] = x.dot(y[j]);
+    tSeparate.stop();
+
+    tMulti.start();
+    x.dots(y, multi);
+    tMulti.stop();
+  }
+  Out::root() << "   " << m << " dots:     unfused " << setw(10) 
+              << gbPerSec(2*m*n, nReps, tSeparate) << " GB/s, fused " 
+              << setw(10) << gbPerSec((m+1)*n, nReps, tMulti) << " GB/s" 
+              << endl;
+  for (int j=0; j<m; j++)
+  {
+    if (!relClose(sep[j], multi[j], tol)) 
+    {
+      Out::root() << "******** ERROR: dot product " << j << " differs: " 
+                  << sep[j] << " " << multi[j] << endl;
+      pass = false;
+    }
+  }
+
+  /* update plus norm of the result */
+  Time tUnfusedNorm("update+norm2");
+  Time tFusedNorm("updateAndNorm2");
+  for (int r=0; r<nReps; r++)
+  {
+    tUnfusedNorm.start();
+    z1.update(-alpha, x);
+    d1 = z1.norm2();
+    tUnfusedNorm.stop();
+
+    tFusedNorm.start();
+    d2 = z2.updateAndNorm2(-alpha, x);
+    tFusedNorm.stop();
+  }
+  Out::root() << "   axpy+norm2: unfused " << setw(10) 
+              << gbPerSec(4*n, nReps, tUnfusedNorm) << " GB/s, fused " 
+              << setw(10) << gbPerSec(3*n, nReps, tFusedNorm) << " GB/s" 
+              << endl;
+  if (!relClose(d1, d2, tol)) 
+  {
+    Out::root() << "******** ERROR: norms differ: " << d1 
+                << " " << d2 << endl;
+    pass = false;
+  }
+
+  double updateErr = (z1 - z2).norm2() / z1.norm2();
+  if (updateErr > tol)
+  {
+    Out::root() << "******** ERROR: updated vectors differ by " 
+                << updateErr << endl;
+    pass = false;
+  }
+
+  return pass;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int stat = 0;
+  try
+  {
+    GlobalMPISession session(&argc, &argv);
+    int nProc = session.getNProc();
+
+    int nLocal = 1000000;
+    if (argc > 1) nLocal = atoi(argv[1]);
+
+    bool allPass = true;
+
+    if (nProc==1)
+    {
+      VectorType<double> serial = new SerialVectorType();
+      allPass = runTest("SerialVector", serial, nLocal) && allPass;
+    }
+
+    VectorType<double> epetra = new EpetraVectorType();
+    allPass = runTest("EpetraVector", epetra, nLocal) && allPass;
+
+    allPass = globalAnd(allPass);
+
+    if (!allPass)
+    {
+      Out::root() << "fused kernel test FAILED" << std::endl;
+      stat = -1;
+    }
+    else
+    {
+      Out::root() << "fused kernel test PASSED" << std::endl;
+    }
+  }
+  catch(std::exception& e)
+  {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    stat = -1;
+  }
+  return stat;
+}
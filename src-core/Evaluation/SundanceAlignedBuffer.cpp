@@ -0,0 +1,79 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceAlignedBuffer.hpp"
+#include <cstddef>
+
+using namespace Sundance;
+
+
+AlignedBuffer::AlignedBuffer()
+  : raw_(0), data_(0), size_(0), capacity_(0)
+{}
+
+AlignedBuffer::~AlignedBuffer()
+{
+  if (raw_ != 0) delete [] raw_;
+}
+
+void AlignedBuffer::resize(int n)
+{
+  if (n > capacity_)
+  {
+    /* round the capacity up to a whole number of cache lines */
+    const int lineSize = alignment / sizeof(double);
+    int newCapacity = lineSize * ((n + lineSize - 1) / lineSize);
+
+    char* newRaw = new char[newCapacity * sizeof(double) + alignment];
+    std::size_t addr = reinterpret_cast<std::size_t>(newRaw);
+    std::size_t offset = (alignment - addr % alignment) % alignment;
+    double* newData = reinterpret_cast<double*>(newRaw + offset);
+
+    for (int i=0; i<size_; i++) newData[i] = data_[i];
+
+    if (raw_ != 0) delete [] raw_;
+    raw_ = newRaw;
+    data_ = newData;
+    capacity_ = newCapacity;
+  }
+  for (int i=size_; i<n; i++) data_[i] = 0.0;
+  size_ = n;
+}
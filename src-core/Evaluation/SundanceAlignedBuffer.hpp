@@ -0,0 +1,100 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_ALIGNEDBUFFER_H
+#define SUNDANCE_ALIGNEDBUFFER_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceNoncopyable.hpp"
+
+namespace Sundance
+{
+/**
+ * AlignedBuffer is a resizable block of doubles whose first element 
+ * is aligned to a cache line, used as storage for EvalVector 
+ * temporaries. Capacity is allocated in whole cache lines and is never
+ * released by resize(), so that a buffer recycled through a TempStack
+ * can be reused for worksets of any size up to its capacity without
+ * further allocation. As with Array::resize(), existing values are 
+ * preserved and new elements are zeroed when the buffer grows.
+ */
+class AlignedBuffer : public Noncopyable
+{
+public:
+  /** Alignment in bytes of the first element */
+  static const int alignment = 64;
+
+  /** Create an empty buffer */
+  AlignedBuffer();
+
+  /** */
+  ~AlignedBuffer();
+
+  /** Set the number of elements, reallocating only if the current
+   * capacity is too small */
+  void resize(int n);
+
+  /** */
+  int size() const {return size_;}
+
+  /** Number of elements that fit without reallocation */
+  int capacity() const {return capacity_;}
+
+  /** */
+  double& operator[](int i) {return data_[i];}
+
+  /** */
+  const double& operator[](int i) const {return data_[i];}
+
+private:
+  /** raw storage, including padding for alignment */
+  char* raw_;
+
+  /** aligned start of the storage */
+  double* data_;
+
+  int size_;
+
+  int capacity_;
+};
+}
+
+#endif
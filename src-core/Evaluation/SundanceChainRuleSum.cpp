@@ -62,7 +62,8 @@ ChainRuleSum::ChainRuleSum(const MultipleDeriv& md,
     resultIsConstant_(resultIsConstant),
     argDerivIndex_(),
     argDerivIsConstant_(),
-    terms_()
+    terms_(),
+    fusedSum_()
 {;}
 
 
@@ -140,6 +141,45 @@ void ChainRuleSum
   
   varResult = mgr.popVector();
   varResult->resize(vecSize);
+
+  /* Unless we're tracking symbolic strings, expand the sum of 
+   * (df/dq)*(inner sum) into a flat sum of products and evaluate it
+   * in a single pass over the result. */
+  if (!EvalVector::shadowOps())
+    {
+      fusedSum_.clear();
+      for (int i=0; i<numTerms(); i++)
+        {
+          int adi = argDerivIndex(i);
+          double outerCoeff = 1.0;
+          const EvalVector* df_dq = 0;
+          if (argDerivIsConstant(i)) outerCoeff = constantArgDerivs[adi];
+          else df_dq = varArgDerivs[adi].get();
+
+          const Array<DerivProduct>& sumOfDerivProducts = terms(i);
+          for (int j=0; j<sumOfDerivProducts.size(); j++)
+            {
+              const DerivProduct& p = sumOfDerivProducts[j];
+              double cc = outerCoeff*p.coeff();
+              for (int k=0; k<p.numConstants(); k++)
+                {
+                  const IndexPair& ip = p.constant(k);
+                  cc *= (*(constantArgResults[ip.argIndex()]))[ip.valueIndex()];
+                }
+              fusedSum_.startTerm(cc);
+              if (df_dq != 0) fusedSum_.addFactor(df_dq);
+              for (int k=0; k<p.numVariables(); k++)
+                {
+                  const IndexPair& ip = p.variable(k);
+                  fusedSum_.addFactor((*(vArgResults[ip.argIndex()]))[ip.valueIndex()].get());
+                }
+            }
+        }
+      fusedSum_.assignTo(varResult.get());
+      SUNDANCE_VERB_HIGH(tabs << "fused sum=" << *varResult);
+      return;
+    }
+
   varResult->setToConstant(0.0);
 
   for (int i=0; i<numTerms(); i++)
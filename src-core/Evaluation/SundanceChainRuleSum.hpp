@@ -45,6 +45,7 @@
 #include "SundanceDefs.hpp"
 #include "SundanceEvalManager.hpp"
 #include "SundanceEvaluator.hpp"
+#include "SundanceFusedProductSum.hpp"
 #include "Teuchos_Array.hpp"
 
 namespace Sundance 
@@ -173,6 +174,9 @@ private:
   Array<int> argDerivIndex_;
   Array<int> argDerivIsConstant_;
   Array<Array<DerivProduct> > terms_;
+
+  /** Workspace for the fused evaluation of the vector sum */
+  mutable FusedProductSum fusedSum_;
 };
 
 }
@@ -71,7 +71,8 @@ ProductEvaluator::ProductEvaluator(const ProductExpr* expr,
     vcTerms_(maxOrder_+1),
     vvTerms_(maxOrder_+1),
     startingVectors_(maxOrder_+1),
-    startingParities_(maxOrder_+1)
+    startingParities_(maxOrder_+1),
+    fusedSum_()
 {
   int verb = context.evalSetupVerbosity();
 
@@ -653,6 +654,35 @@ void ProductEvaluator
       const Array<Array<int> >& vcTerms = vcTerms_[order][i];
       const Array<Array<int> >& vvTerms = vvTerms_[order][i];
 
+      /* When there are several terms to add, accumulate them all in 
+       * a single pass over the result, unless we're tracking symbolic
+       * strings. */
+      if (!EvalVector::shadowOps() 
+        && cvTerms.size() + vcTerms.size() + vvTerms.size() > 1)
+      {
+        fusedSum_.clear();
+        for (int j=0; j<cvTerms.size(); j++)
+        {
+          fusedSum_.addTerm(cvTerms[j][2]*leftConstantResults[cvTerms[j][0]],
+            rightVectorResults[cvTerms[j][1]].get());
+        }
+        for (int j=0; j<vcTerms.size(); j++)
+        {
+          fusedSum_.addTerm(vcTerms[j][2]*rightConstantResults[vcTerms[j][1]],
+            leftVectorResults[vcTerms[j][0]].get());
+        }
+        for (int j=0; j<vvTerms.size(); j++)
+        {
+          fusedSum_.addTerm(vvTerms[j][2],
+            leftVectorResults[vvTerms[j][0]].get(),
+            rightVectorResults[vvTerms[j][1]].get());
+        }
+        SUNDANCE_MSG4(mgr.verb(), tabs << "adding " << fusedSum_.numTerms()
+          << " fused terms");
+        fusedSum_.sumInto(result.get());
+        continue;
+      }
+
       for (int j=0; j<cvTerms.size(); j++)
       {
         SUNDANCE_MSG4(mgr.verb(), tabs << "adding c-v term " << cvTerms[j]);
@@ -46,6 +46,7 @@
 #include "SundanceDefs.hpp"
 #include "SundanceBinaryEvaluator.hpp"
 #include "SundanceProductExpr.hpp"
+#include "SundanceFusedProductSum.hpp"
 #include "Teuchos_TimeMonitor.hpp"
 
 
@@ -95,6 +96,9 @@ private:
 
   Array<Array<Array<int> > > startingVectors_;
   Array<Array<ProductParity> > startingParities_;
+
+  /** Workspace for fused accumulation of the terms of a result */
+  mutable FusedProductSum fusedSum_;
       
       
 
@@ -60,48 +60,90 @@ TempStack::TempStack(int vecSize)
   : 
   vecSize_(vecSize),
   stack_(),
+  vecPool_(),
   numVecsAllocated_(0),
-  numVecsAccessed_(0)
+  numVecsAccessed_(0),
+  numVecsInUse_(0),
+  maxVecsInUse_(0),
+  numEvalVectorsAllocated_(0)
 {}
 
 TempStack::TempStack()
   : 
   vecSize_(0),
   stack_(),
+  vecPool_(),
   numVecsAllocated_(0),
-  numVecsAccessed_(0)
+  numVecsAccessed_(0),
+  numVecsInUse_(0),
+  maxVecsInUse_(0),
+  numEvalVectorsAllocated_(0)
 {}
 
+TempStack::~TempStack()
+{
+  for (unsigned int i=0; i<vecPool_.size(); i++) delete vecPool_[i];
+  for (unsigned int i=0; i<stack_.size(); i++) delete stack_[i];
+}
 
-void TempStack::pushVectorData(const RCP<Array<double> >& vecData)
+
+void TempStack::pushVectorData(AlignedBuffer* vecData)
 {
-  stack_.push(vecData);
+  stack_.push_back(vecData);
+  numVecsInUse_--;
 }
 
-RCP<Array<double> > TempStack::popVectorData()
+AlignedBuffer* TempStack::popVectorData()
 {
-  RCP<Array<double> > data;
+  AlignedBuffer* data;
   if (stack_.empty())
     {
       numVecsAllocated_++;
-      data = rcp(new Array<double>(vecSize_));
+      data = new AlignedBuffer();
     }
   else
     {
-      data = stack_.top();
-      data->resize(vecSize_);
-      stack_.pop();
+      data = stack_.back();
+      stack_.pop_back();
     }
+  data->resize(vecSize_);
   numVecsAccessed_++;
+  numVecsInUse_++;
+  if (numVecsInUse_ > maxVecsInUse_) maxVecsInUse_ = numVecsInUse_;
   return data;
 }
 
+RCP<EvalVector> TempStack::popVector()
+{
+  EvalVector* vec;
+  if (vecPool_.empty())
+    {
+      numEvalVectorsAllocated_++;
+      vec = new EvalVector(this);
+    }
+  else
+    {
+      vec = vecPool_.back();
+      vecPool_.pop_back();
+      vec->data_ = popVectorData();
+    }
+  return rcpWithDealloc(vec, ReturnToPool(this));
+}
+
+void TempStack::releaseVector(EvalVector* vec)
+{
+  pushVectorData(vec->data_);
+  vec->data_ = 0;
+  vec->str_ = "";
+  vecPool_.push_back(vec);
+}
+
 
 
 void TempStack::resetCounter()
 {
   numVecsAllocated_=0;
   numVecsAccessed_=0;
+  maxVecsInUse_=numVecsInUse_;
+  numEvalVectorsAllocated_=0;
 }
-
-
@@ -45,7 +45,8 @@
 #include "SundanceDefs.hpp"
 #include "SundanceEvalVector.hpp"
 #include "SundanceNoncopyable.hpp"
-#include <stack>
+#include "SundanceAlignedBuffer.hpp"
+#include <vector>
 
 namespace Sundance
 {
@@ -84,6 +85,15 @@ using namespace Sundance;
  * from the stack; if the stack is empty, a new temporary is allocated.
  * When a step of a calculation is done, any temporaries used are
  * put back on the stack for further use.
+ *
+ * Both the EvalVector objects and their cache-line-aligned data buffers
+ * are pooled. A vector handed out by popVector() is returned to the pool
+ * when its last reference goes away, and is reused, together with its
+ * buffer, by the next call to popVector(). In steady state, evaluation
+ * of a workset therefore does no heap allocation for temporaries beyond
+ * the reference-count node of the returned RCP. The pool keeps
+ * high-water-mark statistics so that the number of temporaries needed by
+ * an expression can be monitored.
  */
 class TempStack : public Noncopyable
 {
@@ -94,15 +104,17 @@ public:
   /** Construct with an initial vector size */
   TempStack(int vecSize);
 
+  /** Free all pooled vectors and buffers */
+  ~TempStack();
+
   /** Push vector data onto the stack */
-  void pushVectorData(const RCP<Array<double> >& vecData) ;
+  void pushVectorData(AlignedBuffer* vecData) ;
 
   /** Pop vector data from the stack */
-  RCP<Array<double> > popVectorData() ;
+  AlignedBuffer* popVectorData() ;
 
   /** Get a new vector (which will often reuse stack data) */
-  RCP<EvalVector> popVector() 
-    {return rcp(new EvalVector(this));}
+  RCP<EvalVector> popVector() ;
 
   /** */
   void setVecSize(int vecSize) {vecSize_ = vecSize;}
@@ -110,24 +122,56 @@ public:
   /** */
   void resetCounter() ;
 
-  /** */
+  /** Number of vector data requests since the last reset */
   int numVecsAccessed() const {return numVecsAccessed_;}
 
-  /** */
+  /** Number of vector data buffers allocated since the last reset */
   int numVecsAllocated() const {return numVecsAllocated_;}
 
+  /** Number of vector data buffers currently checked out */
+  int numVecsInUse() const {return numVecsInUse_;}
+
+  /** Largest number of vector data buffers checked out at any one
+   * time since the last reset */
+  int maxVecsInUse() const {return maxVecsInUse_;}
+
+  /** Number of EvalVector objects created since the last reset */
+  int numEvalVectorsAllocated() const {return numEvalVectorsAllocated_;}
+
   /** */
   int vecSize() const {return vecSize_;}
 
 private:
+  /** Deallocator returning an EvalVector to its pool when the last
+   * RCP to it is released */
+  class ReturnToPool
+  {
+  public:
+    typedef EvalVector ptr_t;
+    ReturnToPool(TempStack* s) : s_(s) {}
+    void free(EvalVector* vec) {s_->releaseVector(vec);}
+  private:
+    TempStack* s_;
+  };
+
+  /** Put a vector whose last reference has gone back in the pool */
+  void releaseVector(EvalVector* vec) ;
           
   int vecSize_;
 
-  std::stack<RCP<Array<double> > > stack_;
+  std::vector<AlignedBuffer*> stack_;
+
+  std::vector<EvalVector*> vecPool_;
 
   int numVecsAllocated_;
 
   int numVecsAccessed_;
+
+  int numVecsInUse_;
+
+  int maxVecsInUse_;
+
+  int numEvalVectorsAllocated_;
 };
 }
 
@@ -58,35 +58,12 @@ EvalVector::EvalVector(TempStack* s)
   : s_(s),
     data_(s->popVectorData()),
     str_()
-{
-  data_->resize(s->vecSize());
-}
+{}
 
 
-EvalVector::EvalVector(TempStack* s, const RCP<Array<double> >& data,
-                       const std::string& str)
-  : s_(s),
-    data_(s->popVectorData()),
-    str_(str)
-{
-  //TimeMonitor t(evalVecTimer());
-  data_->resize(data->size());
-  int n = data_->size();
-
-  if (n > 0)
-    {
-      double* x = &((*data_)[0]);
-      const double* y = &((*data)[0]);
-      for (int i=0; i<n; i++)
-        {
-          x[i] = y[i];
-        }
-    }
-}
-
 EvalVector::~EvalVector()
 {
-  s_->pushVectorData(data_);
+  if (data_ != 0) s_->pushVectorData(data_);
 }
 
 
@@ -98,7 +75,22 @@ void EvalVector::resize(int n)
 
 RCP<EvalVector> EvalVector::clone() const
 {
-  return rcp(new EvalVector(s_, data_, str_));
+  //TimeMonitor t(evalVecTimer());
+  RCP<EvalVector> rtn = s_->popVector();
+  rtn->data_->resize(data_->size());
+  rtn->str_ = str_;
+  int n = data_->size();
+
+  if (n > 0)
+    {
+      double* x = &((*(rtn->data_))[0]);
+      const double* y = &((*data_)[0]);
+      for (int i=0; i<n; i++)
+        {
+          x[i] = y[i];
+        }
+    }
+  return rtn;
 }
 
 void EvalVector::setToConstant(const double& alpha) 
@@ -798,7 +790,13 @@ void EvalVector::print(std::ostream& os) const
 
   if (data_->size() > 0)
     {
-      os << ", " << *data_;
+      os << ", {";
+      for (int i=0; i<data_->size(); i++)
+        {
+          if (i > 0) os << ", ";
+          os << (*data_)[i];
+        }
+      os << "}";
     }
 }
 
@@ -48,6 +48,7 @@
 #include "SundanceObjectWithVerbosity.hpp"
 #include "SundanceUnaryFunctor.hpp"
 #include "SundanceNoncopyable.hpp"
+#include "SundanceAlignedBuffer.hpp"
 
 
 namespace Sundance
@@ -68,16 +69,15 @@ private:
   /** */
   EvalVector(TempStack* s);
 
-  /** */
-  EvalVector(TempStack* s, const RCP<Array<double> >& data,
-    const std::string& str);
 
 
 public:
   /** 
    * EvalVector has a nontrivial destructor. Upon destruction, 
    * the vector's underlying data object is not destroyed, but rather
-   * is put back on the stack of temporary vectors. 
+   * is put back on the stack of temporary vectors. Vectors obtained
+   * from TempStack::popVector() are normally not destroyed at all, but
+   * are returned to the stack's pool for reuse.
    */
   ~EvalVector();
 
@@ -313,7 +313,7 @@ public:
 
   inline static bool& shadowOps() {static bool rtn = false; return rtn;}
 
-  bool isValid() const {return data_.get() != 0 && s_ != 0;}
+  bool isValid() const {return data_ != 0 && s_ != 0;}
   //@}
 
       
@@ -326,7 +326,7 @@ private:
 
   mutable TempStack* s_;
 
-  RCP<Array<double> > data_;
+  AlignedBuffer* data_;
 
   std::string str_;
 
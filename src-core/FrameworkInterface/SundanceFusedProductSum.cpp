@@ -0,0 +1,144 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceFusedProductSum.hpp"
+#include "SundanceEvalVector.hpp"
+#include <algorithm>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/* Number of evaluation points processed together. A block of the 
+ * result and one of temporary products fit easily in L1 cache. */
+static const int fusedBlockSize = 256;
+
+
+FusedProductSum::FusedProductSum()
+  : coeffs_(), factorPtr_(1, 0), factors_()
+{}
+
+void FusedProductSum::clear()
+{
+  coeffs_.resize(0);
+  factorPtr_.resize(1);
+  factors_.resize(0);
+}
+
+void FusedProductSum::startTerm(const double& coeff)
+{
+  coeffs_.append(coeff);
+  factorPtr_.append(factors_.size());
+}
+
+void FusedProductSum::addFactor(const EvalVector* vec)
+{
+  factors_.append(vec);
+  factorPtr_[factorPtr_.size()-1] = factors_.size();
+}
+
+void FusedProductSum::apply(EvalVector* x, bool overwrite) const
+{
+  int n = x->length();
+  if (n == 0) return;
+
+  double* const xp = x->start();
+  double tmp[fusedBlockSize];
+  double flops = 0.0;
+
+  for (int b0=0; b0<n; b0+=fusedBlockSize)
+  {
+    int nb = std::min(fusedBlockSize, n-b0);
+    double* const xb = xp + b0;
+
+    if (overwrite)
+    {
+      for (int i=0; i<nb; i++) xb[i] = 0.0;
+    }
+
+    for (int t=0; t<coeffs_.size(); t++)
+    {
+      const double c = coeffs_[t];
+      const int f0 = factorPtr_[t];
+      const int nf = factorPtr_[t+1] - f0;
+
+      switch(nf)
+      {
+        case 0:
+          for (int i=0; i<nb; i++) xb[i] += c;
+          break;
+        case 1:
+        {
+          const double* const a = factors_[f0]->start() + b0;
+          for (int i=0; i<nb; i++) xb[i] += c*a[i];
+          break;
+        }
+        case 2:
+        {
+          const double* const a = factors_[f0]->start() + b0;
+          const double* const b = factors_[f0+1]->start() + b0;
+          for (int i=0; i<nb; i++) xb[i] += c*a[i]*b[i];
+          break;
+        }
+        case 3:
+        {
+          const double* const a = factors_[f0]->start() + b0;
+          const double* const b = factors_[f0+1]->start() + b0;
+          const double* const d = factors_[f0+2]->start() + b0;
+          for (int i=0; i<nb; i++) xb[i] += c*a[i]*b[i]*d[i];
+          break;
+        }
+        default:
+        {
+          const double* const a = factors_[f0]->start() + b0;
+          for (int i=0; i<nb; i++) tmp[i] = c*a[i];
+          for (int k=1; k<nf; k++)
+          {
+            const double* const v = factors_[f0+k]->start() + b0;
+            for (int i=0; i<nb; i++) tmp[i] *= v[i];
+          }
+          for (int i=0; i<nb; i++) xb[i] += tmp[i];
+        }
+      }
+      flops += (nf==0) ? nb : (nf+1)*nb;
+    }
+  }
+  EvalVector::totalFlops() += flops;
+}
@@ -0,0 +1,122 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_FUSEDPRODUCTSUM_H
+#define SUNDANCE_FUSEDPRODUCTSUM_H
+
+#include "SundanceDefs.hpp"
+#include "Teuchos_Array.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+class EvalVector;
+
+/**
+ * FusedProductSum represents a sum of scaled products of EvalVectors,
+ * \f[
+ * \sum_t c_t \prod_{k} v_{t,k},
+ * \f]
+ * as arises in the chain rule expansion of derivatives of products and
+ * of nonlinear functions. Evaluating the sum term by term with
+ * EvalVector's add_SV(), add_SVV(), and similar methods makes one pass
+ * over the result vector per term. FusedProductSum instead evaluates
+ * all terms in a single loop blocked over evaluation points, so each 
+ * block of the result stays in cache while every term is added to it.
+ *
+ * FusedProductSum does not track the symbolic strings used by
+ * EvalVector::shadowOps(); callers should use the ordinary 
+ * EvalVector operations when shadowing is on.
+ */
+class FusedProductSum
+{
+public:
+  /** Create an empty sum */
+  FusedProductSum();
+
+  /** Remove all terms, keeping allocated storage for reuse */
+  void clear();
+
+  /** Begin a new term with the given coefficient. Factors are
+   * appended to it with addFactor(). A term with no factors is
+   * the constant c. */
+  void startTerm(const double& coeff);
+
+  /** Multiply the most recently started term by a vector */
+  void addFactor(const EvalVector* vec);
+
+  /** Add the term c*A */
+  void addTerm(const double& coeff, const EvalVector* A)
+    {startTerm(coeff); addFactor(A);}
+
+  /** Add the term c*A*B */
+  void addTerm(const double& coeff, const EvalVector* A, 
+    const EvalVector* B)
+    {startTerm(coeff); addFactor(A); addFactor(B);}
+
+  /** */
+  int numTerms() const {return coeffs_.size();}
+
+  /** Add the sum to x, x = x + sum */
+  void sumInto(EvalVector* x) const {apply(x, false);}
+
+  /** Overwrite x with the sum, x = sum */
+  void assignTo(EvalVector* x) const {apply(x, true);}
+
+private:
+  /** Evaluate the sum into x, either accumulating or overwriting */
+  void apply(EvalVector* x, bool overwrite) const ;
+
+  /** Coefficient of each term */
+  Array<double> coeffs_;
+
+  /** Factors of term t are factors_[factorPtr_[t]] through 
+   * factors_[factorPtr_[t+1]-1] */
+  Array<int> factorPtr_;
+
+  /** */
+  Array<const EvalVector*> factors_;
+};
+
+}
+
+#endif
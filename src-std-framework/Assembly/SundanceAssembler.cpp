@@ -51,6 +51,7 @@
 #include "SundanceDiscreteSpace.hpp"
 #include "SundanceDiscreteFunction.hpp"
 #include "SundanceIntegralGroup.hpp"
+#include "SundanceIntegrationContext.hpp"
 #include "SundanceGrouperBase.hpp"
 #include "SundanceEvalManager.hpp"
 #include "SundanceStdFwkEvalMediator.hpp"
@@ -63,6 +64,9 @@
 #include "Teuchos_Time.hpp"
 #include "Teuchos_TimeMonitor.hpp"
 #include "Epetra_HashTable.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "SundanceIntHashSet.hpp"
 #include "PlayaDefaultBlockVectorSpaceDecl.hpp"
 #include "PlayaBlockOperatorBaseDecl.hpp"
@@ -70,9 +74,12 @@
 #include "SundanceAssemblyKernelBase.hpp"
 #include "SundanceVectorAssemblyKernel.hpp"
 #include "SundanceMatrixVectorAssemblyKernel.hpp"
+#include "SundanceMatrixFreeApplyKernel.hpp"
 #include "SundanceFunctionalAssemblyKernel.hpp"
 #include "SundanceFunctionalGradientAssemblyKernel.hpp"
 #include "SundanceAssemblyTransformationBuilder.hpp"
+#include "SundanceMatrixGraphBuilder.hpp"
+#include "SundanceMatrixGraphCache.hpp"
 #ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
 #include "PlayaLinearOperatorImpl.hpp"
 #include "PlayaSimpleBlockOpImpl.hpp"
@@ -97,6 +104,13 @@ static Time& assemblerCtorTimer()
 
 
 
+static Time& threadedIntegrationTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("threaded integration"); 
+  return *rtn;
+}
+
 static Time& graphBuildTimer() 
 {
   static RCP<Time> rtn 
@@ -855,6 +869,7 @@ void Assembler::configureMatrix(LinearOperator<double>& A,
   if (matNeedsConfiguration())
   {
     Tabs tab0;
+    graphFactories_.resize(0);
 
     int nRowBlocks = rowMap_.size();
     int nColBlocks = colMap_.size();
@@ -910,46 +925,58 @@ void Assembler::configureMatrixBlock(int br, int bc,
   VectorSpace<double> rowSpace = privateRowSpace_[br]->vecSpace();
   VectorSpace<double> colSpace = privateColSpace_[bc]->vecSpace();
 
-  RCP<MatrixFactory<double> > matFactory ;
+  /* Assemblers with the same mesh, spaces, and equation structure
+   * produce the same graph, so look for one that's already built */
+  MatrixGraphKey key = graphKey(br, bc);
+  RCP<MatrixFactory<double> > matFactory = MatrixGraphCache::lookup(key);
 
-  matFactory = rowVecType_[br].createMatrixFactory(colSpace, rowSpace);
+  if (matFactory.get() != 0)
+  {
+    SUNDANCE_MSG2(verb, tab << "Assembler: reusing cached matrix graph");
+  }
+  else
+  {
+    matFactory = rowVecType_[br].createMatrixFactory(colSpace, rowSpace);
 
-  IncrementallyConfigurableMatrixFactory* icmf 
-    = dynamic_cast<IncrementallyConfigurableMatrixFactory*>(matFactory.get());
+    IncrementallyConfigurableMatrixFactory* icmf 
+      = dynamic_cast<IncrementallyConfigurableMatrixFactory*>(matFactory.get());
 
-  CollectivelyConfigurableMatrixFactory* ccmf 
-    = dynamic_cast<CollectivelyConfigurableMatrixFactory*>(matFactory.get());
+    CollectivelyConfigurableMatrixFactory* ccmf 
+      = dynamic_cast<CollectivelyConfigurableMatrixFactory*>(matFactory.get());
 
-  TEUCHOS_TEST_FOR_EXCEPTION(ccmf==0 && icmf==0, std::runtime_error,
-    "Neither incremental nor collective matrix structuring "
-    "appears to be available");
+    TEUCHOS_TEST_FOR_EXCEPTION(ccmf==0 && icmf==0, std::runtime_error,
+      "Neither incremental nor collective matrix structuring "
+      "appears to be available");
 
 
-  /* If collective structuring is the user preference, or if incremental
-   * structuring is not supported, do collective structuring */
-  if (false /* (icmf==0 || !matrixEliminatesRepeatedCols()) && ccmf != 0 */)
-  {
-    Tabs tab1;
-    SUNDANCE_MSG2(verb, tab1 << "Assembler: doing collective matrix structuring...");
-    Array<int> graphData;
-    Array<int> nnzPerRow;
-    Array<int> rowPtrs;
+    /* If collective structuring is the user preference, or if incremental
+     * structuring is not supported, do collective structuring */
+    if (false /* (icmf==0 || !matrixEliminatesRepeatedCols()) && ccmf != 0 */)
+    {
+      Tabs tab1;
+      SUNDANCE_MSG2(verb, tab1 << "Assembler: doing collective matrix structuring...");
+      Array<int> graphData;
+      Array<int> nnzPerRow;
+      Array<int> rowPtrs;
       
-    using Teuchos::createVector;
+      using Teuchos::createVector;
 
-    getGraph(br, bc, graphData, rowPtrs, nnzPerRow);
-    ccmf->configure(lowestRow_[br], createVector(rowPtrs), createVector(nnzPerRow), createVector(graphData));
-  }
-  else
-  {
-    Tabs tab1;
-    SUNDANCE_MSG2(verb, tab1 << "Assembler: doing incremental matrix structuring...");
-    incrementalGetGraph(br, bc, icmf);
+      getGraph(br, bc, graphData, rowPtrs, nnzPerRow);
+      ccmf->configure(lowestRow_[br], createVector(rowPtrs), createVector(nnzPerRow), createVector(graphData));
+    }
+    else
     {
-      TimeMonitor timer1(matFinalizeTimer());
-      icmf->finalize();
+      Tabs tab1;
+      SUNDANCE_MSG2(verb, tab1 << "Assembler: doing incremental matrix structuring...");
+      incrementalGetGraph(br, bc, icmf);
+      {
+        TimeMonitor timer1(matFinalizeTimer());
+        icmf->finalize();
+      }
     }
+    MatrixGraphCache::insert(key, matFactory);
   }
+  graphFactories_.append(matFactory);
   
   SUNDANCE_MSG3(verb, tab << "Assembler: allocating matrix...");
   {
@@ -958,6 +985,76 @@ void Assembler::configureMatrixBlock(int br, int bc,
   }
 }
 
+MatrixGraphKey Assembler::graphKey(int br, int bc) const 
+{
+  Array<int> sig;
+  Array<CellFilter> regions;
+
+  /* global switches affecting the DOF maps */
+  sig.append(partitionBCs_);
+  sig.append(DOFMapBuilder::allowNodalMap());
+  sig.append(DOFMapBase::useRCMRenumbering());
+
+  /* layout of the row and column maps */
+  sig.append(rowMap_[br]->numDOFs());
+  sig.append(rowMap_[br]->lowestLocalDOF());
+  sig.append(rowMap_[br]->numLocalDOFs());
+  sig.append(colMap_[bc]->numDOFs());
+  sig.append(colMap_[bc]->lowestLocalDOF());
+  sig.append(colMap_[bc]->numLocalDOFs());
+
+  /* the functions in this block */
+  sig.append(eqn_->numVarIDs(br));
+  for (int i=0; i<eqn_->numVarIDs(br); i++) 
+    sig.append(eqn_->unreducedVarID(br, i));
+  sig.append(eqn_->numUnkIDs(bc));
+  for (int i=0; i<eqn_->numUnkIDs(bc); i++) 
+    sig.append(eqn_->unreducedUnkID(bc, i));
+
+  /* where the functions live, and how they're coupled */
+  for (int d=0; d<eqn_->numRegions(); d++)
+  {
+    CellFilter domain = eqn_->region(d);
+    regions.append(domain);
+    sig.append(eqn_->isBCRegion(d));
+
+    Array<int> vars = eqn_->reducedVarsOnRegion(domain)[br].elements();
+    Array<int> unks = eqn_->reducedUnksOnRegion(domain)[bc].elements();
+    sig.append(vars.size());
+    for (int i=0; i<vars.size(); i++) sig.append(vars[i]);
+    sig.append(unks.size());
+    for (int i=0; i<unks.size(); i++) sig.append(unks[i]);
+
+    for (int isBC=0; isBC<2; isBC++)
+    {
+      RCP<Set<OrderedPair<int, int> > > pairs;
+      if (isBC && eqn_->isBCRegion(d) && eqn_->hasBCVarUnkPairs(domain)) 
+        pairs = eqn_->bcVarUnkPairs(domain);
+      if (!isBC && eqn_->hasVarUnkPairs(domain)) 
+        pairs = eqn_->varUnkPairs(domain);
+
+      Array<int> blockPairs;
+      if (pairs.get() != 0)
+      {
+        Set<OrderedPair<int, int> >::const_iterator i;
+        for (i=pairs->begin(); i!=pairs->end(); i++)
+        {
+          if (eqn_->blockForVarID(i->first()) != br) continue;
+          if (eqn_->blockForUnkID(i->second()) != bc) continue;
+          blockPairs.append(i->first());
+          blockPairs.append(i->second());
+        }
+      }
+      sig.append(blockPairs.size());
+      for (int i=0; i<blockPairs.size(); i++) sig.append(blockPairs[i]);
+    }
+  }
+
+  return MatrixGraphKey(mesh_.id(), rowVecType_[br].description(), 
+    sig, regions);
+}
+
+
 Playa::LinearOperator<double> Assembler::allocateMatrix() const
 {
   LinearOperator<double> A;
@@ -1026,6 +1123,31 @@ void Assembler::assemblyLoop(const ComputationType& compType,
   /* Create an object in which to store local integration results */
   RCP<Array<double> > localValues = rcp(new Array<double>());
 
+  /* Create the context object that holds the transformation matrices and
+   * integration workspace for the current workset. Each call to the assembly
+   * loop has its own context, so that integration state is never shared 
+   * between assemblies. */
+  IntegrationContext intCtx;
+
+  /* If threaded integration has been requested, create an integration
+   * context for each thread and a buffer for the results of each 
+   * integral group. The Teuchos timers are shared by the whole process,
+   * so the per-thread contexts do not update them. Teuchos debug builds 
+   * keep reference-counted views of arrays, so those always run with 
+   * a single thread. */
+  int nThreads = std::max(1, numAssemblyThreads());
+#if !defined(_OPENMP) || defined(TEUCHOS_DEBUG)
+  nThreads = 1;
+#endif
+  Array<RCP<IntegrationContext> > threadCtx(nThreads);
+  for (int t=0; t<nThreads; t++)
+  {
+    threadCtx[t] = rcp(new IntegrationContext());
+    threadCtx[t]->setTimersEnabled(false);
+  }
+  Array<RCP<Array<double> > > groupValues;
+  Array<int> groupIsNonzero;
+
   /* Get the symbolic specification of the current computation.
    * The "context" is simply a unique ID used to distinguish different
    * settings in which evaluation might be made. The same expression might be
@@ -1135,6 +1257,21 @@ void Assembler::assemblyLoop(const ComputationType& compType,
       continue;
     }
 
+    /* Skip RQCs none of whose integral groups is wanted by the kernel,
+     * such as RQCs with only one-forms in a matrix-free apply. */
+    bool anyGroupNeeded = false;
+    for (int g=0; g<groups[r].size() && !anyGroupNeeded; g++)
+    {
+      anyGroupNeeded = kernel->needsGroup(*(groups[r][g]));
+    }
+    if (!anyGroupNeeded)
+    {
+      Tabs tab012;
+      SUNDANCE_MSG2(rqcVerb, tab012 << "no integral groups needed by the "
+        "assembly kernel");
+      continue;
+    }
+
     /* specify the evaluation mediator for this RQC.
      * Recall that the evaluation mediator is the object responsible for communication
      * between the symbolic expression tree and discretization-dependent data structures
@@ -1215,7 +1352,30 @@ void Assembler::assemblyLoop(const ComputationType& compType,
 
     /* Loop over cells in batches of the work set size.
      * At present, we're accumulating cell indices into an array. That would
-     * need to be changed to work with Peano. */
+     * need to be changed to work with Peano.
+     *
+     * Worksets are processed one after another, because the mediator,
+     * the evaluation manager with its TempStack, and the result caches
+     * held by the Evaluator objects in the expression DAG all hold the
+     * state of a single workset. Within a workset, the integral groups 
+     * can be evaluated by several threads; see below. This only helps 
+     * when a region has several groups: the parallelism is bounded by
+     * the number of groups, not by the number of cells. Watched regions
+     * and curve integrals, whose integrals update the quadrature points
+     * cell by cell, are always integrated by a single thread. */
+    bool useThreads = nThreads > 1 && groups[r].size() > 1
+      && !rqc_[r].watch().isActive()
+      && dynamic_cast<const CurveEvalMediator*>(mediators_[r].get()) == 0;
+    if (useThreads)
+    {
+      groupValues.resize(groups[r].size());
+      groupIsNonzero.resize(groups[r].size());
+      for (int g=0; g<groupValues.size(); g++) 
+      {
+        if (groupValues[g].get()==0) groupValues[g] = rcp(new Array<double>());
+      }
+    }
+
     CellIterator iter=cells.begin();
     int workSetCounter = 0;
     int myRank = mesh_.comm().getRank();
@@ -1229,15 +1389,16 @@ void Assembler::assemblyLoop(const ComputationType& compType,
        * workset array and the isLocalFlag array. Note that the reserve()
        * method has been called previously, so that as we append cells
        * to the array, no memory allocation is done (unless we run over 
-       * the reserved size). */
+       * the reserved size). The cells are copied as a block when the
+       * cell set is stored contiguously. */
       workSet->resize(0);
       isLocalFlag->resize(0);
-      for (int c=0; c<workSetSize() && iter != cells.end(); c++, iter++)
+      iter.appendBlock(cells.end(), workSetSize(), *workSet);
+      for (int c=0; c<workSet->size(); c++)
       {
-        workSet->append(*iter);
         /* we need the isLocalFlag values so that we can ignore contributions
          * to zero-forms from off-processor elements */
-        isLocalFlag->append(myRank==mesh_.ownerProcID(cellDim, *iter));
+        isLocalFlag->append(myRank==mesh_.ownerProcID(cellDim, (*workSet)[c]));
       }
       /* The work set has now been accumulated */
       SUNDANCE_MSG2(rqcVerb,
@@ -1325,16 +1486,60 @@ void Assembler::assemblyLoop(const ComputationType& compType,
       /* ---- Do the element integrals and insertions ------ */
 
       /* The matrices used to transform integrals are built upon first use by 
-       * this workset, then cached because they may be needed for several 
-       * integrals on the same workset. As we're now in a new workset with
-       * new cells, they should be rebuilt if needed. This step informs all integrals
-       * that the cache is out of date. 
-       *
-       * Todo: this uses a static function that contains static data (via the "Meyers
-       * trick") and so is not thread-safe. If we want to do multithreaded parallelism
-       * for multicore architectures, this implementation will need to be changed.
+       * this workset, then cached in the integration context because they may 
+       * be needed for several integrals on the same workset. As we're now in a 
+       * new workset with new cells, they should be rebuilt if needed. This step 
+       * marks the cached matrices as out of date. 
        */ 
-      ElementIntegral::invalidateTransformationMatrices();
+      intCtx.invalidateTransformationMatrices();
+
+      /* If threads are in use, evaluate all integral groups concurrently,
+       * each thread with its own integration context and each group 
+       * into its own buffer. The Jacobian inverses are computed beforehand
+       * so that the Jacobian batches are only read by the threads. The 
+       * transformations and the fill are then done in group order by
+       * the loop below, exactly as in serial assembly, so the results
+       * are identical to serial assembly. */
+      if (useThreads)
+      {
+        TimeMonitor threadedTM(threadedIntegrationTimer());
+        JVol.precomputeInverses();
+        JTrans.precomputeInverses();
+        for (int t=0; t<nThreads; t++) 
+        {
+          threadCtx[t]->invalidateTransformationMatrices();
+        }
+
+        int nGroups = groups[r].size();
+        std::string errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+        for (int g=0; g<nGroups; g++)
+        {
+          int t = 0;
+#ifdef _OPENMP
+          t = omp_get_thread_num();
+#endif
+          groupIsNonzero[g] = false;
+          if (!kernel->needsGroup(*(groups[r][g]))) continue;
+          try
+          {
+            groupIsNonzero[g] = groups[r][g]->evaluate(*(threadCtx[t]), 
+              JTrans, JVol, *isLocalFlag, facetIndices, workSet,
+              vectorCoeffs, constantCoeffs, groupValues[g]);
+          }
+          catch(std::exception& exc)
+          {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            errMsg = exc.what();
+          }
+        }
+        TEUCHOS_TEST_FOR_EXCEPTION(errMsg.size() > 0, std::runtime_error,
+          "exception detected during threaded integration: " << errMsg);
+      }
       
       /* Loop over the integral groups */
       SUNDANCE_MSG2(rqcVerb, tab1 << "----- looping over integral groups");
@@ -1346,19 +1551,27 @@ void Assembler::assemblyLoop(const ComputationType& compType,
           << groups[r].size() );
 
         /* Do the integrals. The integration results will be written into
-         * the array "localValues". */
+         * the array "values". If threads are in use, they have already 
+         * been written into the group's own buffer. */
         const RCP<IntegralGroup>& group = groups[r][g];
-        if (!group->evaluate(JTrans, JVol, *isLocalFlag, facetIndices, workSet,
-            vectorCoeffs, constantCoeffs, localValues)) continue;
+        RCP<Array<double> >& values 
+          = useThreads ? groupValues[g] : localValues;
+        if (!kernel->needsGroup(*group)) continue;
+        if (useThreads)
+        {
+          if (!groupIsNonzero[g]) continue;
+        }
+        else if (!group->evaluate(intCtx, JTrans, JVol, *isLocalFlag, facetIndices, workSet,
+            vectorCoeffs, constantCoeffs, values)) continue;
 
         /* Here we call the transformation object, if they are not needed
          * (the function might be one return) there would be no operation
          * done to the array of local stiffness matrix
          * Do the actual transformation (transformations for Matrix)*/
         transformations[r][g]->applyTransformsToAssembly(
-        		g , (localValues->size() / workSet->size()),
+        		g , (values->size() / workSet->size()),
                 cellType, cellDim , maxCellType,
-        		JTrans, JVol, facetIndices, workSet, localValues);
+        		JTrans, JVol, facetIndices, workSet, values);
 
         /* add the integration results into the output objects by a call
          * to the kernel's fill() function. We need to pass isBCRqc to the kernel
@@ -1369,7 +1582,7 @@ void Assembler::assemblyLoop(const ComputationType& compType,
          * batch of integrals. */
         {
           TimeMonitor fillTM(fillTimer());
-          kernel->fill(isBCRqc_[r], *group, localValues);
+          kernel->fill(isBCRqc_[r], *group, values);
         }
       }
       SUNDANCE_MSG2(rqcVerb, tab1 << "----- done looping over integral groups");
@@ -1500,6 +1713,44 @@ void Assembler::assemble(Array<Vector<double> >& mv) const
 }
 
 
+/* ------------  apply the operator without forming it ---- */
+
+void Assembler::applyMatrixFree(const Vector<double>& x, 
+  Vector<double>& y) const 
+{
+  Tabs tab;
+  TimeMonitor timer(matrixFreeApplyTimer());
+
+  int verb = 0;
+  if (eqn_->hasActiveWatchFlag()) verb = max(verb, 1);
+
+  SUNDANCE_BANNER1(verb, tab, "Matrix-free operator apply");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!contexts_.containsKey(MatrixAndVector),
+    std::runtime_error,
+    "Assembler::applyMatrixFree() called for an assembler that "
+    "does not support matrix/vector assembly");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(partitionBCs_, std::runtime_error,
+    "Assembler::applyMatrixFree() does not support partitioned BCs");
+
+  Array<Vector<double> > mv(1);
+  configureVector(mv);
+
+  RCP<AssemblyKernelBase> kernel 
+    = rcp(new MatrixFreeApplyKernel(
+            rowMap_, isBCRow_, lowestRow_,
+            colMap_, isBCCol_, lowestCol_,
+            privateColSpace_, x, mv, verb));
+
+  assemblyLoop(MatrixAndVector, kernel);
+
+  y.acceptCopyOf(mv[0]);
+
+  SUNDANCE_MSG1(verb, tab << "Assembler: done matrix-free apply");
+}
+
+
 /* ------------  evaluate a functional and its gradient ---- */
 
 void Assembler::evaluate(double& value, Array<Vector<double> >& gradient) const 
@@ -1576,262 +1827,21 @@ void Assembler::getGraph(int br, int bc,
   Tabs tab;
   int verb = eqn_->maxWatchFlagSetting("matrix config");
 
-
-  RCP<Array<int> > workSet = rcp(new Array<int>());
-  workSet->reserve(workSetSize());
-
-  RCP<Array<Array<int> > > testLocalDOFs 
-    = rcp(new Array<Array<int> >());
-
-  RCP<Array<Array<int> > > unkLocalDOFs
-    = rcp(new Array<Array<int> >());
-
-  SUNDANCE_MSG3(verb, tab << "Creating graph: there are " 
-    << rowMap_[br]->numLocalDOFs()
-    << " local equations");
-
-
-  Array<Set<int> > tmpGraph;
-  tmpGraph.resize(rowMap_[br]->numLocalDOFs());
-
+  MatrixGraphBuilder graph(lowestRow_[br], rowMap_[br]->numLocalDOFs());
   {
     TimeMonitor timer2(colSearchTimer());
-    for (int d=0; d<eqn_->numRegions(); d++)
-    {
-      Tabs tab0;
-      CellFilter domain = eqn_->region(d);
-      const Array<Set<int> >& requiredVars = eqn_->reducedVarsOnRegion(domain);
-      const Array<Set<int> >& requiredUnks = eqn_->reducedUnksOnRegion(domain);
-      SUNDANCE_MSG2(verb,
-        tab0 << "cell set " << domain
-        << " isBCRegion=" << eqn_->isBCRegion(d));
-      int dim = domain.dimension(mesh_);
-      CellSet cells = domain.getCells(mesh_);
-
-      RCP<Set<OrderedPair<int, int> > > pairs ;
-      if (eqn_->hasVarUnkPairs(domain)) pairs = eqn_->varUnkPairs(domain);
-
-      SUNDANCE_OUT(verb > 2 && pairs.get() != 0, 
-        tab0 << "non-BC pairs = "
-        << *pairs);
-       
-      RCP<Set<OrderedPair<int, int> > > bcPairs ;
-      if (eqn_->isBCRegion(d))
-      {
-        if (eqn_->hasBCVarUnkPairs(domain)) 
-        {
-          bcPairs = eqn_->bcVarUnkPairs(domain);
-          SUNDANCE_OUT(verb > 2, tab0 << "BC pairs = "
-            << *bcPairs);
-        }
-      }
-      Array<Set<int> > unksForTestsSet(eqn_->numVarIDs(bc));
-      Array<Set<int> > bcUnksForTestsSet(eqn_->numVarIDs(bc));
-
-      Set<OrderedPair<int, int> >::const_iterator i;
-      
-      if (pairs.get() != 0)
-      {
-        for (i=pairs->begin(); i!=pairs->end(); i++)
-        {
-          const OrderedPair<int, int>& p = *i;
-          int t = p.first();
-          int u = p.second();
-
-          TEUCHOS_TEST_FOR_EXCEPTION(!eqn_->hasVarID(t), std::logic_error,
-            "Test function ID " << t << " does not appear "
-            "in equation set");
-          TEUCHOS_TEST_FOR_EXCEPTION(!eqn_->hasUnkID(u), std::logic_error,
-            "Unk function ID " << u << " does not appear "
-            "in equation set");
-
-          if (eqn_->blockForVarID(t) != br) continue;
-          if (eqn_->blockForUnkID(u) != bc) continue;
-
-          unksForTestsSet[eqn_->reducedVarID(t)].put(eqn_->reducedUnkID(u));
-        }
-      }
-      if (bcPairs.get() != 0)
-      {
-        for (i=bcPairs->begin(); i!=bcPairs->end(); i++)
-        {
-          const OrderedPair<int, int>& p = *i;
-          int t = p.first();
-          int u = p.second();
-
-          if (eqn_->blockForVarID(t) != br) continue;
-          if (eqn_->blockForUnkID(u) != bc) continue;
-
-          TEUCHOS_TEST_FOR_EXCEPTION(!eqn_->hasVarID(t), std::logic_error,
-            "Test function ID " << t << " does not appear "
-            "in equation set");
-          TEUCHOS_TEST_FOR_EXCEPTION(!eqn_->hasUnkID(u), std::logic_error,
-            "Unk function ID " << u << " does not appear "
-            "in equation set");
-          bcUnksForTestsSet[eqn_->reducedVarID(t)].put(eqn_->reducedUnkID(u));
-        }
-      }
-
-      Array<Array<int> > unksForTests(unksForTestsSet.size());
-      Array<Array<int> > bcUnksForTests(bcUnksForTestsSet.size());
-
-      for (int t=0; t<unksForTests.size(); t++)
-      {
-        unksForTests[t] = unksForTestsSet[t].elements();
-        bcUnksForTests[t] = bcUnksForTestsSet[t].elements();
-      }
-      
-      Array<int> numTestNodes;
-      Array<int> numUnkNodes;
-
-      
-
-      int highestRow = lowestRow_[br] + rowMap_[br]->numLocalDOFs();
-
-      int nt = eqn_->numVarIDs(br);
-
-      CellIterator iter=cells.begin();
-      while (iter != cells.end())
-      {
-        /* build a work set */
-        workSet->resize(0);
-        for (int c=0; c<workSetSize() && iter != cells.end(); c++, iter++)
-        {
-          workSet->append(*iter);
-        }
-
-        int nCells = workSet->size();
-
-        RCP<const MapStructure> colMapStruct; 
-        RCP<const MapStructure> rowMapStruct 
-          = rowMap_[br]->getDOFsForCellBatch(dim, *workSet, 
-            requiredVars[br], *testLocalDOFs,
-            numTestNodes, verb);
-        if (rowMap_[br].get()==colMap_[bc].get())
-        {
-          unkLocalDOFs = testLocalDOFs;
-          numUnkNodes = numTestNodes;
-          colMapStruct = rowMapStruct;
-        }
-        else
-        {
-          colMapStruct = colMap_[br]->getDOFsForCellBatch(dim, *workSet, 
-            requiredUnks[bc], 
-            *unkLocalDOFs, numUnkNodes, verb);
-        }
-
-        if (pairs.get() != 0)
-        {
-          for (int c=0; c<nCells; c++)
-          {
-            for (int t=0; t<nt; t++)
-            {
-              int tChunk = rowMapStruct->chunkForFuncID(t);
-              int nTestFuncs = rowMapStruct->numFuncs(tChunk);
-              int testFuncIndex = rowMapStruct->indexForFuncID(t);
-              int nTestNodes = numTestNodes[tChunk];
-              const Array<int>& testDOFs = (*testLocalDOFs)[tChunk];
-              for (int uit=0; uit<unksForTests[t].size(); uit++)
-              {
-                Tabs tab2;
-                int u = unksForTests[t][uit];
-                int uChunk = colMapStruct->chunkForFuncID(u);
-                int nUnkFuncs = colMapStruct->numFuncs(uChunk);
-                int unkFuncIndex = colMapStruct->indexForFuncID(u);
-                const Array<int>& unkDOFs = (*unkLocalDOFs)[uChunk];
-                int nUnkNodes = numUnkNodes[uChunk];
-                for (int n=0; n<nTestNodes; n++)
-                {
-                  int row
-                    = testDOFs[(c*nTestFuncs + testFuncIndex)*nTestNodes + n];
-                  if (row < lowestRow_[br] || row >= highestRow
-                    || (*(isBCRow_[br]))[row-lowestRow_[br]]) continue;
-                  Set<int>& colSet = tmpGraph[row-lowestRow_[br]];
-                  for (int m=0; m<nUnkNodes; m++)
-                  {
-                    int col 
-                      = unkDOFs[(c*nUnkFuncs + unkFuncIndex)*nUnkNodes + m];
-                    colSet.put(col);
-                  }
-                }
-              }
-            }
-          }
-        }
-        if (bcPairs.get() != 0)
-        {
-          for (int c=0; c<nCells; c++)
-          {
-            for (int t=0; t<nt; t++)
-            {
-              int tChunk = rowMapStruct->chunkForFuncID(t);
-              int nTestFuncs = rowMapStruct->numFuncs(tChunk);
-              int testFuncIndex = rowMapStruct->indexForFuncID(t);
-              int nTestNodes = numTestNodes[tChunk];
-              const Array<int>& testDOFs = (*testLocalDOFs)[tChunk];
-              for (int uit=0; uit<bcUnksForTests[t].size(); uit++)
-              {
-                Tabs tab2;
-                int u = bcUnksForTests[t][uit];
-                int uChunk = colMapStruct->chunkForFuncID(u);
-                int nUnkFuncs = colMapStruct->numFuncs(uChunk);
-                int unkFuncIndex = colMapStruct->indexForFuncID(u);
-                const Array<int>& unkDOFs = (*unkLocalDOFs)[uChunk];
-                int nUnkNodes = numUnkNodes[uChunk];
-                for (int n=0; n<nTestNodes; n++)
-                {
-                  int row
-                    = testDOFs[(c*nTestFuncs + testFuncIndex)*nTestNodes + n];
-                  if (row < lowestRow_[br] || row >= highestRow
-                    || !(*(isBCRow_[br]))[row-lowestRow_[br]]) continue;
-                  Set<int>& colSet = tmpGraph[row-lowestRow_[br]];
-                  for (int m=0; m<nUnkNodes; m++)
-                  {
-                    int col 
-                      = unkDOFs[(c*nUnkFuncs + unkFuncIndex)*nUnkNodes + m];
-                    colSet.put(col);
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
-    }
+    collectGraph(br, bc, graph);
   }
-
   
   {
     TimeMonitor t2(graphFlatteningTimer());
-    int nLocalRows = rowMap_[br]->numLocalDOFs();
-
-    int nnz = 0;
-    rowPtrs.resize(nLocalRows);
-    nnzPerRow.resize(rowMap_[br]->numLocalDOFs());
-    for (int i=0; i<nLocalRows; i++) 
-    {
-      rowPtrs[i] = nnz;
-      nnzPerRow[i] = tmpGraph[i].size();
-      nnz += nnzPerRow[i];
-    }
-
-    graphData.resize(nnz);
-    int* base = &(graphData[0]);
-    for (int i=0; i<nLocalRows; i++)
-    {
-      //        tmpGraph[i].fillArray(base + rowPtrs[i]);
-      int* rowBase = base + rowPtrs[i];
-      const Set<int>& rowSet = tmpGraph[i];
-      int k = 0;
-      for (Set<int>::const_iterator 
-             j=rowSet.begin(); j != rowSet.end(); j++, k++)
-      {
-        rowBase[k] = *j;
-      }
-    }
+    graph.getGraph(graphData, rowPtrs, nnzPerRow);
   }
-
+  SUNDANCE_MSG1(verb, tab << "matrix graph has " << graphData.size()
+    << " nonzeros, peak graph memory = " << graph.peakBytes() << " bytes");
 }
+
+
 /* ------------  get the nonzero pattern for the matrix ------------- */
                        
                        
@@ -1843,6 +1853,34 @@ void Assembler
   Tabs tab;
   int verb = eqn_->maxWatchFlagSetting("matrix config");
 
+  MatrixGraphBuilder graph(lowestRow_[br], rowMap_[br]->numLocalDOFs());
+  {
+    TimeMonitor timer2(colSearchTimer());
+    collectGraph(br, bc, graph);
+  }
+
+  /* each row is now sorted and duplicate-free, so it can be handed to
+   * the matrix factory in a single call */
+  {
+    TimeMonitor t2(graphFlatteningTimer());
+    for (int r=0; r<graph.numRows(); r++)
+    {
+      int nnz;
+      const int* cols = graph.row(r, nnz);
+      if (nnz > 0) icmf->initializeNonzerosInRow(lowestRow_[br] + r, nnz, cols);
+    }
+  }
+  SUNDANCE_MSG1(verb, tab << "peak graph memory = " 
+    << graph.peakBytes() << " bytes");
+}
+
+
+void Assembler::collectGraph(int br, int bc, 
+  MatrixGraphBuilder& graph) const 
+{
+  Tabs tab;
+  int verb = eqn_->maxWatchFlagSetting("matrix config");
+
   RCP<Array<int> > workSet = rcp(new Array<int>());
   workSet->reserve(workSetSize());
 
@@ -1956,10 +1994,7 @@ void Assembler
     {
       /* build a work set */
       workSet->resize(0);
-      for (int c=0; c<workSetSize() && iter != cells.end(); c++, iter++)
-      {
-        workSet->append(*iter);
-      }
+      iter.appendBlock(cells.end(), workSetSize(), *workSet);
 
       int nCells = workSet->size();
 
@@ -2012,7 +2047,7 @@ void Assembler
                 if (row < lowestRow_[br] || row >= highestRow
                   || (*(isBCRow_[br]))[row-lowestRow_[br]]) continue;
                 const int* colPtr = &(unkDOFs[(c*nUnkFuncs + unkFuncIndex)*nUnkNodes]);
-                icmf->initializeNonzerosInRow(row, nUnkNodes, colPtr);
+                graph.addToRow(row, nUnkNodes, colPtr);
               }
             }
           }
@@ -2047,7 +2082,7 @@ void Assembler
                   || !(*(isBCRow_[br]))[row-lowestRow_[br]]) continue;
 
                 const int* colPtr = &(unkDOFs[(c*nUnkFuncs + unkFuncIndex)*nUnkNodes]);
-                icmf->initializeNonzerosInRow(row, nUnkNodes, colPtr);
+                graph.addToRow(row, nUnkNodes, colPtr);
               }
             }
           }
@@ -2185,6 +2220,12 @@ int& Assembler::workSetSize()
   return rtn;
 }
 
+int& Assembler::numAssemblyThreads()
+{
+  static int rtn = 1; 
+  return rtn;
+}
+
 int Assembler::maxWatchFlagSetting(const std::string& name) const 
 {
   return eqnSet()->maxWatchFlagSetting(name);
@@ -52,6 +52,7 @@
 #include "Teuchos_ParameterList.hpp"
 #include "PlayaIncrementallyConfigurableMatrixFactory.hpp"
 #include "PlayaCollectivelyConfigurableMatrixFactory.hpp"
+#include "PlayaMatrixFactory.hpp"
 #include "SundanceRegionQuadCombo.hpp"
 #include "SundanceMesh.hpp"
 #include "SundanceEvalContext.hpp"
@@ -75,6 +76,8 @@ class DOFMapBase;
 class IntegralGroup;
 class StdFwkEvalMediator;
 class AssemblyKernelBase;
+class MatrixGraphBuilder;
+class MatrixGraphKey;
 
 typedef std::set<int> ColSetType;
 
@@ -138,6 +141,13 @@ public:
   /** */
   void assemble(Array<Vector<double> >& b) const ;
 
+  /** 
+   * Compute \f$y=Ax\f$ without forming the matrix \f$A\f$. The element
+   * matrices are recomputed on each call and applied cell by cell
+   * to the local values of \f$x\f$. 
+   */
+  void applyMatrixFree(const Vector<double>& x, Vector<double>& y) const ;
+
   /** */
   void evaluate(double& value,
     Array<Vector<double> >& gradient) const ;
@@ -148,6 +158,20 @@ public:
   /** */
   static int& workSetSize() ;
 
+  /** 
+   * Number of threads used to evaluate the integral groups of a 
+   * workset. The default is one. Larger values take effect only when 
+   * Sundance is built with OpenMP. The results are identical to those
+   * of single-threaded assembly.
+   *
+   * This is a partial step towards threaded assembly: worksets are still
+   * processed one at a time, and only the integral groups within a 
+   * workset run concurrently. A region with a single integral group, 
+   * such as a scalar Poisson operator, gains nothing, and a region with
+   * a few groups keeps at most that many threads busy.
+   */
+  static int& numAssemblyThreads() ;
+
       
   /** */
   void getGraph(int br, int bc,
@@ -198,6 +222,14 @@ public:
         = TimeMonitor::getNewTimer("matrix/vector fill"); 
       return *rtn;
     }
+
+  /** */
+  static Time& matrixFreeApplyTimer() 
+    {
+      static RCP<Time> rtn 
+        = TimeMonitor::getNewTimer("matrix-free apply"); 
+      return *rtn;
+    }
   
 
 private:
@@ -236,6 +268,12 @@ private:
   /** */
   void configureVectorBlock(int br, Vector<double>& b) const ;
 
+  /** Collect the nonzeros of matrix block (br, bc) into a builder */
+  void collectGraph(int br, int bc, MatrixGraphBuilder& graph) const ;
+
+  /** Key identifying the graph of matrix block (br, bc) */
+  MatrixGraphKey graphKey(int br, int bc) const ;
+
   /** */
   Array<Array<int> > findNonzeroBlocks() const ;
 
@@ -316,6 +354,10 @@ private:
   /** Cached reference to the previously assembled matrix
    *  A null value signals that matrix must be assembled */
   mutable LinearOperator<double> cachedAssembledMatrix_;
+
+  /** Matrix factories holding the graphs of the configured matrix 
+   * blocks. Keeping them here keeps shared graph cache entries alive. */
+  mutable Array<RCP<MatrixFactory<double> > > graphFactories_;
 };
 
 }
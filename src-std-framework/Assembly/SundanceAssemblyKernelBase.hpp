@@ -121,6 +121,13 @@ public:
     const IntegralGroup& group,
     const RCP<Array<double> >& localValues) = 0 ;  
 
+  /** 
+   * Whether fill() makes any use of the results of the given integral
+   * group. The assembly loop neither integrates nor fills groups for
+   * which this is false. The default implementation returns true.
+   */
+  virtual bool needsGroup(const IntegralGroup& group) const {return true;}
+
   /** 
    * Hook to do any finalization steps after the main assembly loop, 
    * for example, doing an all-reduce on locally computed functional values. 
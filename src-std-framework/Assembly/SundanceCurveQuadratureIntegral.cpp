@@ -338,7 +338,8 @@ void CurveQuadratureIntegral::updateRefCellIntegralTwoForm(int maxCellLID , int
 }
 
 void CurveQuadratureIntegral
-::transformZeroForm(const CellJacobianBatch& JTrans,  
+::transformZeroForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag,
   const Array<int>& facetIndex,
@@ -432,7 +433,8 @@ void CurveQuadratureIntegral
 }
 
 
-void CurveQuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans,
+void CurveQuadratureIntegral::transformOneForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
@@ -515,21 +517,22 @@ void CurveQuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans,
   {
     /* If the derivative order is nonzero, then we have to do a transformation. */
     
-    createOneFormTransformationMatrix(JTrans, JVol);
+    createOneFormTransformationMatrix(ctx, JTrans, JVol);
     
     SUNDANCE_MSG4(transformVerb(), 
-      Tabs() << "transformation matrix=" << G(alpha()));
+      Tabs() << "transformation matrix=" << ctx.G(alpha()));
     
-    double* GPtr = &(G(alpha())[0]);      
+    double* GPtr = &(ctx.G(alpha())[0]);      
     
-    transformSummingFirst(JVol.numCells(), JVol ,facetIndex, cellLIDs, constCoeff , GPtr, coeff, A);
+    transformSummingFirst(ctx, JVol.numCells(), JVol ,facetIndex, cellLIDs, constCoeff , GPtr, coeff, A);
 
   }
   addFlops(flops);
 }
 
 
-void CurveQuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
+void CurveQuadratureIntegral::transformTwoForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
@@ -587,36 +590,37 @@ void CurveQuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
   }
   else
   {
-    createTwoFormTransformationMatrix(JTrans, JVol);
+    createTwoFormTransformationMatrix(ctx, JTrans, JVol);
     double* GPtr;
 
     if (testDerivOrder() == 0)
     {
-      GPtr = &(G(beta())[0]);
+      GPtr = &(ctx.G(beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(beta()));
+        Tabs() << "transformation matrix=" << ctx.G(beta()));
     }
     else if (unkDerivOrder() == 0)
     {
-      GPtr = &(G(alpha())[0]);
+      GPtr = &(ctx.G(alpha())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(alpha()));
+        Tabs() << "transformation matrix=" << ctx.G(alpha()));
     }
     else
     {
-      GPtr = &(G(alpha(), beta())[0]);
+      GPtr = &(ctx.G(alpha(), beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
         Tabs() << "transformation matrix=" 
-        << G(alpha(),beta()));
+        << ctx.G(alpha(),beta()));
     }
         
-    transformSummingFirst(JTrans.numCells(), JVol , facetIndex, cellLIDs, constCoeff , GPtr, coeff, A);
+    transformSummingFirst(ctx, JTrans.numCells(), JVol , facetIndex, cellLIDs, constCoeff , GPtr, coeff, A);
 
   }
 }
 
 void CurveQuadratureIntegral
-::transformSummingFirst(int nCells,
+::transformSummingFirst(IntegrationContext& ctx,
+  int nCells,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
@@ -647,7 +651,7 @@ void CurveQuadratureIntegral
   }
 
   /* The sum workspace is used to store the sum of untransformed quantities */
-  static Array<double> sumWorkspace;
+  Array<double>& sumWorkspace = ctx.sumWorkspace();
 
   int swSize = transSize * nNodes();
   sumWorkspace.resize(swSize);
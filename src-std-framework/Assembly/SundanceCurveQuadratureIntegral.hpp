@@ -96,7 +96,8 @@ public:
   virtual ~CurveQuadratureIntegral(){;}
       
      /** */
-  virtual void transform(const CellJacobianBatch& JTrans,
+  virtual void transform(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetNum,
@@ -105,13 +106,14 @@ public:
     const double* const coeff,
     RCP<Array<double> >& A) const 
     {
-      if (order()==2) transformTwoForm(JTrans, JVol, facetNum, cellLIDs, constCoeff, coeff, A);
-      else if (order()==1) transformOneForm(JTrans, JVol, facetNum, cellLIDs, constCoeff, coeff, A);
-      else transformZeroForm(JTrans, JVol, isLocalFlag, facetNum, cellLIDs, constCoeff, coeff, A);
+      if (order()==2) transformTwoForm(ctx, JTrans, JVol, facetNum, cellLIDs, constCoeff, coeff, A);
+      else if (order()==1) transformOneForm(ctx, JTrans, JVol, facetNum, cellLIDs, constCoeff, coeff, A);
+      else transformZeroForm(ctx, JTrans, JVol, isLocalFlag, facetNum, cellLIDs, constCoeff, coeff, A);
     }
 
   /** */
-  virtual void transformZeroForm(const CellJacobianBatch& JTrans,
+  virtual void transformZeroForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetIndex,
@@ -121,7 +123,8 @@ public:
     RCP<Array<double> >& A) const ;
   
   /** */
-  virtual void transformTwoForm(const CellJacobianBatch& JTrans,
+  virtual void transformTwoForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
@@ -130,7 +133,8 @@ public:
     RCP<Array<double> >& A) const ;
   
   /** */
-  void transformOneForm(const CellJacobianBatch& JTrans,
+  void transformOneForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
@@ -151,7 +155,8 @@ private:
 
   /** Do the integration by summing reference quantities over quadrature
    * points and then transforming the sum to physical quantities.  */
-  void transformSummingFirst(int nCells,
+  void transformSummingFirst(IntegrationContext& ctx,
+    int nCells,
 	const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
@@ -162,7 +167,8 @@ private:
 
   /** Do the integration by transforming to physical coordinates 
    * at each quadrature point, and then summing */
-  void transformSummingLast(int nCells,
+  void transformSummingLast(IntegrationContext& ctx,
+    int nCells,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
     const double* const GPtr,
@@ -348,48 +348,22 @@ void ElementIntegral::getQuad(const QuadratureFamily& quad,
     printQuad(Out::os(), quadPts, quadWeights);
   }
 }
-  
-
-
-Array<double>& ElementIntegral::G(int alpha)
-{
-  static Array<Array<double> > rtn(3);
 
-  return rtn[alpha];
-}
 
-Array<double>& ElementIntegral::G(int alpha, int beta)
+RCP<const BasisTabulation> ElementIntegral::tabulate(
+  const BasisFamily& basis, const QuadratureFamily& quad, int evalCase,
+  const SpatialDerivSpecifier& deriv) const 
 {
-  static Array<Array<double> > rtn(9);
-
-  return rtn[3*alpha + beta];
-}
-
-int& ElementIntegral::transformationMatrixIsValid(int alpha, int beta)
-{
-  static Array<int> rtn(9, false);
-  return rtn[3*alpha + beta];
-}
-
-int& ElementIntegral::transformationMatrixIsValid(int alpha)
-{
-  static Array<int> rtn(3, false);
-  return rtn[alpha];
-}
-
-void ElementIntegral::invalidateTransformationMatrices()
-{
-  for (int i=0; i<3; i++)
+  int dim = dimension(cellType());
+  if (nFacetCases()==1) 
   {
-    transformationMatrixIsValid(i) = false;
-    for (int j=0; j<3; j++)
-    {
-      transformationMatrixIsValid(i, j) = false;
-    }
+    return basis.tabulate(evalCellType(), quad, cellType(), dim, -1,
+      deriv, setupVerb());
   }
+  return basis.tabulate(evalCellType(), quad, maxCellType(), dim, 
+    evalCase, deriv, setupVerb());
 }
-
-
+  
 
 
 int ElementIntegral::ipow(int base, int power) 
@@ -400,31 +374,32 @@ int ElementIntegral::ipow(int base, int power)
 }
 
 void ElementIntegral
-::createTwoFormTransformationMatrix(const CellJacobianBatch& JTrans,
+::createTwoFormTransformationMatrix(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol) const
 {
-  TimeMonitor timer(transCreationTimer());
+  IntegrationTimeMonitor timer(transCreationTimer(), ctx);
   Tabs tab;
 
   int flops = 0;
 
   int maxDim = JTrans.cellDim();
   //int cellDim = JVol.cellDim();
+  Array<double>& invJ = ctx.invJWorkspace();
 
   if (testDerivOrder() == 1 && unkDerivOrder() == 1)
   {
     Tabs tab2;
-    if (transformationMatrixIsValid(alpha(), beta())) return;
-    transformationMatrixIsValid(alpha(), beta()) = true;
+    if (ctx.transformationMatrixIsValid(alpha(), beta())) return;
+    ctx.transformationMatrixIsValid(alpha(), beta()) = true;
 
-    G(alpha(), beta()).resize(JTrans.numCells() * JTrans.cellDim() * JTrans.cellDim());
+    ctx.G(alpha(), beta()).resize(JTrans.numCells() * JTrans.cellDim() * JTrans.cellDim());
 
-    double* GPtr = &(G(alpha(),beta())[0]);
+    double* GPtr = &(ctx.G(alpha(),beta())[0]);
     int k = 0;
 
     for (int c=0; c<JTrans.numCells(); c++)
     {
-      static Array<double> invJ;
       JTrans.getInvJ(c, invJ);
       double detJ = fabs(JVol.detJ()[c]);
       for (int gamma=0; gamma<maxDim; gamma++)
@@ -441,17 +416,16 @@ void ElementIntegral
 
   else if (testDerivOrder() == 1 && unkDerivOrder() == 0)
   {
-    if (transformationMatrixIsValid(alpha())) return;
-    transformationMatrixIsValid(alpha()) = true;
+    if (ctx.transformationMatrixIsValid(alpha())) return;
+    ctx.transformationMatrixIsValid(alpha()) = true;
 
-    G(alpha()).resize(JTrans.numCells() * JTrans.cellDim());
+    ctx.G(alpha()).resize(JTrans.numCells() * JTrans.cellDim());
 
     int k = 0;
-    double* GPtr = &(G(alpha())[0]);
+    double* GPtr = &(ctx.G(alpha())[0]);
 
     for (int c=0; c<JTrans.numCells(); c++)
     {
-      static Array<double> invJ;
       JTrans.getInvJ(c, invJ);
       double detJ = fabs(JVol.detJ()[c]);
       for (int gamma=0; gamma<maxDim; gamma++,k++)
@@ -464,17 +438,16 @@ void ElementIntegral
 
   else 
   {
-    if (transformationMatrixIsValid(beta())) return;
-    transformationMatrixIsValid(beta()) = true;
+    if (ctx.transformationMatrixIsValid(beta())) return;
+    ctx.transformationMatrixIsValid(beta()) = true;
 
-    G(beta()).resize(JTrans.numCells() * JTrans.cellDim());
+    ctx.G(beta()).resize(JTrans.numCells() * JTrans.cellDim());
 
     int k = 0;
-    double* GPtr = &(G(beta())[0]);
+    double* GPtr = &(ctx.G(beta())[0]);
 
     for (int c=0; c<JTrans.numCells(); c++)
     {
-      static Array<double> invJ;
       JTrans.getInvJ(c, invJ);
       double detJ = fabs(JVol.detJ()[c]);
       for (int gamma=0; gamma<maxDim; gamma++,k++)
@@ -490,29 +463,30 @@ void ElementIntegral
 
 
 void ElementIntegral
-::createOneFormTransformationMatrix(const CellJacobianBatch& JTrans,
+::createOneFormTransformationMatrix(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol) const 
 {
-  TimeMonitor timer(transCreationTimer());
+  IntegrationTimeMonitor timer(transCreationTimer(), ctx);
   Tabs tab;
   SUNDANCE_MSG2(transformVerb(), 
     tab << "ElementIntegral creating linear form trans matrices");
 
   int maxDim = JTrans.cellDim();
+  Array<double>& invJ = ctx.invJWorkspace();
 
-  if (transformationMatrixIsValid(alpha())) return;
-  transformationMatrixIsValid(alpha()) = true;
+  if (ctx.transformationMatrixIsValid(alpha())) return;
+  ctx.transformationMatrixIsValid(alpha()) = true;
 
   int flops = JTrans.numCells() * maxDim + JTrans.numCells();
 
-  G(alpha()).resize(JTrans.numCells() * JTrans.cellDim());
+  ctx.G(alpha()).resize(JTrans.numCells() * JTrans.cellDim());
 
   int k = 0;
-  double* GPtr = &(G(alpha())[0]);
+  double* GPtr = &(ctx.G(alpha())[0]);
 
   for (int c=0; c<JTrans.numCells(); c++)
   {
-    Array<double> invJ;
     JTrans.getInvJ(c, invJ);
     double detJ = fabs(JVol.detJ()[c]);
     for (int gamma=0; gamma<maxDim; gamma++, k++)
@@ -46,8 +46,10 @@
 #include "SundanceCellJacobianBatch.hpp"
 #include "SundanceQuadratureFamily.hpp"
 #include "SundanceBasisFamily.hpp"
+#include "SundanceBasisTabulationCache.hpp"
 #include "SundanceParametrizedCurve.hpp"
 #include "SundanceMesh.hpp"
+#include "SundanceIntegrationContext.hpp"
 #include "Teuchos_Array.hpp"
 
 
@@ -147,16 +149,6 @@ public:
   /** */
   void describe(std::ostream& os) const ;
 
-  /** */
-  static int& transformationMatrixIsValid(int alpha);
-
-
-  /** */
-  static int& transformationMatrixIsValid(int alpha, int beta);
-
-  /** */
-  static void invalidateTransformationMatrices();
-
   /** */
   static double& totalFlops() {static double rtn = 0; return rtn;}
 
@@ -172,7 +164,14 @@ protected:
   void assertLinearForm() const ;
 
   /** */
-  static void addFlops(const double& flops) {totalFlops() += flops;}
+  static void addFlops(const double& flops) 
+    {
+      double& total = totalFlops();
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      total += flops;
+    }
 
   /** The dimension of the cell being integrated */
   int dim() const {return dim_;}
@@ -219,12 +218,6 @@ protected:
   /** */
   const BasisFamily& unkBasis() const {return unkBasis_;}
 
-  /** Workspace for element transformations involving one derivative*/
-  static Array<double>& G(int gamma) ;
-
-  /** Workspace for element transformations involving two derivatives */
-  static Array<double>& G(int gamma, int delta) ;
-
   /** return base to the given power */
   static int ipow(int base, int power);
 
@@ -243,11 +236,23 @@ protected:
   void getQuad(const QuadratureFamily& quad, int evalCase,
     Array<Point>& quadPts, Array<double>& quadWeights) const ;
 
-  /** */
-  void createTwoFormTransformationMatrix(const CellJacobianBatch& JTrans,
+  /** Values of a basis, or of a derivative, at the points 
+   * getQuad() returns for the given evaluation case */
+  RCP<const BasisTabulation> tabulate(const BasisFamily& basis,
+    const QuadratureFamily& quad, int evalCase,
+    const SpatialDerivSpecifier& deriv) const ;
+
+  /** Build, if not already valid for the current workset, the 
+   * transformation matrix needed by this two-form. The result is
+   * stored in the integration context. */
+  void createTwoFormTransformationMatrix(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol) const;
-  /** */
-  void createOneFormTransformationMatrix(const CellJacobianBatch& JTrans,
+  /** Build, if not already valid for the current workset, the 
+   * transformation matrix needed by this one-form. The result is
+   * stored in the integration context. */
+  void createOneFormTransformationMatrix(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol) const;
 
   /** */
@@ -0,0 +1,261 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceGeometryCache.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+
+GeometryCacheKey::GeometryCacheKey(int meshID, int cellDim, 
+  const Array<int>& cellLID)
+  : meshID_(meshID), cellDim_(cellDim), numCells_(cellLID.size()),
+    firstLID_(-1), checksum_(0)
+{
+  if (numCells_ > 0) firstLID_ = cellLID[0];
+  /* FNV-1a over the LIDs */
+  unsigned int h = 2166136261u;
+  for (int i=0; i<numCells_; i++)
+  {
+    h ^= (unsigned int) cellLID[i];
+    h *= 16777619u;
+  }
+  checksum_ = h;
+}
+
+
+bool GeometryCacheKey::operator<(const GeometryCacheKey& other) const 
+{
+  if (meshID_ != other.meshID_) return meshID_ < other.meshID_;
+  if (cellDim_ != other.cellDim_) return cellDim_ < other.cellDim_;
+  if (numCells_ != other.numCells_) return numCells_ < other.numCells_;
+  if (firstLID_ != other.firstLID_) return firstLID_ < other.firstLID_;
+  return checksum_ < other.checksum_;
+}
+
+
+GeometryCacheEntry::GeometryCacheEntry(const Array<int>& cellLID, 
+  const RCP<CellJacobianBatch>& JVol)
+  : cellLID_(cellLID), JVol_(JVol), JTrans_(), 
+    facetIndices_(), maxCellLIDs_(), physQuadPts_(), bytes_(0)
+{
+  bytes_ = cellLID_.size()*sizeof(int) + jacobianBytes(*JVol_);
+}
+
+
+size_t GeometryCacheEntry::jacobianBytes(const CellJacobianBatch& J) 
+{
+  /* Jacobian values, inverses, a structure-of-arrays copy, and
+   * determinants */
+  size_t n = J.numCells() * J.numQuadPoints();
+  size_t d2 = J.spatialDim() * J.spatialDim();
+  return sizeof(double) * n * (3*d2 + 1);
+}
+
+
+void GeometryCacheEntry::setCofacetData(const RCP<CellJacobianBatch>& JTrans,
+  const RCP<Array<int> >& facetIndices,
+  const RCP<Array<int> >& maxCellLIDs)
+{
+  JTrans_ = JTrans;
+  facetIndices_ = facetIndices;
+  maxCellLIDs_ = maxCellLIDs;
+  bytes_ += jacobianBytes(*JTrans_) 
+    + sizeof(int)*(facetIndices_->size() + maxCellLIDs_->size());
+}
+
+
+RCP<const Array<Point> > 
+GeometryCacheEntry::physQuadPts(const std::string& quadKey) const 
+{
+  RCP<const Array<Point> > rtn;
+  if (physQuadPts_.containsKey(quadKey)) rtn = physQuadPts_.get(quadKey);
+  return rtn;
+}
+
+
+void GeometryCacheEntry::setPhysQuadPts(const std::string& quadKey, 
+  const Array<Point>& pts)
+{
+  TEUCHOS_TEST_FOR_EXCEPT(physQuadPts_.containsKey(quadKey));
+  physQuadPts_.put(quadKey, rcp(new Array<Point>(pts)));
+  bytes_ += quadKey.size() + pts.size()*sizeof(Point);
+}
+
+
+
+Map<GeometryCacheKey, 
+    std::pair<RCP<GeometryCacheEntry>, GeometryCache::LRUList::iterator> >& 
+GeometryCache::table()
+{
+  static Map<GeometryCacheKey, 
+    std::pair<RCP<GeometryCacheEntry>, LRUList::iterator> > rtn;
+  return rtn;
+}
+
+
+void GeometryCache::disable(const Mesh& mesh)
+{
+  enabledMeshes().erase(mesh.id());
+
+  LRUList::iterator i = recency().begin();
+  while (i != recency().end())
+  {
+    if (i->meshID() == mesh.id())
+    {
+      bytesInUse_() -= table().get(*i).first->bytes();
+      table().erase(*i);
+      i = recency().erase(i);
+    }
+    else
+    {
+      i++;
+    }
+  }
+}
+
+
+RCP<GeometryCacheEntry> GeometryCache::lookup(const Mesh& mesh, int cellDim, 
+  const Array<int>& cellLID)
+{
+  RCP<GeometryCacheEntry> rtn;
+  if (!isEnabled(mesh)) return rtn;
+
+  GeometryCacheKey key(mesh.id(), cellDim, cellLID);
+  if (table().containsKey(key))
+  {
+    std::pair<RCP<GeometryCacheEntry>, LRUList::iterator>& e 
+      = table()[key];
+    const Array<int>& stored = e.first->cellLID();
+    bool same = stored.size() == cellLID.size();
+    for (int i=0; same && i<cellLID.size(); i++) 
+    {
+      same = stored[i] == cellLID[i];
+    }
+    if (same)
+    {
+      /* move to the front of the recency list */
+      recency().splice(recency().begin(), recency(), e.second);
+      numHits()++;
+      return e.first;
+    }
+  }
+  numMisses()++;
+  return rtn;
+}
+
+
+void GeometryCache::insert(const Mesh& mesh, int cellDim, 
+  const RCP<GeometryCacheEntry>& entry)
+{
+  if (!isEnabled(mesh)) return;
+
+  GeometryCacheKey key(mesh.id(), cellDim, entry->cellLID());
+  if (table().containsKey(key))
+  {
+    /* a checksum collision: replace the old entry */
+    std::pair<RCP<GeometryCacheEntry>, LRUList::iterator>& e 
+      = table()[key];
+    bytesInUse_() -= e.first->bytes();
+    recency().erase(e.second);
+    table().erase(key);
+  }
+
+  recency().push_front(key);
+  table().put(key, std::make_pair(entry, recency().begin()));
+  bytesInUse_() += entry->bytes();
+  evict(entry);
+}
+
+
+void GeometryCache::entryHasGrown(const Mesh& mesh, int cellDim,
+  const RCP<GeometryCacheEntry>& entry, size_t oldBytes)
+{
+  GeometryCacheKey key(mesh.id(), cellDim, entry->cellLID());
+  if (!table().containsKey(key) 
+    || table().get(key).first.get() != entry.get()) return;
+
+  bytesInUse_() += entry->bytes() - oldBytes;
+  evict(entry);
+}
+
+
+void GeometryCache::evict(const RCP<GeometryCacheEntry>& keep)
+{
+  while (bytesInUse_() > memoryBudget() && !recency().empty())
+  {
+    const GeometryCacheKey& key = recency().back();
+    RCP<GeometryCacheEntry> victim = table().get(key).first;
+    /* never evict the entry being inserted */
+    if (victim.get() == keep.get()) break;
+    bytesInUse_() -= victim->bytes();
+    table().erase(key);
+    recency().pop_back();
+    numEvictions()++;
+  }
+}
+
+
+void GeometryCache::clear()
+{
+  table().clear();
+  recency().clear();
+  bytesInUse_() = 0;
+}
+
+
+double GeometryCache::hitRate()
+{
+  int n = numHits() + numMisses();
+  if (n == 0) return 0.0;
+  return ((double) numHits()) / ((double) n);
+}
+
+
+void GeometryCache::printStats(std::ostream& os)
+{
+  os << "geometry cache: hits=" << numHits() 
+     << " misses=" << numMisses()
+     << " hit rate=" << hitRate()
+     << " evictions=" << numEvictions() 
+     << " entries=" << table().size()
+     << " bytes=" << bytesInUse() << std::endl;
+}
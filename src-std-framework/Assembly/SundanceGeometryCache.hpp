@@ -0,0 +1,227 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_GEOMETRYCACHE_H
+#define SUNDANCE_GEOMETRYCACHE_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMap.hpp"
+#include "SundanceSet.hpp"
+#include "SundancePoint.hpp"
+#include "SundanceCellJacobianBatch.hpp"
+#include "Teuchos_Array.hpp"
+#include <list>
+#include <string>
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * GeometryCacheKey identifies a batch of cells: the mesh, the cell 
+ * dimension, and a checksum over the cell LIDs. Because checksums
+ * can collide, the cached entry keeps the LIDs themselves and a hit
+ * is only reported if they match.
+ */
+class GeometryCacheKey
+{
+public:
+  /** */
+  GeometryCacheKey(int meshID, int cellDim, const Array<int>& cellLID);
+
+  /** */
+  bool operator<(const GeometryCacheKey& other) const ;
+
+  /** */
+  int meshID() const {return meshID_;}
+
+private:
+  int meshID_;
+  int cellDim_;
+  int numCells_;
+  int firstLID_;
+  unsigned int checksum_;
+};
+
+/**
+ * GeometryCacheEntry holds the geometric data computed for one batch 
+ * of cells: the volume Jacobians, the cofacet data used for 
+ * transformations on boundaries (filled in when first needed), and the
+ * physical quadrature points for each quadrature rule used on 
+ * the batch.
+ */
+class GeometryCacheEntry
+{
+public:
+  /** */
+  GeometryCacheEntry(const Array<int>& cellLID, 
+    const RCP<CellJacobianBatch>& JVol);
+
+  /** */
+  const Array<int>& cellLID() const {return cellLID_;}
+
+  /** */
+  const RCP<CellJacobianBatch>& JVol() const {return JVol_;}
+
+  /** Whether the cofacet data has been stored */
+  bool hasCofacetData() const {return JTrans_.get() != 0;}
+
+  /** */
+  const RCP<CellJacobianBatch>& JTrans() const {return JTrans_;}
+
+  /** */
+  const RCP<Array<int> >& facetIndices() const {return facetIndices_;}
+
+  /** */
+  const RCP<Array<int> >& maxCellLIDs() const {return maxCellLIDs_;}
+
+  /** Store the cofacet data */
+  void setCofacetData(const RCP<CellJacobianBatch>& JTrans,
+    const RCP<Array<int> >& facetIndices,
+    const RCP<Array<int> >& maxCellLIDs);
+
+  /** Return the physical quadrature points stored under the 
+   * given key, or null */
+  RCP<const Array<Point> > physQuadPts(const std::string& quadKey) const ;
+
+  /** Store physical quadrature points under the given key */
+  void setPhysQuadPts(const std::string& quadKey, const Array<Point>& pts);
+
+  /** Approximate memory used by this entry, in bytes */
+  size_t bytes() const {return bytes_;}
+
+private:
+  static size_t jacobianBytes(const CellJacobianBatch& J) ;
+
+  Array<int> cellLID_;
+  RCP<CellJacobianBatch> JVol_;
+  RCP<CellJacobianBatch> JTrans_;
+  RCP<Array<int> > facetIndices_;
+  RCP<Array<int> > maxCellLIDs_;
+  Map<std::string, RCP<const Array<Point> > > physQuadPts_;
+  size_t bytes_;
+};
+
+/**
+ * GeometryCache stores the per-workset geometry computed by the
+ * evaluation mediators (Jacobians, their determinants and inverses,
+ * cofacet data, and physical quadrature points) so that repeated
+ * assemblies on a static mesh, such as the steps of a long transient
+ * run, can reuse it instead of recomputing it. 
+ *
+ * Caching is opt-in per mesh through enable(), since the cache is only 
+ * valid if the mesh geometry does not change. Memory is bounded by
+ * memoryBudget(); when the budget is exceeded, the least recently used
+ * entries are evicted. 
+ */
+class GeometryCache
+{
+public:
+  /** Turn on caching for a mesh */
+  static void enable(const Mesh& mesh) {enabledMeshes().put(mesh.id());}
+
+  /** Turn off caching for a mesh and drop its entries */
+  static void disable(const Mesh& mesh) ;
+
+  /** Whether caching is on for the mesh */
+  static bool isEnabled(const Mesh& mesh) 
+    {return enabledMeshes().contains(mesh.id());}
+
+  /** Memory budget in bytes, over all meshes */
+  static size_t& memoryBudget() 
+    {static size_t rtn=size_t(256)*1024*1024; return rtn;}
+
+  /** Return the entry for a batch of cells, or null */
+  static RCP<GeometryCacheEntry> lookup(const Mesh& mesh, int cellDim, 
+    const Array<int>& cellLID);
+
+  /** Store an entry for a batch of cells */
+  static void insert(const Mesh& mesh, int cellDim, 
+    const RCP<GeometryCacheEntry>& entry);
+
+  /** Account for data added to an entry after insertion, evicting 
+   * other entries if the budget is exceeded. Entries that have 
+   * already been evicted are ignored. */
+  static void entryHasGrown(const Mesh& mesh, int cellDim,
+    const RCP<GeometryCacheEntry>& entry, size_t oldBytes);
+
+  /** Remove all entries */
+  static void clear() ;
+
+  /** Total bytes held by the cache */
+  static size_t bytesInUse() {return bytesInUse_();}
+
+  /** */
+  static int& numHits() {static int rtn=0; return rtn;}
+
+  /** */
+  static int& numMisses() {static int rtn=0; return rtn;}
+
+  /** */
+  static int& numEvictions() {static int rtn=0; return rtn;}
+
+  /** Fraction of lookups that were hits */
+  static double hitRate() ;
+
+  /** Print hit and memory statistics */
+  static void printStats(std::ostream& os) ;
+
+private:
+  typedef std::list<GeometryCacheKey> LRUList;
+
+  /** */
+  static void evict(const RCP<GeometryCacheEntry>& keep);
+
+  static Set<int>& enabledMeshes() {static Set<int> rtn; return rtn;}
+
+  static size_t& bytesInUse_() {static size_t rtn=0; return rtn;}
+
+  /** Entries and their positions in the recency list */
+  static Map<GeometryCacheKey, 
+             std::pair<RCP<GeometryCacheEntry>, LRUList::iterator> >& table();
+
+  /** Keys ordered from most to least recently used */
+  static LRUList& recency() {static LRUList rtn; return rtn;}
+};
+}
+
+#endif
@@ -277,7 +277,8 @@ IntegralGroup
 
 
 bool IntegralGroup
-::evaluate(const CellJacobianBatch& JTrans,
+::evaluate(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag, 
   const Array<int>& facetIndex, 
@@ -286,7 +287,7 @@ bool IntegralGroup
   const Array<double>& constantCoeffs,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(integrationTimer());
+  IntegrationTimeMonitor timer(integrationTimer(), ctx);
   Tabs tab0(0);
 
 
@@ -335,7 +336,7 @@ bool IntegralGroup
       double f = constantCoeffs[resultIndices_[i]];
       SUNDANCE_MSG2(integrationVerb(),
         tab2 << "Coefficient is " << f);
-      ref->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
+      ref->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
     }
     else if (reducedQuad != 0)
     {
@@ -346,7 +347,7 @@ bool IntegralGroup
       SUNDANCE_MSG3(integrationVerb(),
         tab3 << "coefficients are " <<  vectorCoeffs[resultIndices_[i]]->str());
       const double* const f = vectorCoeffs[resultIndices_[i]]->start();
-      reducedQuad->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
+      reducedQuad->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
     }
     else if (quad != 0)
     {
@@ -367,7 +368,7 @@ bool IntegralGroup
         tab3 << "coefficients are " <<  vectorCoeffs[resultIndices_[i]]->str());
 
       const double* const f = vectorCoeffs[resultIndices_[i]]->start();
-      quad->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
+      quad->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
     }
     else if (maxQuad != 0)
     {
@@ -388,7 +389,7 @@ bool IntegralGroup
         tab3 << "coefficients are " <<  vectorCoeffs[resultIndices_[i]]->str());
 
       const double* const f = vectorCoeffs[resultIndices_[i]]->start();
-      maxQuad->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
+      maxQuad->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f, A);
     }
     else if (curveQuad != 0)
     {
@@ -410,10 +411,10 @@ bool IntegralGroup
         double* const f = vectorCoeffs[resultIndices_[i]]->start();
         SUNDANCE_MSG3(integrationVerb(),
           tab3 << "coefficients are " <<  vectorCoeffs[resultIndices_[i]]->str());
-        curveQuad->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f_const , f , A);
+        curveQuad->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f_const , f , A);
       } else{
         const double* f_null = 0;
-        curveQuad->transform(JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f_const , f_null , A);
+        curveQuad->transform(ctx, JTrans, JVol, isLocalFlag, facetIndex, cellLIDs , f_const , f_null , A);
       }
 
     }
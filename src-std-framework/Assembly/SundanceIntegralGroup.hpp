@@ -140,8 +140,10 @@ public:
   /** \brief Extract basis used for unknown functions in this integral group */
   const BasisFamily & getUnknownBasis() const { return integrals_[0]->getUnknownBasis(); }
 
-  /** Evaluate this integral group */
-  bool evaluate(const CellJacobianBatch& JTrans,
+  /** Evaluate this integral group. Transformation matrices and scratch
+   * space for the current workset are taken from the integration context. */
+  bool evaluate(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetNum, 
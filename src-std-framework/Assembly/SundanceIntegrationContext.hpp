@@ -0,0 +1,164 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_INTEGRATIONCONTEXT_H
+#define SUNDANCE_INTEGRATIONCONTEXT_H
+
+#include "SundanceDefs.hpp"
+#include "Teuchos_Array.hpp"
+#include "Teuchos_Time.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/** 
+ * IntegrationContext holds the per-workset scratch data used while
+ * transforming element integrals: the cell-by-cell transformation
+ * matrices G built from the Jacobians of the current workset, flags
+ * indicating which of them are valid for the workset, and workspace
+ * arrays used during quadrature sums. 
+ *
+ * The transformation matrices are built on first use within a workset
+ * and then shared by all integrals on that workset with the same
+ * derivative directions. When the workset changes, the owner of the
+ * context must call invalidateTransformationMatrices(). 
+ *
+ * Each assembly loop owns its own context, so that separate assemblies
+ * can run concurrently without sharing integration state. When integral 
+ * groups are evaluated by several threads, each thread has its own 
+ * context.
+ */
+class IntegrationContext
+{
+public:
+  /** */
+  IntegrationContext();
+
+  /** Transformation matrix for integrals involving one derivative */
+  Array<double>& G(int alpha) {return G1_[alpha];}
+
+  /** Transformation matrix for integrals involving two derivatives */
+  Array<double>& G(int alpha, int beta) {return G2_[3*alpha + beta];}
+
+  /** */
+  int& transformationMatrixIsValid(int alpha) 
+    {return G1IsValid_[alpha];}
+
+  /** */
+  int& transformationMatrixIsValid(int alpha, int beta)
+    {return G2IsValid_[3*alpha + beta];}
+
+  /** Mark all transformation matrices as out of date. This must
+   * be called whenever the cells in the workset change. */
+  void invalidateTransformationMatrices();
+
+  /** Workspace for sums of untransformed quantities over quad points */
+  Array<double>& sumWorkspace() {return sumWorkspace_;}
+
+  /** Workspace for Jacobian values scaled by a coefficient */
+  Array<double>& jWorkspace() {return jWorkspace_;}
+
+  /** Workspace for the inverse Jacobian of a single cell */
+  Array<double>& invJWorkspace() {return invJWorkspace_;}
+
+  /** Workspace for cell-batched quadrature kernels, holding
+   * coefficients, transformation matrices, and partial sums
+   * for a block of cells laid out with the cell index fastest */
+  Array<double>& batchWorkspace() {return batchWorkspace_;}
+
+  /** Whether integration timers are updated by work done in this 
+   * context. Timers are shared by the whole process, so they are 
+   * turned off in contexts used by worker threads. */
+  bool timersEnabled() const {return timersEnabled_;}
+
+  /** */
+  void setTimersEnabled(bool on) {timersEnabled_ = on;}
+
+private:
+  Array<Array<double> > G1_;
+
+  Array<Array<double> > G2_;
+
+  Array<int> G1IsValid_;
+
+  Array<int> G2IsValid_;
+
+  Array<double> sumWorkspace_;
+
+  Array<double> jWorkspace_;
+
+  Array<double> invJWorkspace_;
+
+  Array<double> batchWorkspace_;
+
+  bool timersEnabled_;
+};
+
+
+/** 
+ * IntegrationTimeMonitor times a scope like Teuchos::TimeMonitor, 
+ * but does nothing if timers are disabled in the integration context.
+ */
+class IntegrationTimeMonitor
+{
+public:
+  /** */
+  IntegrationTimeMonitor(Time& timer, const IntegrationContext& ctx)
+    : timer_((ctx.timersEnabled() && !timer.isRunning()) ? &timer : 0)
+    {
+      if (timer_) 
+      {
+        timer_->start();
+        timer_->incrementNumCalls();
+      }
+    }
+
+  /** */
+  ~IntegrationTimeMonitor() {if (timer_) timer_->stop();}
+
+private:
+  Time* timer_;
+};
+
+}
+
+#endif
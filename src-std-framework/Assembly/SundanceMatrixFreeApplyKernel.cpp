@@ -0,0 +1,218 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceOut.hpp"
+#include "PlayaTabs.hpp"
+#include "SundanceMatrixFreeApplyKernel.hpp"
+#include "SundanceDiscreteSpace.hpp"
+
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorImpl.hpp"
+#endif
+
+using namespace Sundance;
+using namespace Teuchos;
+using namespace Playa;
+using std::endl;
+
+
+MatrixFreeApplyKernel::MatrixFreeApplyKernel(
+  const Array<RCP<DOFMapBase> >& rowMap,
+  const Array<RCP<Array<int> > >& isBCRow,
+  const Array<int>& lowestLocalRow,
+  const Array<RCP<DOFMapBase> >& colMap,
+  const Array<RCP<Array<int> > >& isBCCol,
+  const Array<int>& lowestLocalCol,
+  const Array<RCP<DiscreteSpace> >& colSpace,
+  const Vector<double>& x,
+  Array<Vector<double> > y,
+  int verb)
+  : VectorFillingAssemblyKernel(rowMap, isBCRow, lowestLocalRow, 
+    y, false, verb),
+    xGhosts_(colMap.size()),
+    cmb_(colMap, isBCCol, lowestLocalCol, false, verb),
+    cols_(),
+    xLocal_(),
+    yLocal_()
+{
+  Tabs tab;
+  SUNDANCE_MSG2(verb, tab << "begin MatrixFreeApplyKernel ctor");
+
+  /* Import the off-processor values of x needed by the local cells */
+  for (int bc=0; bc<colMap.size(); bc++)
+  {
+    colSpace[bc]->importGhosts(x.getBlock(bc), xGhosts_[bc]);
+  }
+
+  SUNDANCE_MSG2(verb, tab << "end MatrixFreeApplyKernel ctor");
+}
+
+
+bool MatrixFreeApplyKernel::needsGroup(const IntegralGroup& group) const
+{
+  return group.isTwoForm();
+}
+
+
+void MatrixFreeApplyKernel::fill(
+  bool isBC, 
+  const IntegralGroup& group,
+  const RCP<Array<double> >& localValues) 
+{
+  Tabs tab0;
+  SUNDANCE_MSG1(verb(), tab0 << "in MatrixFreeApplyKernel::fill()");
+
+  if (group.isTwoForm())
+  {
+    applyLocalMatrixBatch(isBC, group.usesMaximalCofacets(), 
+      group.testID(), group.testBlock(),
+      group.unkID(), group.unkBlock(),
+      *localValues);
+  }
+  else
+  {
+    Tabs tab1;
+    SUNDANCE_MSG2(verb(), tab1 << "not a two form -- nothing to do here");
+  }
+
+  SUNDANCE_MSG1(verb(), tab0 << "done MatrixFreeApplyKernel::fill()");
+}
+  
+
+void MatrixFreeApplyKernel::prepareForWorkSet(
+  const Array<Set<int> >& requiredTests,
+  const Array<Set<int> >& requiredUnks,
+  RCP<StdFwkEvalMediator> mediator)
+{
+  Tabs tab0;
+  SUNDANCE_MSG1(verb(), tab0 
+    << "in MatrixFreeApplyKernel::prepareForWorkSet()");
+
+  IntegrationCellSpecifier intCellSpec = mediator->integrationCellSpec();
+
+  SUNDANCE_MSG2(verb(), tab0 << "building row DOF maps");
+  buildLocalDOFMaps(mediator, intCellSpec, requiredTests);
+
+  SUNDANCE_MSG2(verb(), tab0 << "building column DOF maps");
+  cmb_.buildLocalDOFMaps(mediator, intCellSpec, requiredUnks, verb());
+
+  SUNDANCE_MSG1(verb(), tab0 
+    << "done MatrixFreeApplyKernel::prepareForWorkSet()");
+}
+
+
+void MatrixFreeApplyKernel::applyLocalMatrixBatch(
+  bool isBCRqc,
+  bool useCofacetCells,
+  const Array<int>& testID, 
+  const Array<int>& testBlock, 
+  const Array<int>& unkID,
+  const Array<int>& unkBlock,
+  const Array<double>& localValues) const
+{
+  Tabs tab;
+  SUNDANCE_MSG1(verb(), tab << "applying local matrices");
+
+  const MapBundle& rmb = mapBundle();
+  int nCells = rmb.nCells();
+
+  for (int t=0; t<testID.size(); t++)
+  {
+    int br = testBlock[t];
+    int testChunk = rmb.mapStruct(br, 
+      useCofacetCells)->chunkForFuncID(testID[t]);
+    int nTestNodes = rmb.nNodesInChunk(br, useCofacetCells, testChunk);
+    int numRows = nCells * nTestNodes;
+
+    for (int u=0; u<unkID.size(); u++)
+    {      
+      Tabs tab1;
+      int bc = unkBlock[u];
+      
+      int unkChunk = cmb().mapStruct(bc, 
+        useCofacetCells)->chunkForFuncID(unkID[u]);
+      int unkFuncIndex = cmb().mapStruct(bc, 
+        useCofacetCells)->indexForFuncID(unkID[u]);
+      const Array<int>& unkDofs = cmb().localDOFs(bc, useCofacetCells, unkChunk);
+      int nUnkFuncs = cmb().mapStruct(bc, useCofacetCells)->numFuncs(unkChunk);
+      int nUnkNodes = cmb().nNodesInChunk(bc, useCofacetCells, unkChunk);
+
+      SUNDANCE_MSG3(verb(), tab1 << "block row=" << br << " block col=" << bc
+        << " test nodes=" << nTestNodes << " unk nodes=" << nUnkNodes);
+
+      /* gather the local values of x */
+      cols_.resize(nCells*nUnkNodes);
+      int j=0;
+      for (int c=0; c<nCells; c++)
+      {
+        for (int n=0; n<nUnkNodes; n++, j++)
+        {
+          cols_[j] = unkDofs[(c*nUnkFuncs + unkFuncIndex)*nUnkNodes + n];
+        }
+      }
+      xGhosts_[bc]->getElements(&(cols_[0]), cols_.size(), xLocal_);
+
+      /* apply the local matrices. Local matrix values are stored 
+       * row-major, one cell after another. */
+      yLocal_.resize(numRows);
+      const double* A = &(localValues[0]);
+      for (int c=0; c<nCells; c++)
+      {
+        const double* xc = &(xLocal_[c*nUnkNodes]);
+        for (int m=0; m<nTestNodes; m++)
+        {
+          int r = c*nTestNodes + m;
+          const double* Arow = A + r*nUnkNodes;
+          double sum = 0.0;
+          for (int n=0; n<nUnkNodes; n++) sum += Arow[n]*xc[n];
+          yLocal_[r] = sum;
+        }
+      }
+
+      /* scatter into y, skipping rows as matrix assembly would */
+      insertLocalVectorBatch(isBCRqc, useCofacetCells,
+        tuple(testID[t]), tuple(br), tuple(0), yLocal_);
+    }
+  }
+
+  SUNDANCE_MSG1(verb(), tab << "done applying local matrices");
+}
@@ -0,0 +1,120 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_MATRIXFREEAPPLYKERNEL_H
+#define SUNDANCE_MATRIXFREEAPPLYKERNEL_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceVectorFillingAssemblyKernel.hpp"
+#include "PlayaGhostView.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/** 
+ * MatrixFreeApplyKernel computes the product \f$y = Ax\f$ of the 
+ * matrix that MatrixVectorAssemblyKernel would assemble with a vector
+ * \f$x\f$, without forming \f$A\f$. For each workset the local element
+ * matrices are applied to the values of \f$x\f$ gathered through the 
+ * column DOF maps, and the results are scattered into \f$y\f$ 
+ * with the same rules for BC rows as matrix assembly. One-forms and 
+ * zero-forms are not integrated at all.
+ */
+class MatrixFreeApplyKernel : public VectorFillingAssemblyKernel
+{
+public:
+  /** */
+  MatrixFreeApplyKernel(
+    const Array<RCP<DOFMapBase> >& rowMap,
+    const Array<RCP<Array<int> > >& isBCRow,
+    const Array<int>& lowestLocalRow,
+    const Array<RCP<DOFMapBase> >& colMap,
+    const Array<RCP<Array<int> > >& isBCCol,
+    const Array<int>& lowestLocalCol,
+    const Array<RCP<DiscreteSpace> >& colSpace,
+    const Vector<double>& x,
+    Array<Vector<double> > y,
+    int verb);
+
+  /** */
+  void prepareForWorkSet(
+    const Array<Set<int> >& requiredTests,
+    const Array<Set<int> >& requiredUnks,
+    RCP<StdFwkEvalMediator> mediator) ;
+
+  /** */
+  void fill(bool isBC,
+    const IntegralGroup& group,
+    const RCP<Array<double> >& localValues) ;
+
+  /** Only two-forms contribute to the product */
+  bool needsGroup(const IntegralGroup& group) const ;
+
+protected:
+
+  /** Apply a batch of local matrices to the local values of x and
+   * add the results into y */
+  void applyLocalMatrixBatch(
+    bool isBCRqc,
+    bool useCofacetCells,
+    const Array<int>& testID, 
+    const Array<int>& testBlock, 
+    const Array<int>& unkID,
+    const Array<int>& unkBlock,
+    const Array<double>& localValues) const ;
+
+  /** */
+  const MapBundle& cmb() const {return cmb_;}
+
+private:
+  Array<RCP<GhostView<double> > > xGhosts_;
+  mutable MapBundle cmb_;
+  mutable Array<int> cols_;
+  mutable Array<double> xLocal_;
+  mutable Array<double> yLocal_;
+};
+
+}
+
+
+
+#endif
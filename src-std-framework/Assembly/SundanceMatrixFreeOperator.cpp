@@ -0,0 +1,95 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceMatrixFreeOperator.hpp"
+#include "SundanceAssembler.hpp"
+#include "SundanceOut.hpp"
+#include "PlayaTabs.hpp"
+#include "Teuchos_toString.hpp"
+
+#ifndef HAVE_TEUCHOS_EXPLICIT_INSTANTIATION
+#include "PlayaVectorImpl.hpp"
+#endif
+
+using namespace Sundance;
+using namespace Teuchos;
+using namespace Playa;
+
+
+MatrixFreeOperator::MatrixFreeOperator(const RCP<Assembler>& assembler)
+  : LinearOpWithSpaces<double>(assembler->solnVecSpace(), 
+    assembler->rowVecSpace()),
+    assembler_(assembler)
+{}
+
+
+void MatrixFreeOperator::apply(Teuchos::ETransp transApplyType,
+  const Vector<double>& in,
+  Vector<double> out) const
+{
+  Tabs tab(0);
+  SUNDANCE_MSG2(this->verb(), tab << "MatrixFreeOperator::apply()");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(transApplyType != Teuchos::NO_TRANS, 
+    std::runtime_error,
+    "MatrixFreeOperator::apply() cannot apply the transpose of an "
+    "operator that is not assembled");
+
+  Vector<double> y;
+  assembler_->applyMatrixFree(in, y);
+  out.acceptCopyOf(y);
+
+  SUNDANCE_MSG2(this->verb(), tab << "done MatrixFreeOperator::apply()");
+}
+
+
+std::string MatrixFreeOperator::description() const 
+{
+  return "MatrixFreeOperator[dim=" + Teuchos::toString(this->range()->dim())
+    + "x" + Teuchos::toString(this->domain()->dim()) + "]";
+}
+
+
+void MatrixFreeOperator::print(std::ostream& os) const 
+{
+  Tabs tab(0);
+  os << tab << description() << std::endl;
+}
@@ -0,0 +1,93 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_MATRIXFREEOPERATOR_H
+#define SUNDANCE_MATRIXFREEOPERATOR_H
+
+#include "SundanceDefs.hpp"
+#include "PlayaLinearOpWithSpacesDecl.hpp"
+#include "PlayaPrintable.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+using namespace Playa;
+
+class Assembler;
+
+/** 
+ * MatrixFreeOperator is the operator on the left-hand side of a linear 
+ * problem, applied element by element without assembling a matrix. 
+ * Each application integrates the element matrices through the 
+ * assembler and applies them to the local values of the input vector.
+ * This trades repeated integration for the storage and bandwidth of
+ * a sparse matrix, which pays off for high-order discretizations
+ * where the matrix is dense on each element. 
+ *
+ * Only the untransposed operator can be applied, so this operator
+ * can be used with Krylov methods that need only \f$Ax\f$ and with
+ * preconditioners that do not need the matrix entries.
+ */
+class MatrixFreeOperator : public LinearOpWithSpaces<double>,
+  public Printable
+{
+public:
+  /** */
+  MatrixFreeOperator(const RCP<Assembler>& assembler);
+
+  /** */
+  void apply(Teuchos::ETransp transApplyType,
+    const Vector<double>& in,
+    Vector<double> out) const ;
+
+  /** */
+  std::string description() const ;
+
+  /** */
+  void print(std::ostream& os) const ;
+
+private:
+  RCP<Assembler> assembler_;
+};
+
+}
+
+#endif
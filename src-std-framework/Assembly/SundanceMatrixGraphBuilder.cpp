@@ -0,0 +1,148 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceMatrixGraphBuilder.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include <algorithm>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+static Time& graphCompressionTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("matrix graph compression"); 
+  return *rtn;
+}
+
+
+MatrixGraphBuilder::MatrixGraphBuilder(int lowestRow, int nLocalRows)
+  : lowestRow_(lowestRow),
+    nLocalRows_(nLocalRows),
+    ptr_(nLocalRows+1, 0),
+    cols_(),
+    pendingRows_(),
+    pendingCols_(),
+    flushSize_(minFlushSize()),
+    peakBytes_(0)
+{
+  peakBytes_ = currentBytes();
+}
+
+size_t MatrixGraphBuilder::currentBytes() const 
+{
+  return sizeof(int)*(ptr_.capacity() + cols_.capacity() 
+    + pendingRows_.capacity() + pendingCols_.capacity());
+}
+
+void MatrixGraphBuilder::compress()
+{
+  TimeMonitor timer(graphCompressionTimer());
+
+  /* count the entries in each row, old and new */
+  Array<int> newPtr(nLocalRows_+1, 0);
+  for (int r=0; r<nLocalRows_; r++) newPtr[r+1] = ptr_[r+1] - ptr_[r];
+  for (int i=0; i<pendingRows_.size(); i++) newPtr[pendingRows_[i]+1]++;
+  for (int r=0; r<nLocalRows_; r++) newPtr[r+1] += newPtr[r];
+
+  /* scatter old and new entries into their rows */
+  Array<int> newCols(newPtr[nLocalRows_]);
+  Array<int> pos(newPtr.begin(), newPtr.end()-1);
+  for (int r=0; r<nLocalRows_; r++)
+  {
+    for (int k=ptr_[r]; k<ptr_[r+1]; k++) newCols[pos[r]++] = cols_[k];
+  }
+  for (int i=0; i<pendingRows_.size(); i++)
+  {
+    newCols[pos[pendingRows_[i]]++] = pendingCols_[i];
+  }
+
+  size_t peak = currentBytes() + sizeof(int)*(newPtr.capacity() 
+    + newCols.capacity() + pos.capacity());
+  if (peak > peakBytes_) peakBytes_ = peak;
+
+  pendingRows_ = Array<int>();
+  pendingCols_ = Array<int>();
+  cols_ = Array<int>();
+
+  /* sort each row and remove duplicates */
+  Array<int> rowLen(nLocalRows_);
+  int* c = newCols.size() > 0 ? &(newCols[0]) : 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int r=0; r<nLocalRows_; r++)
+  {
+    int* begin = c + newPtr[r];
+    int* end = c + newPtr[r+1];
+    std::sort(begin, end);
+    rowLen[r] = std::unique(begin, end) - begin;
+  }
+
+  /* pack the rows */
+  ptr_[0] = 0;
+  for (int r=0; r<nLocalRows_; r++) ptr_[r+1] = ptr_[r] + rowLen[r];
+  cols_.resize(ptr_[nLocalRows_]);
+  for (int r=0; r<nLocalRows_; r++)
+  {
+    std::copy(c + newPtr[r], c + newPtr[r] + rowLen[r], 
+      cols_.begin() + ptr_[r]);
+  }
+
+  /* let the buffer grow to the size of the graph before the 
+   * next compression */
+  flushSize_ = std::max(minFlushSize(), (int) cols_.size());
+}
+
+void MatrixGraphBuilder::getGraph(Array<int>& graphData, 
+  Array<int>& rowPtrs, Array<int>& nnzPerRow)
+{
+  if (pendingRows_.size() > 0) compress();
+  rowPtrs.resize(nLocalRows_);
+  nnzPerRow.resize(nLocalRows_);
+  for (int r=0; r<nLocalRows_; r++)
+  {
+    rowPtrs[r] = ptr_[r];
+    nnzPerRow[r] = ptr_[r+1] - ptr_[r];
+  }
+  graphData = cols_;
+}
@@ -0,0 +1,129 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_MATRIXGRAPHBUILDER_H
+#define SUNDANCE_MATRIXGRAPHBUILDER_H
+
+#include "SundanceDefs.hpp"
+#include "Teuchos_Array.hpp"
+#include <cstddef>
+
+namespace Sundance
+{
+using Teuchos::Array;
+
+/**
+ * MatrixGraphBuilder accumulates the nonzero pattern of the locally 
+ * owned rows of a matrix. Column indices are appended to a flat buffer
+ * of (row, column) pairs; when the buffer grows past the size of 
+ * the pattern collected so far, it is merged into a compressed row 
+ * structure whose rows are sorted and free of duplicates. This keeps 
+ * the memory needed to at most a small multiple of the final graph, 
+ * in contrast to a tree-based set per row.
+ *
+ * If compiled with OpenMP, the per-row sorting is done in parallel.
+ */
+class MatrixGraphBuilder
+{
+public:
+  /** Create a builder for rows lowestRow through lowestRow+nLocalRows-1 */
+  MatrixGraphBuilder(int lowestRow, int nLocalRows);
+
+  /** Record nonzeros at the given global row and columns. */
+  void addToRow(int globalRow, int nCols, const int* globalCols)
+    {
+      int r = globalRow - lowestRow_;
+      for (int i=0; i<nCols; i++)
+      {
+        pendingRows_.append(r);
+        pendingCols_.append(globalCols[i]);
+      }
+      if (pendingRows_.size() > flushSize_) compress();
+    }
+
+  /** Merge buffered entries into the compressed structure */
+  void compress();
+
+  /** Finish the graph and return it in CRS form. The rowPtrs and 
+   * nnzPerRow arrays have one entry per local row. */
+  void getGraph(Array<int>& graphData, Array<int>& rowPtrs,
+    Array<int>& nnzPerRow);
+
+  /** Number of local rows */
+  int numRows() const {return nLocalRows_;}
+
+  /** Finish the graph and return the sorted columns in row r */
+  const int* row(int r, int& nnz) 
+    {
+      if (pendingRows_.size() > 0) compress();
+      nnz = ptr_[r+1] - ptr_[r];
+      return nnz > 0 ? &(cols_[ptr_[r]]) : 0;
+    }
+
+  /** Largest amount of memory, in bytes, held at any time */
+  size_t peakBytes() const {return peakBytes_;}
+
+  /** Minimum number of buffered entries before a compression */
+  static int& minFlushSize() {static int rtn=1<<20; return rtn;}
+
+private:
+  /** Current memory in use */
+  size_t currentBytes() const ;
+
+  int lowestRow_;
+
+  int nLocalRows_;
+
+  Array<int> ptr_;
+
+  Array<int> cols_;
+
+  Array<int> pendingRows_;
+
+  Array<int> pendingCols_;
+
+  int flushSize_;
+
+  size_t peakBytes_;
+};
+}
+
+#endif
@@ -0,0 +1,104 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceMatrixGraphCache.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+using Playa::MatrixFactory;
+
+bool MatrixGraphKey::operator<(const MatrixGraphKey& other) const 
+{
+  if (meshID_ != other.meshID_) return meshID_ < other.meshID_;
+  if (vecType_ != other.vecType_) return vecType_ < other.vecType_;
+
+  if (signature_.size() != other.signature_.size()) 
+    return signature_.size() < other.signature_.size();
+  for (int i=0; i<signature_.size(); i++)
+  {
+    if (signature_[i] != other.signature_[i]) 
+      return signature_[i] < other.signature_[i];
+  }
+
+  if (regions_.size() != other.regions_.size()) 
+    return regions_.size() < other.regions_.size();
+  for (int i=0; i<regions_.size(); i++)
+  {
+    if (regions_[i] < other.regions_[i]) return true;
+    if (other.regions_[i] < regions_[i]) return false;
+  }
+  return false;
+}
+
+
+Map<MatrixGraphKey, RCP<MatrixFactory<double> > >& MatrixGraphCache::table()
+{
+  static Map<MatrixGraphKey, RCP<MatrixFactory<double> > > rtn;
+  return rtn;
+}
+
+
+RCP<MatrixFactory<double> > 
+MatrixGraphCache::lookup(const MatrixGraphKey& key)
+{
+  RCP<MatrixFactory<double> > rtn;
+  if (!enabled() || !table().containsKey(key)) return rtn;
+
+  const RCP<MatrixFactory<double> >& weak = table().get(key);
+  if (weak.is_valid_ptr() && weak.get() != 0) 
+  {
+    rtn = weak.create_strong();
+    numHits()++;
+  }
+  else
+  {
+    table().erase(key);
+  }
+  return rtn;
+}
+
+
+void MatrixGraphCache::insert(const MatrixGraphKey& key, 
+  const RCP<MatrixFactory<double> >& factory)
+{
+  if (!enabled()) return;
+  table().put(key, factory.create_weak());
+}
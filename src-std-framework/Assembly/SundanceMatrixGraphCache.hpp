@@ -0,0 +1,120 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_MATRIXGRAPHCACHE_H
+#define SUNDANCE_MATRIXGRAPHCACHE_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceCellFilter.hpp"
+#include "SundanceMap.hpp"
+#include "PlayaMatrixFactory.hpp"
+#include "Teuchos_Array.hpp"
+#include <string>
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * MatrixGraphKey identifies the nonzero pattern of a matrix block. 
+ * DOF maps are built deterministically from the mesh, the functions,
+ * and the regions on which they appear, so two assemblers whose keys 
+ * compare equal produce identical row and column maps and identical
+ * graphs, even though their DOF map objects are distinct.
+ */
+class MatrixGraphKey
+{
+public:
+  /** */
+  MatrixGraphKey(int meshID, 
+    const std::string& vecType,
+    const Array<int>& signature,
+    const Array<CellFilter>& regions)
+    : meshID_(meshID), vecType_(vecType), 
+      signature_(signature), regions_(regions) {}
+
+  /** */
+  bool operator<(const MatrixGraphKey& other) const ;
+
+  /** */
+  int meshID() const {return meshID_;}
+
+private:
+  int meshID_;
+  std::string vecType_;
+  Array<int> signature_;
+  Array<CellFilter> regions_;
+};
+
+/**
+ * MatrixGraphCache holds configured matrix factories, keyed by graph 
+ * structure, so that assemblers for the same mesh, spaces, and 
+ * equation structure (e.g., a Jacobian, a mass matrix, and an adjoint)
+ * can share one Epetra_CrsGraph instead of each building their own.
+ *
+ * The cache holds only weak references. An entry stays usable as long
+ * as some assembler or matrix still holds its factory.
+ */
+class MatrixGraphCache
+{
+public:
+  /** Switch to turn graph sharing on or off */
+  static bool& enabled() {static bool rtn=true; return rtn;}
+
+  /** Return the factory stored for the key, or null if none is live */
+  static RCP<Playa::MatrixFactory<double> > lookup(const MatrixGraphKey& key);
+
+  /** Store a configured factory under the key */
+  static void insert(const MatrixGraphKey& key, 
+    const RCP<Playa::MatrixFactory<double> >& factory);
+
+  /** Remove all entries */
+  static void clear() {table().clear();}
+
+  /** Number of lookups that found a live graph */
+  static int& numHits() {static int rtn=0; return rtn;}
+
+private:
+  static Map<MatrixGraphKey, RCP<Playa::MatrixFactory<double> > >& table();
+};
+}
+
+#endif
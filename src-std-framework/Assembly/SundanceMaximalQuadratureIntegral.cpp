@@ -291,7 +291,8 @@ MaximalQuadratureIntegral::MaximalQuadratureIntegral(
 
 
 void MaximalQuadratureIntegral
-::transformZeroForm(const CellJacobianBatch& JTrans,  
+::transformZeroForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag,
   const Array<int>& facetIndex,
@@ -299,7 +300,7 @@ void MaximalQuadratureIntegral
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(maxCellQuadrature0Timer());
+  IntegrationTimeMonitor timer(maxCellQuadrature0Timer(), ctx);
   Tabs tabs;
   SUNDANCE_MSG1(integrationVerb(), tabs << "doing zero form by quadrature");
 
@@ -384,14 +385,15 @@ void MaximalQuadratureIntegral
 }
 
 
-void MaximalQuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans,  
+void MaximalQuadratureIntegral::transformOneForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(maxCellQuadrature1Timer());
+  IntegrationTimeMonitor timer(maxCellQuadrature1Timer(), ctx);
   Tabs tabs;
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 1, std::logic_error,
     "MaximalQuadratureIntegral::transformOneForm() called for form "
@@ -524,27 +526,28 @@ void MaximalQuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans
   {
     /* If the derivative order is nonzero, then we have to do a transformation. */
     
-    createOneFormTransformationMatrix(JTrans, JVol);
+    createOneFormTransformationMatrix(ctx, JTrans, JVol);
     
     SUNDANCE_MSG4(transformVerb(), 
-      Tabs() << "transformation matrix=" << G(alpha()));
+      Tabs() << "transformation matrix=" << ctx.G(alpha()));
     
-    double* GPtr = &(G(alpha())[0]);      
+    double* GPtr = &(ctx.G(alpha())[0]);      
     
-    transformSummingFirst(JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+    transformSummingFirst(ctx, JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
   }
   addFlops(flops);
 }
 
 
-void MaximalQuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
+void MaximalQuadratureIntegral::transformTwoForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(maxCellQuadrature2Timer());
+  IntegrationTimeMonitor timer(maxCellQuadrature2Timer(), ctx);
   Tabs tabs;
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 2, std::logic_error,
     "MaximalQuadratureIntegral::transformTwoForm() called for form "
@@ -641,36 +644,37 @@ void MaximalQuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans
   }
   else
   {
-    createTwoFormTransformationMatrix(JTrans, JVol);
+    createTwoFormTransformationMatrix(ctx, JTrans, JVol);
     double* GPtr;
 
     if (testDerivOrder() == 0)
     {
-      GPtr = &(G(beta())[0]);
+      GPtr = &(ctx.G(beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(beta()));
+        Tabs() << "transformation matrix=" << ctx.G(beta()));
     }
     else if (unkDerivOrder() == 0)
     {
-      GPtr = &(G(alpha())[0]);
+      GPtr = &(ctx.G(alpha())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(alpha()));
+        Tabs() << "transformation matrix=" << ctx.G(alpha()));
     }
     else
     {
-      GPtr = &(G(alpha(), beta())[0]);
+      GPtr = &(ctx.G(alpha(), beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
         Tabs() << "transformation matrix=" 
-        << G(alpha(),beta()));
+        << ctx.G(alpha(),beta()));
     }
         
       
-    transformSummingFirst(JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+    transformSummingFirst(ctx, JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
   }
 }
 
 void MaximalQuadratureIntegral
-::transformSummingFirst(int nCells,
+::transformSummingFirst(IntegrationContext& ctx,
+  int nCells,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const GPtr,
@@ -693,7 +697,7 @@ void MaximalQuadratureIntegral
   }
 
   /* The sum workspace is used to store the sum of untransformed quantities */
-  static Array<double> sumWorkspace;
+  Array<double>& sumWorkspace = ctx.sumWorkspace();
 
   int swSize = transSize * nNodes();
   sumWorkspace.resize(swSize);
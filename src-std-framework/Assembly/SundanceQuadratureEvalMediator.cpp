@@ -45,6 +45,7 @@
 #include "SundanceCellDiameterExpr.hpp"
 #include "SundanceCellVectorExpr.hpp"
 #include "SundanceSpatialDerivSpecifier.hpp"
+#include "SundanceBasisTabulationCache.hpp"
 #include "SundanceDiscreteFunction.hpp"
 #include "SundanceDiscreteFuncElement.hpp"
 #include "SundanceCellJacobianBatch.hpp"
@@ -75,7 +76,8 @@ QuadratureEvalMediator
     quadPtsForReferenceCell_(),
     quadPtsReferredToMaxCell_(),
     physQuadPts_(),
-    refFacetBasisVals_(2)
+    refFacetBasisVals_(2),
+    quadDescription_(quad.toXML().toString())
 {}
 
 Time& QuadratureEvalMediator::coordEvaluationTimer()
@@ -297,7 +299,7 @@ RCP<Array<Array<Array<double> > > > QuadratureEvalMediator
       tab << "computing basis values on facet quad pts");
     rtn = rcp(new Array<Array<Array<double> > >(numEvaluationCases()));
 
-    Array<Array<Array<Array<double> > > > tmp(nDerivResults);
+    Array<RCP<const BasisTabulation> > tmp(nDerivResults);
     
     if (verb() >= 2)
     {
@@ -337,7 +339,6 @@ RCP<Array<Array<Array<double> > > > QuadratureEvalMediator
 
       for (int r=0; r<nDerivResults; r++)
       {
-        tmp[r].resize(basis.dim());
         MultiIndex mi;
         if (diffOrder==1)
         {
@@ -349,24 +350,22 @@ RCP<Array<Array<Array<double> > > > QuadratureEvalMediator
         if (evalCellType != cellType())
         {
           SUNDANCE_MSG2(verb(), tab1 << "referring to max cell");
-          basis.refEval(evalCellType, 
-            (*(quadPtsReferredToMaxCell_.get(cellType())))[fc], 
-            deriv, tmp[r], verb());
+          tmp[r] = basis.tabulate(evalCellType, quad_, maxCellType(), 
+            cellDim(), fc, deriv, verb());
         }
         else
         {
           SUNDANCE_MSG2(verb(), tab1 << "computing on reference cell");
-          basis.refEval(evalCellType, 
-            (*(quadPtsForReferenceCell_.get(cellType()))), 
-            deriv, tmp[r], verb());
+          tmp[r] = basis.tabulate(evalCellType, quad_, cellType(), 
+            cellDim(), -1, deriv, verb());
         }
       }
-      /* the tmp array contains values indexed as [quad][node]. 
+      /* the tmp tables contain values indexed as [quad][node]. 
        * We need to put this into fortran order with quad index running
        * fastest */
       int dim = maxCellDim();
-      int nQuad = tmp[0][0].size();
-      int nNodes = tmp[0][0][0].size();
+      int nQuad = tmp[0]->numPoints();
+      int nNodes = tmp[0]->numFuncs(0);
       int nTot = dim * nQuad * nNodes;
       for (int d=0; d<basis.dim(); d++)
       {
@@ -377,7 +376,8 @@ RCP<Array<Array<Array<double> > > > QuadratureEvalMediator
           {
             for (int n=0; n<nNodes; n++)
             {
-              (*rtn)[fc][d][(n*nQuad + q)*nDerivResults + r] = tmp[r][d][q][n];
+              (*rtn)[fc][d][(n*nQuad + q)*nDerivResults + r] 
+                = tmp[r]->value(d, q, n);
             }
           }
         }
@@ -898,11 +898,31 @@ void QuadratureEvalMediator::computePhysQuadPts() const
   else
   {
     Tabs tab0(0);
+    bool useCofacets = cellDim() != maxCellDim() 
+      && ElementIntegral::alwaysUseCofacets() && !isInternalBdry();
+
+    /* On a cache hit the points for this batch, quadrature rule, and 
+     * cell type can be copied rather than recomputed */
+    const RCP<GeometryCacheEntry>& entry = geomCacheEntry();
+    std::string key;
+    if (entry.get() != 0)
+    {
+      key = quadDescription_ + "/" + Teuchos::toString((int) cellType()) 
+        + (useCofacets ? "/cofacets" : "");
+      RCP<const Array<Point> > pts = entry->physQuadPts(key);
+      if (pts.get() != 0)
+      {
+        SUNDANCE_MSG2(verb(), tab0 << "reusing cached phys quad points");
+        physQuadPts_ = *pts;
+        cacheIsValid() = true;
+        return;
+      }
+    }
+
     double jFlops = CellJacobianBatch::totalFlops();
     SUNDANCE_MSG2(verb(), tab0 << "computing phys quad points");
     physQuadPts_.resize(0);
-    if (cellDim() != maxCellDim() && ElementIntegral::alwaysUseCofacets()
-      && !isInternalBdry())
+    if (useCofacets)
     {
       Tabs tab1;
       SUNDANCE_MSG2(verb(), tab1 << "using cofacets");
@@ -932,6 +952,12 @@ void QuadratureEvalMediator::computePhysQuadPts() const
     }
     addFlops(CellJacobianBatch::totalFlops() - jFlops);
     cacheIsValid() = true;
+    if (entry.get() != 0)
+    {
+      size_t oldBytes = entry->bytes();
+      entry->setPhysQuadPts(key, physQuadPts_);
+      GeometryCache::entryHasGrown(mesh(), cellDim(), entry, oldBytes);
+    }
     SUNDANCE_OUT(this->verb() > 2, 
       "phys quad: " << physQuadPts_);
   }
@@ -175,6 +175,10 @@ private:
 
   /** */
   mutable Array<Map<OrderedPair<BasisFamily, CellType>, RCP<Array<Array<Array<double> > > > > > refFacetBasisVals_;
+
+  /** Description of the quadrature rule, used to key cached 
+   * physical quadrature points */
+  std::string quadDescription_;
       
 };
 }
@@ -45,6 +45,7 @@
 #include "SundanceOut.hpp"
 #include "PlayaTabs.hpp"
 #include "Teuchos_TimeMonitor.hpp"
+#include <algorithm>
 
 using namespace Sundance;
 using namespace Teuchos;
@@ -85,6 +86,10 @@ static Time& quadrature2Timer()
   return *rtn;
 }
 
+/* Number of cells processed together by the batched quadrature kernels. 
+ * Eight doubles fill one AVX-512 register or two AVX2 registers. */
+static const int cellBatchSize = 8;
+
 
 QuadratureIntegral::QuadratureIntegral(int spatialDim,
   const CellType& maxCellType,
@@ -98,7 +103,7 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
   : QuadratureIntegralBase(spatialDim, maxCellType, dim, cellType, quad, 
     isInternalBdry, globalCurve, mesh, verb),
     W_(),
-    useSumFirstMethod_(true)
+    useSumFirstMethod_(useSumFirstByDefault())
 {
   Tabs tab0(0);
   
@@ -152,7 +157,7 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
   : QuadratureIntegralBase(spatialDim, maxCellType, dim, cellType, 
     testBasis, alpha, testDerivOrder, quad , isInternalBdry, globalCurve , mesh, verb),
     W_(),
-    useSumFirstMethod_(true)
+    useSumFirstMethod_(useSumFirstByDefault())
 {
   Tabs tab0;
   
@@ -189,7 +194,7 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
 
     SUNDANCE_MSG1(setupVerb(), tab2 << "num nodes for test function " << nNodesTest());
 
-    Array<Array<Array<Array<double> > > > testBasisVals(nRefDerivTest());
+    Array<RCP<const BasisTabulation> > testBasisVals(nRefDerivTest());
 
     for (int r=0; r<nRefDerivTest(); r++)
     {
@@ -197,11 +202,9 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
       SUNDANCE_MSG1(setupVerb(), tab3 
         << "evaluating basis functions for ref deriv direction " << r);
       MultiIndex mi;
-      testBasisVals[r].resize(testBasis.dim());
       if (testDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      testBasis.refEval(evalCellType(), quadPts, deriv, 
-        testBasisVals[r], setupVerb());
+      testBasisVals[r] = tabulate(testBasis, quad, fc, deriv);
     }
 
       
@@ -217,8 +220,8 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
         for (int nt=0; nt<nNodesTest(); nt++)
         {
           wValue(fc, q, t, nt) 
-            = chop(quadWeights[q] * testBasisVals[t][vecComp][q][nt]) ;
-          W_ACI_F1_[fc][q][t][nt] = chop(testBasisVals[t][vecComp][q][nt]);
+            = chop(quadWeights[q] * testBasisVals[t]->value(vecComp, q, nt)) ;
+          W_ACI_F1_[fc][q][t][nt] = chop(testBasisVals[t]->value(vecComp, q, nt));
         }
       }
     }
@@ -249,7 +252,7 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
     testBasis, alpha, testDerivOrder, 
     unkBasis, beta, unkDerivOrder, quad , isInternalBdry, globalCurve , mesh , verb),
     W_(),
-    useSumFirstMethod_(true)
+    useSumFirstMethod_(useSumFirstByDefault())
 {
   Tabs tab0;
   
@@ -280,28 +283,24 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
 
 
     /* compute the basis functions */
-    Array<Array<Array<Array<double> > > > testBasisVals(nRefDerivTest());
-    Array<Array<Array<Array<double> > > > unkBasisVals(nRefDerivUnk());
+    Array<RCP<const BasisTabulation> > testBasisVals(nRefDerivTest());
+    Array<RCP<const BasisTabulation> > unkBasisVals(nRefDerivUnk());
 
 
     for (int r=0; r<nRefDerivTest(); r++)
     {
-      testBasisVals[r].resize(testBasis.dim());
       MultiIndex mi;
       if (testDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      testBasis.refEval(evalCellType(), quadPts, deriv, 
-        testBasisVals[r], setupVerb());
+      testBasisVals[r] = tabulate(testBasis, quad, fc, deriv);
     }
 
     for (int r=0; r<nRefDerivUnk(); r++)
     {
-      unkBasisVals[r].resize(unkBasis.dim());
       MultiIndex mi;
       if (unkDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      unkBasis.refEval(evalCellType(), 
-        quadPts, deriv, unkBasisVals[r], setupVerb());
+      unkBasisVals[r] = tabulate(unkBasis, quad, fc, deriv);
     }
 
 
@@ -323,10 +322,10 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
             for (int nu=0; nu<nNodesUnk(); nu++)
             {
               wValue(fc, q, t, nt, u, nu)
-                = chop(quadWeights[q] * testBasisVals[t][vecComp][q][nt] 
-                  * unkBasisVals[u][vecComp][q][nu]);
+                = chop(quadWeights[q] * testBasisVals[t]->value(vecComp, q, nt) 
+                  * unkBasisVals[u]->value(vecComp, q, nu));
               W_ACI_F2_[fc][q][t][nt][u][nu] =
-                chop(testBasisVals[t][vecComp][q][nt] * unkBasisVals[u][vecComp][q][nu]);
+                chop(testBasisVals[t]->value(vecComp, q, nt) * unkBasisVals[u]->value(vecComp, q, nu));
             }
           }
         }
@@ -342,7 +341,8 @@ QuadratureIntegral::QuadratureIntegral(int spatialDim,
 }
 
 
-void QuadratureIntegral::transformZeroForm(const CellJacobianBatch& JTrans,  
+void QuadratureIntegral::transformZeroForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag,
   const Array<int>& facetIndex,
@@ -350,7 +350,7 @@ void QuadratureIntegral::transformZeroForm(const CellJacobianBatch& JTrans,
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(quadrature0Timer());
+  IntegrationTimeMonitor timer(quadrature0Timer(), ctx);
   Tabs tabs;
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 0, std::logic_error,
     "QuadratureIntegral::transformZeroForm() called "
@@ -511,14 +511,15 @@ void QuadratureIntegral::transformZeroForm(const CellJacobianBatch& JTrans,
 }
 
 
-void QuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans,  
+void QuadratureIntegral::transformOneForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(quadrature1Timer());
+  IntegrationTimeMonitor timer(quadrature1Timer(), ctx);
   Tabs tabs;
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 1, std::logic_error,
     "QuadratureIntegral::transformOneForm() called for form "
@@ -638,34 +639,35 @@ void QuadratureIntegral::transformOneForm(const CellJacobianBatch& JTrans,
      * If we're also on a cell of dimension lower than maximal, we need to refer
      * to the facet index of the facet being integrated. */
 
-    createOneFormTransformationMatrix(JTrans, JVol);
+    createOneFormTransformationMatrix(ctx, JTrans, JVol);
 
     SUNDANCE_MSG4(transformVerb(), 
-      Tabs() << "transformation matrix=" << G(alpha()));
+      Tabs() << "transformation matrix=" << ctx.G(alpha()));
 
-    double* GPtr = &(G(alpha())[0]);      
+    double* GPtr = &(ctx.G(alpha())[0]);      
 
     if (useSumFirstMethod())
     {
-      transformSummingFirst(JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+      transformSummingFirst(ctx, JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
     }
     else
     {
-      transformSummingLast(JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+      transformSummingLast(ctx, JVol.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
     }
   }
   addFlops(flops);
 }
 
 
-void QuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
+void QuadratureIntegral::transformTwoForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(quadrature2Timer());
+  IntegrationTimeMonitor timer(quadrature2Timer(), ctx);
   Tabs tabs;
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 2, std::logic_error,
     "QuadratureIntegral::transformTwoForm() called for form "
@@ -754,43 +756,44 @@ void QuadratureIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
   }
   else
   {
-    createTwoFormTransformationMatrix(JTrans, JVol);
+    createTwoFormTransformationMatrix(ctx, JTrans, JVol);
     double* GPtr;
 
     if (testDerivOrder() == 0)
     {
-      GPtr = &(G(beta())[0]);
+      GPtr = &(ctx.G(beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(beta()));
+        Tabs() << "transformation matrix=" << ctx.G(beta()));
     }
     else if (unkDerivOrder() == 0)
     {
-      GPtr = &(G(alpha())[0]);
+      GPtr = &(ctx.G(alpha())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(alpha()));
+        Tabs() << "transformation matrix=" << ctx.G(alpha()));
     }
     else
     {
-      GPtr = &(G(alpha(), beta())[0]);
+      GPtr = &(ctx.G(alpha(), beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
         Tabs() << "transformation matrix=" 
-        << G(alpha(),beta()));
+        << ctx.G(alpha(),beta()));
     }
         
       
     if (useSumFirstMethod())
     {
-      transformSummingFirst(JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+      transformSummingFirst(ctx, JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
     }
     else
     {
-      transformSummingLast(JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
+      transformSummingLast(ctx, JTrans.numCells(), facetIndex, cellLIDs, GPtr, coeff, A);
     }
   }
 }
 
 void QuadratureIntegral
-::transformSummingFirst(int nCells,
+::transformSummingFirst(IntegrationContext& ctx,
+  int nCells,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const GPtr,
@@ -812,7 +815,7 @@ void QuadratureIntegral
   }
 
   /* The sum workspace is used to store the sum of untransformed quantities */
-  static Array<double> sumWorkspace;
+  Array<double>& sumWorkspace = ctx.sumWorkspace();
 
   int swSize = transSize * nNodes();
   sumWorkspace.resize(swSize);
@@ -894,6 +897,10 @@ void QuadratureIntegral
     	    }
     	}// end from for loop over cells
     }
+    else if (useCellBatchedKernels() && nFacetCases()==1)
+    {
+      transformSummingFirstBatched(ctx, nCells, GPtr, coeff, A);
+    }
     else
     {      	    /* ---------- NO ACI logic ----------- */
     	for (int c=0; c<nCells; c++)
@@ -931,7 +938,8 @@ void QuadratureIntegral
 }
 
 void QuadratureIntegral
-::transformSummingLast(int nCells,
+::transformSummingLast(IntegrationContext& ctx,
+  int nCells,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const GPtr,
@@ -953,7 +961,7 @@ void QuadratureIntegral
 
   /* This workspace is used to store the jacobian values scaled by the coeff
    * at that quad point */
-  static Array<double> jWorkspace;
+  Array<double>& jWorkspace = ctx.jWorkspace();
   jWorkspace.resize(transSize);
 
 
@@ -1036,6 +1044,10 @@ void QuadratureIntegral
     	    }
 		}// loop over cells
     }
+    else if (useCellBatchedKernels() && nFacetCases()==1)
+    {
+      transformSummingLastBatched(ctx, nCells, GPtr, coeff, A);
+    }
     else       /* ---------- NO ACI logic ----------- */
     {
        	for (int c=0; c<nCells; c++)
@@ -1063,3 +1075,154 @@ void QuadratureIntegral
   int flops = nCells * nQuad() * transSize * (1 + 2*nNodes()) ;
   addFlops(flops);
 }
+
+
+/*
+ * The batched kernels process cellBatchSize cells at a time. The
+ * coefficients and transformation matrices for a block are first copied
+ * into the batch workspace with the cell index running fastest, padding
+ * the last block with zeros. All inner loops then run over the cells
+ * in the block with a fixed trip count and unit stride, which the 
+ * compiler turns into packed SIMD instructions. Results are scattered
+ * back to the cell-major layout of A only for the cells actually present.
+ */
+
+void QuadratureIntegral
+::transformSummingFirstBatched(IntegrationContext& ctx,
+  int nCells,
+  const double* const GPtr,
+  const double* const coeff,
+  RCP<Array<double> >& A) const
+{
+  const int B = cellBatchSize;
+  double* aPtr = &((*A)[0]);
+  const double* w = &(W_[0][0]);
+
+  int nN = nNodes();
+  int nQ = nQuad();
+  int transSize = nRefDerivTest();
+  if (order()==2) transSize *= nRefDerivUnk();
+  int swSize = transSize * nN;
+
+  Array<double>& ws = ctx.batchWorkspace();
+  ws.resize(B*(nQ + transSize + swSize + 1));
+  double* coeffT = &(ws[0]);
+  double* gT = coeffT + B*nQ;
+  double* sumT = gT + B*transSize;
+  double* accT = sumT + B*swSize;
+
+  for (int c0=0; c0<nCells; c0+=B)
+  {
+    int nb = std::min(B, nCells - c0);
+
+    /* gather coefficients and transformations into cell-fastest order */
+    for (int q=0; q<nQ; q++)
+    {
+      for (int b=0; b<nb; b++) coeffT[B*q + b] = coeff[(c0+b)*nQ + q];
+      for (int b=nb; b<B; b++) coeffT[B*q + b] = 0.0;
+    }
+    for (int j=0; j<transSize; j++)
+    {
+      for (int b=0; b<nb; b++) gT[B*j + b] = GPtr[transSize*(c0+b) + j];
+      for (int b=nb; b<B; b++) gT[B*j + b] = 0.0;
+    }
+
+    /* sum untransformed basis combinations over quad points */
+    for (int i=0; i<B*swSize; i++) sumT[i] = 0.0;
+    for (int q=0; q<nQ; q++)
+    {
+      const double* f = coeffT + B*q;
+      for (int n=0; n<swSize; n++)
+      {
+        double wq = w[n + q*swSize];
+        double* s = sumT + B*n;
+        for (int b=0; b<B; b++) s[b] += wq*f[b];
+      }
+    }
+
+    /* transform the sums */
+    for (int i=0; i<nN; i++)
+    {
+      for (int b=0; b<B; b++) accT[b] = 0.0;
+      for (int j=0; j<transSize; j++)
+      {
+        const double* s = sumT + B*(nN*j + i);
+        const double* g = gT + B*j;
+        for (int b=0; b<B; b++) accT[b] += s[b]*g[b];
+      }
+      for (int b=0; b<nb; b++) aPtr[nN*(c0+b) + i] += accT[b];
+    }
+  }
+}
+
+
+void QuadratureIntegral
+::transformSummingLastBatched(IntegrationContext& ctx,
+  int nCells,
+  const double* const GPtr,
+  const double* const coeff,
+  RCP<Array<double> >& A) const
+{
+  const int B = cellBatchSize;
+  double* aPtr = &((*A)[0]);
+  const double* w = &(W_[0][0]);
+
+  int nN = nNodes();
+  int nQ = nQuad();
+  int transSize = nRefDerivTest();
+  if (order()==2) transSize *= nRefDerivUnk();
+
+  Array<double>& ws = ctx.batchWorkspace();
+  ws.resize(B*(nQ + 2*transSize + nN));
+  double* coeffT = &(ws[0]);
+  double* gT = coeffT + B*nQ;
+  double* jT = gT + B*transSize;
+  double* accT = jT + B*transSize;
+
+  for (int c0=0; c0<nCells; c0+=B)
+  {
+    int nb = std::min(B, nCells - c0);
+
+    /* gather coefficients and transformations into cell-fastest order */
+    for (int q=0; q<nQ; q++)
+    {
+      for (int b=0; b<nb; b++) coeffT[B*q + b] = coeff[(c0+b)*nQ + q];
+      for (int b=nb; b<B; b++) coeffT[B*q + b] = 0.0;
+    }
+    for (int t=0; t<transSize; t++)
+    {
+      for (int b=0; b<nb; b++) gT[B*t + b] = GPtr[transSize*(c0+b) + t];
+      for (int b=nb; b<B; b++) gT[B*t + b] = 0.0;
+    }
+
+    for (int i=0; i<B*nN; i++) accT[i] = 0.0;
+
+    for (int q=0; q<nQ; q++)
+    {
+      /* scale the transformations by the coefficient at this quad point */
+      const double* f = coeffT + B*q;
+      for (int t=0; t<transSize; t++)
+      {
+        const double* g = gT + B*t;
+        double* jt = jT + B*t;
+        for (int b=0; b<B; b++) jt[b] = f[b]*g[b];
+      }
+
+      for (int n=0; n<nN; n++)
+      {
+        double* acc = accT + B*n;
+        for (int t=0; t<transSize; t++)
+        {
+          double wq = w[n + nN*(t + transSize*q)];
+          const double* jt = jT + B*t;
+          for (int b=0; b<B; b++) acc[b] += wq*jt[b];
+        }
+      }
+    }
+
+    for (int n=0; n<nN; n++)
+    {
+      for (int b=0; b<nb; b++) aPtr[nN*(c0+b) + n] += accT[B*n + b];
+    }
+  }
+}
@@ -104,7 +104,8 @@ public:
   virtual ~QuadratureIntegral(){;}
 
   /** */
-  virtual void transformZeroForm(const CellJacobianBatch& JTrans,
+  virtual void transformZeroForm(IntegrationContext& ctx,
+				 const CellJacobianBatch& JTrans,
 				 const CellJacobianBatch& JVol,
 				 const Array<int>& isLocalFlag,
 				 const Array<int>& facetIndex,
@@ -113,7 +114,8 @@ public:
 				 RCP<Array<double> >& A) const ;
       
   /** */
-  virtual void transformTwoForm(const CellJacobianBatch& JTrans,
+  virtual void transformTwoForm(IntegrationContext& ctx,
+				const CellJacobianBatch& JTrans,
 				const CellJacobianBatch& JVol,
 				const Array<int>& facetIndex,
 			    const RCP<Array<int> >& cellLIDs,
@@ -121,18 +123,33 @@ public:
 				RCP<Array<double> >& A) const ;
       
   /** */
-  void transformOneForm(const CellJacobianBatch& JTrans,
+  void transformOneForm(IntegrationContext& ctx,
+			const CellJacobianBatch& JTrans,
 			const CellJacobianBatch& JVol,
 			const Array<int>& facetIndex,
 		    const RCP<Array<int> >& cellLIDs,
 			const double* const coeff,
 			RCP<Array<double> >& A) const ;
 
+  /** Whether to integrate blocks of cells at once, with the cell
+   * index innermost so that the inner loops can be vectorized. The
+   * batched kernels are used only when all cells in a workset
+   * share the same reference integrals, i.e., when there is a single
+   * facet case and no adaptive cell integration. */
+  static bool& useCellBatchedKernels() {static bool rtn = true; return rtn;}
+
+  /** Whether integrals constructed from now on sum reference quantities
+   * over quadrature points before transforming (sum-first), or transform 
+   * at each quadrature point and then sum (sum-last). Sum-first is the 
+   * default. */
+  static bool& useSumFirstByDefault() {static bool rtn = true; return rtn;}
+
 private:
 
   /** Do the integration by summing reference quantities over quadrature
    * points and then transforming the sum to physical quantities.  */
-  void transformSummingFirst(int nCells,
+  void transformSummingFirst(IntegrationContext& ctx,
+    int nCells,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
     const double* const GPtr,
@@ -141,13 +158,30 @@ private:
 
   /** Do the integration by transforming to physical coordinates 
    * at each quadrature point, and then summing */
-  void transformSummingLast(int nCells,
+  void transformSummingLast(IntegrationContext& ctx,
+    int nCells,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
     const double* const GPtr,
     const double* const coeff,
     RCP<Array<double> >& A) const ;
 
+  /** Sum-first integration over blocks of cells, with
+   * coefficients, transformation matrices, and sums stored
+   * cell-index-fastest in the context's batch workspace. */
+  void transformSummingFirstBatched(IntegrationContext& ctx,
+    int nCells,
+    const double* const GPtr,
+    const double* const coeff,
+    RCP<Array<double> >& A) const ;
+
+  /** Sum-last integration over blocks of cells. */
+  void transformSummingLastBatched(IntegrationContext& ctx,
+    int nCells,
+    const double* const GPtr,
+    const double* const coeff,
+    RCP<Array<double> >& A) const ;
+
   /** Determine whether to do this batch of integrals using the
    * sum-first method or the sum-last method */
   bool useSumFirstMethod() const {return useSumFirstMethod_;}
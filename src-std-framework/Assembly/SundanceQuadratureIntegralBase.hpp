@@ -104,7 +104,8 @@ public:
   virtual ~QuadratureIntegralBase(){;}
       
      /** */
-  virtual void transform(const CellJacobianBatch& JTrans,
+  virtual void transform(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetNum,
@@ -112,13 +113,14 @@ public:
     const double* const coeff,
     RCP<Array<double> >& A) const 
     {
-      if (order()==2) transformTwoForm(JTrans, JVol, facetNum, cellLIDs,coeff, A);
-      else if (order()==1) transformOneForm(JTrans, JVol, facetNum, cellLIDs,coeff, A);
-      else transformZeroForm(JTrans, JVol, isLocalFlag, facetNum, cellLIDs,coeff, A);
+      if (order()==2) transformTwoForm(ctx, JTrans, JVol, facetNum, cellLIDs,coeff, A);
+      else if (order()==1) transformOneForm(ctx, JTrans, JVol, facetNum, cellLIDs,coeff, A);
+      else transformZeroForm(ctx, JTrans, JVol, isLocalFlag, facetNum, cellLIDs,coeff, A);
     }
       
   /** */
-  virtual void transformZeroForm(const CellJacobianBatch& JTrans,
+  virtual void transformZeroForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetIndex,
@@ -127,7 +129,8 @@ public:
     RCP<Array<double> >& A) const = 0;
       
   /** */
-  virtual void transformTwoForm(const CellJacobianBatch& JTrans,
+  virtual void transformTwoForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
@@ -135,7 +138,8 @@ public:
     RCP<Array<double> >& A) const = 0;
       
   /** */
-  virtual void transformOneForm(const CellJacobianBatch& JTrans,
+  virtual void transformOneForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
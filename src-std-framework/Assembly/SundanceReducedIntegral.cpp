@@ -46,6 +46,7 @@
 #include "SundanceSpatialDerivSpecifier.hpp"
 #include "SundanceOut.hpp"
 #include "PlayaTabs.hpp"
+#include "SundanceSmallGemm.hpp"
 #include "Teuchos_TimeMonitor.hpp"
 
 using namespace Sundance;
@@ -55,16 +56,6 @@ using std::ios_base;
 using std::setw;
 using std::endl;
 
-extern "C" 
-{
-int dgemm_(const char* transA, const char* transB,
-  const int* M, const int *N, const int* K,
-  const double* alpha, 
-  const double* A, const int* ldA,
-  const double* B, const int* ldB,
-  const double* beta,
-  double* C, const int* ldC);
-}
 
 static Time& reduced0IntegrationTimer() 
 {
@@ -431,7 +422,8 @@ ReducedIntegral::ReducedIntegral(int spatialDim,
 
 
 
-void ReducedIntegral::transformZeroForm(const CellJacobianBatch& JTrans,
+void ReducedIntegral::transformZeroForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag,  
   const Array<int>& facetIndex,
@@ -439,7 +431,7 @@ void ReducedIntegral::transformZeroForm(const CellJacobianBatch& JTrans,
   const double* const coeffs,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(reduced0IntegrationTimer());
+  IntegrationTimeMonitor timer(reduced0IntegrationTimer(), ctx);
 
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 0, std::logic_error,
     "ReducedIntegral::transformZeroForm() called "
@@ -499,14 +491,15 @@ void ReducedIntegral::transformZeroForm(const CellJacobianBatch& JTrans,
   addFlops(flops);
 }
 
-void ReducedIntegral::transformOneForm(const CellJacobianBatch& JTrans,  
+void ReducedIntegral::transformOneForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double* const coeffs,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(reduced1IntegrationTimer());
+  IntegrationTimeMonitor timer(reduced1IntegrationTimer(), ctx);
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 1, std::logic_error,
     "ReducedIntegral::transformOneForm() called for form "
     "of order " << order());
@@ -550,13 +543,12 @@ void ReducedIntegral::transformOneForm(const CellJacobianBatch& JTrans,
      * If we're also on a cell of dimension lower than maximal, we need to refer
      * to the facet index of the facet being integrated. */
     int nCells = JVol.numCells();
-    double one = 1.0;
     int nTransRows = nRefDerivTest();
 
-    createOneFormTransformationMatrix(JTrans, JVol);
+    createOneFormTransformationMatrix(ctx, JTrans, JVol);
 
     SUNDANCE_MSG3(transformVerb(),
-      Tabs() << "transformation matrix=" << G(alpha()));
+      Tabs() << "transformation matrix=" << ctx.G(alpha()));
     int nNodes0 = nNodes();
       
     if (nFacetCases()==1)
@@ -574,9 +566,8 @@ void ReducedIntegral::transformOneForm(const CellJacobianBatch& JTrans,
         for (int c=0; c<JVol.numCells(); c++)
         {
           double* aPtr = &((*A)[c*nNodes0]);
-          ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &(coeffs[c]), &(W_[0][0]),
-            &nNodes0, &(G(alpha())[c*nTransRows]), &nTransRows, &one,
-            aPtr, &nNodes0);
+          SmallGemm::multiply(nNodes0, N, nTransRows, coeffs[c],
+            &(W_[0][0]), &(ctx.G(alpha())[c*nTransRows]), aPtr);
         }
       }
     }
@@ -596,9 +587,8 @@ void ReducedIntegral::transformOneForm(const CellJacobianBatch& JTrans,
           int fc = 0;
           if (nfc != 1) fc = facetIndex[c];
           double* aPtr = &((*A)[c*nNodes0]);
-          ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &(coeffs[c]), &(W_[fc][0]),
-            &nNodes0, &(G(alpha())[c*nTransRows]), &nTransRows, &one,
-            aPtr, &nNodes0);
+          SmallGemm::multiply(nNodes0, N, nTransRows, coeffs[c],
+            &(W_[fc][0]), &(ctx.G(alpha())[c*nTransRows]), aPtr);
         }
       }
     }
@@ -607,14 +597,15 @@ void ReducedIntegral::transformOneForm(const CellJacobianBatch& JTrans,
   }
 }
 
-void ReducedIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
+void ReducedIntegral::transformTwoForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex, 
   const RCP<Array<int> >& cellLIDs,
   const double* const coeffs,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(reduced2IntegrationTimer());
+  IntegrationTimeMonitor timer(reduced2IntegrationTimer(), ctx);
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 2, std::logic_error,
     "ReducedIntegral::transformTwoForm() called for form "
     "of order " << order());
@@ -657,30 +648,29 @@ void ReducedIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
      * If we're also on a cell of dimension lower than maximal, we need to refer
      * to the facet index of the facet being integrated. */
     int nCells = JVol.numCells();
-    double one = 1.0;
     int nTransRows = nRefDerivUnk()*nRefDerivTest();
 
-    createTwoFormTransformationMatrix(JTrans, JVol);
+    createTwoFormTransformationMatrix(ctx, JTrans, JVol);
       
     double* GPtr;
     if (testDerivOrder() == 0)
     {
-      GPtr = &(G(beta())[0]);
+      GPtr = &(ctx.G(beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(beta()));
+        Tabs() << "transformation matrix=" << ctx.G(beta()));
     }
     else if (unkDerivOrder() == 0)
     {
-      GPtr = &(G(alpha())[0]);
+      GPtr = &(ctx.G(alpha())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(alpha()));
+        Tabs() << "transformation matrix=" << ctx.G(alpha()));
     }
     else
     {
-      GPtr = &(G(alpha(), beta())[0]);
+      GPtr = &(ctx.G(alpha(), beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
         Tabs() << "transformation matrix=" 
-        << G(alpha(),beta()));
+        << ctx.G(alpha(),beta()));
     }
       
     int nNodes0 = nNodes();
@@ -704,9 +694,8 @@ void ReducedIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
           SUNDANCE_MSG2(integrationVerb(),
             tabs << "transforming c=" << c << ", W=" << W_[0]);
           
-          ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &(coeffs[c]), &(W_[0][0]),
-            &nNodes0, gPtr, &nTransRows, &one,
-            aPtr, &nNodes0);
+          SmallGemm::multiply(nNodes0, N, nTransRows, coeffs[c],
+            &(W_[0][0]), gPtr, aPtr);
         }
       }
     }
@@ -731,9 +720,8 @@ void ReducedIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
             tabs << "c=" << c << ", facet case=" << fc
             << " W=" << W_[fc]);
 
-          ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &(coeffs[c]), &(W_[fc][0]),
-            &nNodes0, gPtr, &nTransRows, &one,
-            aPtr, &nNodes0);
+          SmallGemm::multiply(nNodes0, N, nTransRows, coeffs[c],
+            &(W_[fc][0]), gPtr, aPtr);
         }
       }
     }// from else of (nFacetCases()==1)
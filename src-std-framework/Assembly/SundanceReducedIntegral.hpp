@@ -105,7 +105,8 @@ public:
   virtual ~ReducedIntegral(){;}
 
   /** */
-  void transform(const CellJacobianBatch& JTrans,
+  void transform(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetNum,
@@ -113,14 +114,15 @@ public:
     const double* const coeffs,
     RCP<Array<double> >& A) const
     {
-      if (order()==2) transformTwoForm(JTrans, JVol, facetNum, cellLIDs, coeffs, A);
-      else if (order()==1) transformOneForm(JTrans, JVol, facetNum, cellLIDs, coeffs, A);
-      else transformZeroForm(JTrans, JVol, isLocalFlag, facetNum,
+      if (order()==2) transformTwoForm(ctx, JTrans, JVol, facetNum, cellLIDs, coeffs, A);
+      else if (order()==1) transformOneForm(ctx, JTrans, JVol, facetNum, cellLIDs, coeffs, A);
+      else transformZeroForm(ctx, JTrans, JVol, isLocalFlag, facetNum,
         cellLIDs, coeffs, A);
     }
 
   /** */
-  virtual void transformZeroForm(const CellJacobianBatch& JTrans,
+  virtual void transformZeroForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetIndex,
@@ -129,7 +131,8 @@ public:
     RCP<Array<double> >& A) const ;
       
   /** */
-  virtual void transformTwoForm(const CellJacobianBatch& JTrans,
+  virtual void transformTwoForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
@@ -137,7 +140,8 @@ public:
     RCP<Array<double> >& A) const ;
       
   /** */
-  void transformOneForm(const CellJacobianBatch& JTrans,
+  void transformOneForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetIndex,
     const RCP<Array<int> >& cellLIDs,
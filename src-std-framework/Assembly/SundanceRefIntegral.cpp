@@ -46,6 +46,7 @@
 #include "SundanceSpatialDerivSpecifier.hpp"
 #include "SundanceOut.hpp"
 #include "PlayaTabs.hpp"
+#include "SundanceSmallGemm.hpp"
 #include "Teuchos_TimeMonitor.hpp"
 
 using namespace Sundance;
@@ -55,16 +56,6 @@ using std::ios_base;
 using std::setw;
 using std::endl;
 
-extern "C" 
-{
-int dgemm_(const char* transA, const char* transB,
-  const int* M, const int *N, const int* K,
-  const double* alpha, 
-  const double* A, const int* ldA,
-  const double* B, const int* ldB,
-  const double* beta,
-  double* C, const int* ldC);
-}
 
 static Time& ref0IntegrationTimer() 
 {
@@ -192,7 +183,7 @@ RefIntegral::RefIntegral(int spatialDim,
     /* initialize values of integrals to zero */
     for (int i=0; i<W_[fc].size(); i++) { W_[fc][i]=0.0; }
 
-    Array<Array<Array<Array<double> > > > testBasisVals(nRefDerivTest());
+    Array<RCP<const BasisTabulation> > testBasisVals(nRefDerivTest());
   
     /* get quadrature points */
 
@@ -207,12 +198,10 @@ RefIntegral::RefIntegral(int spatialDim,
       SUNDANCE_MSG2(setupVerb(), tab2 << "evaluating basis derivative " 
         << r << " of " << nRefDerivTest());
 
-      testBasisVals[r].resize(testBasis.dim());
       MultiIndex mi;
       if (testDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      testBasis.refEval(evalCellType(), quadPts_, deriv,
-        testBasisVals[r], setupVerb());
+      testBasisVals[r] = tabulate(testBasis, quad, fc, deriv);
     }
 
     /* do the quadrature */
@@ -228,8 +217,8 @@ RefIntegral::RefIntegral(int spatialDim,
         for (int nt=0; nt<nNodesTest(); nt++)
         {
           value(fc, t, nt) 
-            += chop(quadWeights_[q] * testBasisVals[t][vecComp][q][nt]) ;
-          W_ACI_F1_[fc][q][t][nt] = chop(testBasisVals[t][vecComp][q][nt]);
+            += chop(quadWeights_[q] * testBasisVals[t]->value(vecComp, q, nt)) ;
+          W_ACI_F1_[fc][q][t][nt] = chop(testBasisVals[t]->value(vecComp, q, nt));
         }
       }
     }    
@@ -338,8 +327,8 @@ RefIntegral::RefIntegral(int spatialDim,
     W_[fc].resize(nRefDerivTest() * nNodesTest()  * nRefDerivUnk() * nNodesUnk());
     for (int i=0; i<W_[fc].size(); i++) W_[fc][i]=0.0;
 
-    Array<Array<Array<Array<double> > > > testBasisVals(nRefDerivTest());
-    Array<Array<Array<Array<double> > > > unkBasisVals(nRefDerivUnk());
+    Array<RCP<const BasisTabulation> > testBasisVals(nRefDerivTest());
+    Array<RCP<const BasisTabulation> > unkBasisVals(nRefDerivUnk());
         
     getQuad(quad, fc, quadPts_, quadWeights_);
     int nQuad = quadPts_.size();
@@ -350,12 +339,10 @@ RefIntegral::RefIntegral(int spatialDim,
       SUNDANCE_MSG2(setupVerb(), tab2 
         << "evaluating test function basis derivative " 
         << r << " of " << nRefDerivTest());
-      testBasisVals[r].resize(testBasis.dim());
       MultiIndex mi;
       if (testDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      testBasis.refEval(evalCellType(), quadPts_, deriv,
-        testBasisVals[r], setupVerb());
+      testBasisVals[r] = tabulate(testBasis, quad, fc, deriv);
     }
 
     for (int r=0; r<nRefDerivUnk(); r++)
@@ -364,12 +351,10 @@ RefIntegral::RefIntegral(int spatialDim,
       SUNDANCE_MSG2(setupVerb(), tab2 
         << "evaluating unknown function basis derivative " 
         << r << " of " << nRefDerivUnk());
-      unkBasisVals[r].resize(unkBasis.dim());
       MultiIndex mi;
       if (unkDerivOrder==1) mi[r] = 1;
       SpatialDerivSpecifier deriv(mi);
-      unkBasis.refEval(evalCellType(), 
-    	quadPts_, deriv, unkBasisVals[r], setupVerb());
+      unkBasisVals[r] = tabulate(unkBasis, quad, fc, deriv);
     }
 
     SUNDANCE_MSG2(setupVerb(), tab1 << "doing quadrature...");
@@ -390,10 +375,10 @@ RefIntegral::RefIntegral(int spatialDim,
             for (int nu=0; nu<nNodesUnk(); nu++)
             {
               value(fc, t, nt, u, nu) 
-                += chop(quadWeights_[q] * testBasisVals[t][vecComp][q][nt]
-                  * unkBasisVals[u][vecComp][q][nu]);
-              W_ACI_F2_[fc][q][t][nt][u][nu] = chop( testBasisVals[t][vecComp][q][nt]
-                                               * unkBasisVals[u][vecComp][q][nu] );
+                += chop(quadWeights_[q] * testBasisVals[t]->value(vecComp, q, nt)
+                  * unkBasisVals[u]->value(vecComp, q, nu));
+              W_ACI_F2_[fc][q][t][nt][u][nu] = chop( testBasisVals[t]->value(vecComp, q, nt)
+                                               * unkBasisVals[u]->value(vecComp, q, nu) );
             }
           }
         }
@@ -455,13 +440,14 @@ RefIntegral::RefIntegral(int spatialDim,
 
 
 
-void RefIntegral::transformZeroForm(const CellJacobianBatch& JVol,
+void RefIntegral::transformZeroForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JVol,
   const Array<int>& isLocalFlag,  
   const RCP<Array<int> >& cellLIDs,
   const double& coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(ref0IntegrationTimer());
+  IntegrationTimeMonitor timer(ref0IntegrationTimer(), ctx);
 
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 0, std::logic_error,
     "RefIntegral::transformZeroForm() called "
@@ -570,14 +556,15 @@ void RefIntegral::transformZeroForm(const CellJacobianBatch& JVol,
   addFlops(flops);
 }
 
-void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,  
+void RefIntegral::transformOneForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,  
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex,
   const RCP<Array<int> >& cellLIDs,
   const double& coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(ref1IntegrationTimer());
+  IntegrationTimeMonitor timer(ref1IntegrationTimer(), ctx);
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 1, std::logic_error,
     "RefIntegral::transformOneForm() called for form "
     "of order " << order());
@@ -659,13 +646,12 @@ void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,
      * If we're also on a cell of dimension lower than maximal, we need to refer
      * to the facet index of the facet being integrated. */
     int nCells = JVol.numCells();
-    double one = 1.0;
     int nTransRows = nRefDerivTest();
 
-    createOneFormTransformationMatrix(JTrans, JVol);
+    createOneFormTransformationMatrix(ctx, JTrans, JVol);
 
     SUNDANCE_MSG3(transformVerb(),
-      Tabs() << "transformation matrix=" << G(alpha()));
+      Tabs() << "transformation matrix=" << ctx.G(alpha()));
     int nNodes0 = nNodes();
       
     if (nFacetCases()==1)
@@ -702,22 +688,19 @@ void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,
     					 //Index formula: nNodesTest()*testDerivDir + testNode
     					 w[nNodesTest()*t + nt] += chop(quadWeightsTmp[q] * W_ACI_F1_[0][q][t][nt]);
     			   }
-   		         ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(w[0]),
-   		            &nNodes0, &(G(alpha())[0]), &nTransRows, &one,
-   		            &(aPtr_tmp[count]), &nNodes0);
+   		         SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+   		           &(w[0]), &(ctx.G(alpha())[0]), &(aPtr_tmp[count]));
     		 }else{
-    		     ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(W_[0][0]),
-    		        &nNodes0, &(G(alpha())[0]), &nTransRows, &one,
-    		        &(aPtr_tmp[count]), &nNodes0);
+    		     SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+    		       &(W_[0][0]), &(ctx.G(alpha())[0]), &(aPtr_tmp[count]));
     		 }
              count += nNodes();
     	 } // end from the for loop over the cells
       }
       else           /* ---------- NO ACI logic----------- */
       {
-      ::dgemm_("N", "N", &nNodes0, &nCells, &nTransRows, &coeff, &(W_[0][0]),
-        &nNodes0, &(G(alpha())[0]), &nTransRows, &one, 
-        &((*A)[0]), &nNodes0);
+      SmallGemm::multiply(nNodes0, nCells, nTransRows, coeff,
+        &(W_[0][0]), &(ctx.G(alpha())[0]), &((*A)[0]));
       }
     }
     else
@@ -752,13 +735,11 @@ void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,
             					//Index formula: nNodesTest()*testDerivDir + testNode
             					w[nNodesTest()*t + nt] += chop(quadWeightsTmp[q] * W_ACI_F1_[fc][q][t][nt]);
             			}
-            		::dgemm_("N", "N", &nNodes0, &N , &nTransRows, &coeff, &(w[0]),
-            				&nNodes0, &(G(alpha())[0]), &nTransRows, &one,
-            				aPtr, &nNodes0);
+            		SmallGemm::multiply(nNodes0, N, nTransRows, coeff,
+            		  &(w[0]), &(ctx.G(alpha())[0]), aPtr);
             	}else{
-            		::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &coeff, &(W_[fc][0]),
-            				&nNodes0, &(G(alpha())[c*nTransRows]), &nTransRows, &one,
-            				aPtr, &nNodes0);
+            		SmallGemm::multiply(nNodes0, N, nTransRows, coeff,
+            		  &(W_[fc][0]), &(ctx.G(alpha())[c*nTransRows]), aPtr);
             	}
             }
         }
@@ -770,9 +751,8 @@ void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,
                 int fc = 0;
                 if (nfc != 1) fc = facetIndex[c];
                 double* aPtr = &((*A)[c*nNodes0]);
-                ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &coeff, &(W_[fc][0]),
-                		&nNodes0, &(G(alpha())[c*nTransRows]), &nTransRows, &one,
-                		aPtr, &nNodes0);
+                SmallGemm::multiply(nNodes0, N, nTransRows, coeff,
+                  &(W_[fc][0]), &(ctx.G(alpha())[c*nTransRows]), aPtr);
             }
         }
     }
@@ -781,14 +761,15 @@ void RefIntegral::transformOneForm(const CellJacobianBatch& JTrans,
   }
 }
 
-void RefIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
+void RefIntegral::transformTwoForm(IntegrationContext& ctx,
+  const CellJacobianBatch& JTrans,
   const CellJacobianBatch& JVol,
   const Array<int>& facetIndex, 
   const RCP<Array<int> >& cellLIDs,
   const double& coeff,
   RCP<Array<double> >& A) const
 {
-  TimeMonitor timer(ref2IntegrationTimer());
+  IntegrationTimeMonitor timer(ref2IntegrationTimer(), ctx);
   TEUCHOS_TEST_FOR_EXCEPTION(order() != 2, std::logic_error,
     "RefIntegral::transformTwoForm() called for form "
     "of order " << order());
@@ -876,30 +857,29 @@ void RefIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
      * If we're also on a cell of dimension lower than maximal, we need to refer
      * to the facet index of the facet being integrated. */
     int nCells = JVol.numCells();
-    double one = 1.0;
     int nTransRows = nRefDerivUnk()*nRefDerivTest();
 
-    createTwoFormTransformationMatrix(JTrans, JVol);
+    createTwoFormTransformationMatrix(ctx, JTrans, JVol);
       
     double* GPtr;
     if (testDerivOrder() == 0)
     {
-      GPtr = &(G(beta())[0]);
+      GPtr = &(ctx.G(beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(beta()));
+        Tabs() << "transformation matrix=" << ctx.G(beta()));
     }
     else if (unkDerivOrder() == 0)
     {
-      GPtr = &(G(alpha())[0]);
+      GPtr = &(ctx.G(alpha())[0]);
       SUNDANCE_MSG2(transformVerb(),
-        Tabs() << "transformation matrix=" << G(alpha()));
+        Tabs() << "transformation matrix=" << ctx.G(alpha()));
     }
     else
     {
-      GPtr = &(G(alpha(), beta())[0]);
+      GPtr = &(ctx.G(alpha(), beta())[0]);
       SUNDANCE_MSG2(transformVerb(),
         Tabs() << "transformation matrix=" 
-        << G(alpha(),beta()));
+        << ctx.G(alpha(),beta()));
     }
       
     int nNodes0 = nNodes();
@@ -945,21 +925,18 @@ void RefIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
        		                    w[nu + nNodesUnk()*nt  + nNodes()*(u + nRefDerivUnk()*t)] +=
        		                    		chop(quadWeightsTmp[q]*W_ACI_F2_[0][q][t][nt][u][nu]);
        		     }
-      		      ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(w[0]),
-      		        &nNodes0, &(gPtr[0]), &nTransRows, &one,
-      		        &(aPtr[0]), &nNodes0);
+      		      SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+      		        &(w[0]), &(gPtr[0]), &(aPtr[0]));
        		  }else{
-       		     ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(W_[0][0]),
-       		        &nNodes0, &(gPtr[0]), &nTransRows, &one,
-       		        &(aPtr[0]), &nNodes0);
+       		     SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+       		       &(W_[0][0]), &(gPtr[0]), &(aPtr[0]));
        		  }
        	 } // end from the for loop over the cells
       }
       else /* ---------- NO ACI ----------- */
       {
-        	 ::dgemm_("N", "N", &nNodes0, &nCells, &nTransRows, &coeff, &(W_[0][0]),
-        		 &nNodes0, GPtr, &nTransRows, &one,
-        		 &((*A)[0]), &nNodes0);
+        	 SmallGemm::multiply(nNodes0, nCells, nTransRows, coeff,
+        	   &(W_[0][0]), GPtr, &((*A)[0]));
       }
     }
     else
@@ -1002,13 +979,11 @@ void RefIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
             						  w[nu + nNodesUnk()*nt  + nNodes()*(u + nRefDerivUnk()*t)] +=
             								  chop( quadWeightsTmp[q]*W_ACI_F2_[fc][q][t][nt][u][nu] );
             	  }
-            	  ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(w[0]),
-            			  &nNodes0, &(gPtr[0]), &nTransRows, &one,
-            			  &(aPtr[0]), &nNodes0);
+            	  SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+            	    &(w[0]), &(gPtr[0]), &(aPtr[0]));
 				  }else{
-					  ::dgemm_("N", "N", &nNodes0, &oneI , &nTransRows, &coeff, &(W_[fc][0]),
-							  &nNodes0, &(gPtr[0]), &nTransRows, &one,
-							  &(aPtr[0]), &nNodes0);
+					  SmallGemm::multiply(nNodes0, oneI, nTransRows, coeff,
+					    &(W_[fc][0]), &(gPtr[0]), &(aPtr[0]));
 				  }
             }
         }
@@ -1025,9 +1000,8 @@ void RefIntegral::transformTwoForm(const CellJacobianBatch& JTrans,
                 tabs << "c=" << c << ", facet case=" << fc
                 << " W=" << W_[fc]);
 
-              ::dgemm_("N", "N", &nNodes0, &N, &nTransRows, &coeff, &(W_[fc][0]),
-            		  &nNodes0, gPtr, &nTransRows, &one,
-            		  aPtr, &nNodes0);
+              SmallGemm::multiply(nNodes0, N, nTransRows, coeff,
+                &(W_[fc][0]), gPtr, aPtr);
             }
         }
     }// from else of (nFacetCases()==1)
@@ -137,7 +137,8 @@ public:
   void print(std::ostream& os) const ;
 
   /** */
-  void transform(const CellJacobianBatch& JTrans,
+  void transform(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const Array<int>& facetNum,
@@ -145,13 +146,14 @@ public:
     const double& coeff,
     RCP<Array<double> >& A) const
     {
-      if (order()==2) transformTwoForm(JTrans, JVol, facetNum, cellLIDs, coeff, A);
-      else if (order()==1) transformOneForm(JTrans, JVol, facetNum, cellLIDs, coeff, A);
-      else transformZeroForm(JVol, isLocalFlag, cellLIDs, coeff, A);
+      if (order()==2) transformTwoForm(ctx, JTrans, JVol, facetNum, cellLIDs, coeff, A);
+      else if (order()==1) transformOneForm(ctx, JTrans, JVol, facetNum, cellLIDs, coeff, A);
+      else transformZeroForm(ctx, JVol, isLocalFlag, cellLIDs, coeff, A);
     }
 
   /** */
-  void transformTwoForm(const CellJacobianBatch& JTrans,
+  void transformTwoForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetNum, 
     const RCP<Array<int> >& cellLIDs,
@@ -159,7 +161,8 @@ public:
     RCP<Array<double> >& A) const ;
 
   /** */
-  void transformOneForm(const CellJacobianBatch& JTrans,
+  void transformOneForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JTrans,
     const CellJacobianBatch& JVol,
     const Array<int>& facetNum, 
     const RCP<Array<int> >& cellLIDs,
@@ -167,7 +170,8 @@ public:
     RCP<Array<double> >& A) const ;
 
   /** */
-  void transformZeroForm(const CellJacobianBatch& JVol,
+  void transformZeroForm(IntegrationContext& ctx,
+    const CellJacobianBatch& JVol,
     const Array<int>& isLocalFlag,
     const RCP<Array<int> >& cellLIDs,
     const double& coeff,
@@ -0,0 +1,142 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceSmallGemm.hpp"
+
+using namespace Sundance;
+
+extern "C" 
+{
+int dgemm_(const char* transA, const char* transB,
+  const int* M, const int *N, const int* K,
+  const double* alpha, 
+  const double* A, const int* ldA,
+  const double* B, const int* ldB,
+  const double* beta,
+  double* C, const int* ldC);
+}
+
+namespace 
+{
+
+/* C += alpha*A*B, with the row count M and inner dimension K fixed
+ * at compile time. */
+template <int M, int K> inline
+void smallGemmKernel(int N, double alpha,
+  const double* A, const double* B, double* C)
+{
+  for (int n=0; n<N; n++)
+  {
+    const double* b = B + K*n;
+    double* c = C + M*n;
+    for (int k=0; k<K; k++)
+    {
+      const double ab = alpha*b[k];
+      const double* a = A + M*k;
+      for (int i=0; i<M; i++) c[i] += a[i]*ab;
+    }
+  }
+}
+
+typedef void (*SmallGemmKernelPtr)(int, double, 
+  const double*, const double*, double*);
+
+/* Node counts for P1 and P2 one-forms and two-forms (including mixed
+ * P1-P2 two-forms) on triangles and tets */
+#define SUNDANCE_SMALLGEMM_CASES_FOR_K(K) \
+  case M_CASE(3, K): return &smallGemmKernel<3, K>; \
+  case M_CASE(4, K): return &smallGemmKernel<4, K>; \
+  case M_CASE(6, K): return &smallGemmKernel<6, K>; \
+  case M_CASE(9, K): return &smallGemmKernel<9, K>; \
+  case M_CASE(10, K): return &smallGemmKernel<10, K>; \
+  case M_CASE(16, K): return &smallGemmKernel<16, K>; \
+  case M_CASE(18, K): return &smallGemmKernel<18, K>; \
+  case M_CASE(36, K): return &smallGemmKernel<36, K>; \
+  case M_CASE(40, K): return &smallGemmKernel<40, K>; \
+  case M_CASE(100, K): return &smallGemmKernel<100, K>;
+
+#define M_CASE(M, K) (16*(M) + (K))
+
+/* Transformation sizes: one derivative in 1, 2, or 3 dimensions, and
+ * two derivatives in 2 or 3 dimensions */
+SmallGemmKernelPtr lookupKernel(int M, int K)
+{
+  if (K >= 16) return 0;
+  switch(M_CASE(M, K))
+  {
+    SUNDANCE_SMALLGEMM_CASES_FOR_K(1)
+    SUNDANCE_SMALLGEMM_CASES_FOR_K(2)
+    SUNDANCE_SMALLGEMM_CASES_FOR_K(3)
+    SUNDANCE_SMALLGEMM_CASES_FOR_K(4)
+    SUNDANCE_SMALLGEMM_CASES_FOR_K(9)
+    default:
+      return 0;
+  }
+}
+
+#undef M_CASE
+#undef SUNDANCE_SMALLGEMM_CASES_FOR_K
+
+}
+
+
+bool SmallGemm::hasSpecializedKernel(int M, int K)
+{
+  return lookupKernel(M, K) != 0;
+}
+
+
+void SmallGemm::multiply(int M, int N, int K, double alpha,
+  const double* A, const double* B, double* C)
+{
+  if (useSpecializedKernels())
+  {
+    SmallGemmKernelPtr kernel = lookupKernel(M, K);
+    if (kernel != 0)
+    {
+      (*kernel)(N, alpha, A, B, C);
+      return;
+    }
+  }
+
+  double one = 1.0;
+  ::dgemm_("N", "N", &M, &N, &K, &alpha, A, &M, B, &K, &one, C, &M);
+}
@@ -0,0 +1,84 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_SMALLGEMM_H
+#define SUNDANCE_SMALLGEMM_H
+
+#include "SundanceDefs.hpp"
+
+namespace Sundance
+{
+
+/**
+ * SmallGemm computes the matrix products used to transform reference
+ * integrals, 
+ * \f[ C \leftarrow C + \alpha A B, \f]
+ * where \f$A\f$ is \f$M\times K\f$, \f$B\f$ is \f$K\times N\f$, and all
+ * matrices are stored densely in column-major order. Here \f$M\f$ is the
+ * number of element nodes, \f$K\f$ the number of transformation
+ * components, and \f$N\f$ the number of cells, often one.
+ *
+ * At these sizes the call overhead of BLAS dgemm dominates the 
+ * arithmetic. For the (M, K) pairs that arise from P1 and P2 Lagrange
+ * bases on triangles and tetrahedra, SmallGemm uses kernels with the
+ * sizes fixed at compile time so that the loops are fully unrolled. 
+ * All other sizes, and all sizes when the specialized kernels are
+ * switched off, are sent to dgemm.
+ */
+class SmallGemm
+{
+public:
+  /** C += alpha*A*B with A MxK, B KxN, C MxN, all column-major
+   * with leading dimensions M, K, and M respectively. */
+  static void multiply(int M, int N, int K, double alpha,
+    const double* A, const double* B, double* C);
+
+  /** Whether to use the compile-time specialized kernels when they
+   * are available. If false, every product is done with dgemm. */
+  static bool& useSpecializedKernels() {static bool rtn = true; return rtn;}
+
+  /** Whether a specialized kernel exists for the given sizes */
+  static bool hasSpecializedKernel(int M, int K);
+};
+
+}
+
+#endif
@@ -75,6 +75,9 @@ StdFwkEvalMediator::StdFwkEvalMediator(const Mesh& mesh, int cellDim)
     cofacetCellsAreReady_(false),
     cacheIsValid_(false),
     jCacheIsValid_(false),
+    geomEntry_(),
+    jVolIsShared_(false),
+    cofacetDataIsShared_(false),
     fCache_(),
     dfCache_(),
     localValueCache_(),
@@ -118,8 +121,29 @@ void StdFwkEvalMediator::setCellBatch(
   jCacheIsValid_=false;
   cofacetCellsAreReady_ = false;
 
-  SUNDANCE_MSG2(verb(), tab1 << "getting volume Jacobians");
-  mesh_.getJacobians(cellDim(), *cellLID, *JVol_);
+  bool useCache = GeometryCache::isEnabled(mesh_);
+  geomEntry_ = RCP<GeometryCacheEntry>();
+  if (useCache) geomEntry_ = GeometryCache::lookup(mesh_, cellDim(), *cellLID);
+
+  if (geomEntry_.get() != 0)
+  {
+    SUNDANCE_MSG2(verb(), tab1 << "reusing cached volume Jacobians");
+    JVol_ = geomEntry_->JVol();
+    jVolIsShared_ = true;
+  }
+  else
+  {
+    SUNDANCE_MSG2(verb(), tab1 << "getting volume Jacobians");
+    if (jVolIsShared_ || useCache) JVol_ = rcp(new CellJacobianBatch());
+    jVolIsShared_ = false;
+    mesh_.getJacobians(cellDim(), *cellLID, *JVol_);
+    if (useCache)
+    {
+      geomEntry_ = rcp(new GeometryCacheEntry(*cellLID, JVol_));
+      GeometryCache::insert(mesh_, cellDim(), geomEntry_);
+      jVolIsShared_ = true;
+    }
+  }
   if (intCellSpec_!=NoTermsNeedCofacets) setupFacetTransformations();
 
   /* mark the function caches as invalid */
@@ -151,6 +175,25 @@ void StdFwkEvalMediator::setupFacetTransformations() const
   SUNDANCE_MSG2(verb(), tab1 << "cell dim = " << cellDim());
   SUNDANCE_MSG2(verb(), tab1 << "num d-cells in mesh = " << mesh_.numCells(cellDim()));
   
+  if (geomEntry_.get() != 0 && geomEntry_->hasCofacetData())
+  {
+    SUNDANCE_MSG2(verb(), tab1 << "reusing cached facet transformations");
+    JTrans_ = geomEntry_->JTrans();
+    facetIndices_ = geomEntry_->facetIndices();
+    maxCellLIDs_ = geomEntry_->maxCellLIDs();
+    cofacetDataIsShared_ = true;
+    cofacetCellsAreReady_ = true;
+    return;
+  }
+
+  if (cofacetDataIsShared_ || geomEntry_.get() != 0)
+  {
+    JTrans_ = rcp(new CellJacobianBatch());
+    facetIndices_ = rcp(new Array<int>());
+    maxCellLIDs_ = rcp(new Array<int>());
+  }
+  cofacetDataIsShared_ = false;
+
 
   facetIndices_->resize(cells.size());
   maxCellLIDs_->resize(cells.size());
@@ -167,6 +210,14 @@ void StdFwkEvalMediator::setupFacetTransformations() const
 
   SUNDANCE_MSG2(verb(), tab1 << "getting facet Jacobians");
   mesh_.getJacobians(mesh_.spatialDim(), *maxCellLIDs_, *JTrans_);
+
+  if (geomEntry_.get() != 0)
+  {
+    size_t oldBytes = geomEntry_->bytes();
+    geomEntry_->setCofacetData(JTrans_, facetIndices_, maxCellLIDs_);
+    GeometryCache::entryHasGrown(mesh_, cellDim(), geomEntry_, oldBytes);
+    cofacetDataIsShared_ = true;
+  }
   SUNDANCE_MSG2(verb(), tab << "setting up facet transformations");
 }
 
@@ -49,6 +49,7 @@
 #include "SundanceIntegralGroup.hpp"
 #include "SundanceObjectWithVerbosity.hpp"
 #include "SundanceDiscreteFunction.hpp"
+#include "SundanceGeometryCache.hpp"
 
 
 namespace Sundance
@@ -141,6 +142,10 @@ protected:
 
   bool& cacheIsValid() const {return cacheIsValid_;}
 
+  /** The geometry cache entry for the current cell batch, or null
+   * if geometry caching is off for this mesh */
+  const RCP<GeometryCacheEntry>& geomCacheEntry() const {return geomEntry_;}
+
   /** */
   void setupFacetTransformations() const ;
 
@@ -192,6 +197,11 @@ private:
   mutable bool cacheIsValid_;
 
   mutable bool jCacheIsValid_;
+  RCP<GeometryCacheEntry> geomEntry_;
+  /* Whether JVol_ and the cofacet data are held by the geometry cache,
+   * in which case they must not be overwritten */
+  bool jVolIsShared_;
+  mutable bool cofacetDataIsShared_;
 
 
 
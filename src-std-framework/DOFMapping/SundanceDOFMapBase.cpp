@@ -44,8 +44,10 @@
 #include "SundanceOut.hpp"
 #include "SundanceOrderedTuple.hpp"
 #include "SundanceDOFMapBase.hpp"
+#include "SundanceRCMReorderer.hpp"
 #include "PlayaMPIContainerComm.hpp"
 #include "Teuchos_TimeMonitor.hpp"
+#include <algorithm>
 
 using namespace Sundance;
 using namespace Teuchos;
@@ -87,6 +89,13 @@ void DOFMapBase::getDOFsForCell(int cellDim, int cellLID,
   }
 }
 
+Time& DOFMapBase::dofRenumberingTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("DOF renumbering"); 
+  return *rtn;
+}
+
 Time& DOFMapBase::dofLookupTimer() 
 {
   static RCP<Time> rtn 
@@ -101,3 +110,44 @@ Time& DOFMapBase::batchedDofLookupTimer()
   return *rtn;
 }
 
+
+void DOFMapBase::computeBlockRenumbering(int nBlocks, 
+  const Array<int>& elemPtr, const Array<int>& elemBlocks,
+  Array<int>& blockOrder)
+{
+  TimeMonitor timer(dofRenumberingTimer());
+
+  /* gather the distinct neighbors of each block */
+  Array<Array<int> > nbrs(nBlocks);
+  int nElems = elemPtr.size() - 1;
+  for (int e=0; e<nElems; e++)
+  {
+    for (int i=elemPtr[e]; i<elemPtr[e+1]; i++)
+    {
+      int a = elemBlocks[i];
+      if (a < 0) continue;
+      for (int j=elemPtr[e]; j<elemPtr[e+1]; j++)
+      {
+        int b = elemBlocks[j];
+        if (b < 0 || b == a) continue;
+        nbrs[a].append(b);
+      }
+    }
+  }
+
+  Array<int> ptr(nBlocks+1);
+  Array<int> adj;
+  ptr[0] = 0;
+  for (int a=0; a<nBlocks; a++)
+  {
+    Array<int>& n = nbrs[a];
+    std::sort(n.begin(), n.end());
+    for (int k=0; k<n.size(); k++)
+    {
+      if (k==0 || n[k] != n[k-1]) adj.append(n[k]);
+    }
+    ptr[a+1] = adj.size();
+  }
+
+  reverseCuthillMcKee(ptr, adj, blockOrder);
+}
@@ -339,6 +339,14 @@ public:
 
 
   int setupVerb() const {return setupVerb_;}
+
+  /** 
+   * When true, maps that support it renumber their locally owned DOFs
+   * in reverse Cuthill-McKee order before ghost DOFs are exchanged. 
+   * All DOFs attached to a single node, edge, face, or cell are kept 
+   * together, so functions stay interleaved node by node.
+   */
+  static bool& useRCMRenumbering() {static bool rtn=false; return rtn;}
 protected:
 
   void setLowestLocalDOF(int low) {lowestLocalDOF_ = low;}
@@ -355,6 +363,20 @@ protected:
 
   static Teuchos::Time& batchedDofLookupTimer() ;
 
+  static Teuchos::Time& dofRenumberingTimer() ;
+
+  /** 
+   * Compute a reverse Cuthill-McKee ordering of nBlocks DOF blocks,
+   * where two blocks are adjacent if they appear together in some 
+   * element. The blocks of element e are 
+   * elemBlocks[elemPtr[e]] through elemBlocks[elemPtr[e+1]-1]; negative
+   * entries (e.g., blocks owned by another processor) are ignored. 
+   * On return, blockOrder[k] is the block to be numbered k-th.
+   */
+  static void computeBlockRenumbering(int nBlocks, 
+    const Array<int>& elemPtr, const Array<int>& elemBlocks,
+    Array<int>& blockOrder) ;
+
 
 
 private:
@@ -393,6 +393,8 @@ void MixedDOFMap::initMap()
    * processors */
 
   int numLocalDOFs = nextDOF;
+  if (useRCMRenumbering()) renumberLocalDOFs(numLocalDOFs);
+
   if (mesh().comm().getNProc() > 1)
   {
     for (int d=0; d<=dim_; d++)
@@ -413,6 +415,82 @@ void MixedDOFMap::initMap()
   SUNDANCE_MSG1(setupVerb(), tab << "done initializing DOF map");
 }
 
+void MixedDOFMap::renumberLocalDOFs(int localCount)
+{
+  Tabs tab;
+  SUNDANCE_MSG1(setupVerb(), tab << "renumbering local DOFs");
+
+  /* Each locally owned cell carrying DOFs is a block. Since ghost DOFs
+   * haven't been requested yet, a cell is locally owned exactly when 
+   * its DOFs have been set. */
+  Array<Array<int> > blockOf(dim_+1);
+  Array<int> blockDim;
+  Array<int> blockLID;
+  for (int d=0; d<=dim_; d++)
+  {
+    if (!cellHasAnyDOFs_[d]) continue;
+    int nCells = mesh().numCells(d);
+    blockOf[d].resize(nCells);
+    for (int c=0; c<nCells; c++)
+    {
+      blockOf[d][c] = -1;
+      for (int b=0; b<nBasisChunks(); b++)
+      {
+        if (nDofsPerCell_[b][d] == 0) continue;
+        if (getInitialDOFForCell(d, c, b) >= 0) 
+        {
+          blockOf[d][c] = blockDim.size();
+          blockDim.append(d);
+          blockLID.append(c);
+        }
+        break;
+      }
+    }
+  }
+
+  /* list the blocks touched by each maximal cell */
+  Array<int> elemPtr;
+  Array<int> elemBlocks;
+  Array<int> facetLID;
+  Array<int> facetOrientations;
+  elemPtr.append(0);
+  CellSet cells = maxCells_.getCells(mesh());
+  for (CellIterator iter=cells.begin(); iter != cells.end(); iter++)
+  {
+    int cellLID = *iter;
+    if (cellHasAnyDOFs_[dim_]) elemBlocks.append(blockOf[dim_][cellLID]);
+    for (int d=0; d<dim_; d++)
+    {
+      if (!cellHasAnyDOFs_[d]) continue;
+      int nf = numFacets_[dim_][d];
+      facetLID.resize(nf);
+      facetOrientations.resize(nf);
+      mesh().getFacetArray(dim_, cellLID, d, facetLID, facetOrientations);
+      for (int f=0; f<nf; f++) elemBlocks.append(blockOf[d][facetLID[f]]);
+    }
+    elemPtr.append(elemBlocks.size());
+  }
+
+  Array<int> blockOrder;
+  computeBlockRenumbering(blockDim.size(), elemPtr, elemBlocks, blockOrder);
+
+  /* reassign DOFs block by block in the new order */
+  int nextDOF = 0;
+  for (int k=0; k<blockOrder.size(); k++)
+  {
+    int d = blockDim[blockOrder[k]];
+    int c = blockLID[blockOrder[k]];
+    for (int b=0; b<nBasisChunks(); b++)
+    {
+      setDOFs(b, d, c, nextDOF);
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(nextDOF != localCount, std::logic_error,
+    "DOF count changed from " << localCount << " to " << nextDOF
+    << " during renumbering");
+}
+
+
 void MixedDOFMap::shareDOFs(int cellDim,
   const Array<Array<int> >& outgoingCellRequests)
 {
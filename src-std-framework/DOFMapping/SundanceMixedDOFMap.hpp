@@ -158,6 +158,11 @@ private:
   /** */
   void computeOffsets(int dim, int localCount);
 
+  /** Renumber the locally owned DOFs in RCM order, keeping the DOFs
+   * of each cell contiguous. Must be called before offsets are applied
+   * and remote DOFs are requested. */
+  void renumberLocalDOFs(int localCount);
+
   /** */
   static int uninitializedVal() {return -1;}
 
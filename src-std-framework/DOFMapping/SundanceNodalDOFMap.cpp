@@ -216,8 +216,11 @@ void NodalDOFMap::init()
     }
 
   
-  /* Compute offsets for each processor */
+  /* Optionally renumber the local nodes for bandwidth */
   int localCount = nextDOF;
+  if (useRCMRenumbering()) renumberLocalDOFs(facetLID, localCount);
+
+  /* Compute offsets for each processor */
   computeOffsets(localCount);
   
   /* Resolve remote DOF numbers */
@@ -241,6 +244,42 @@ void NodalDOFMap::init()
 }
 
 
+void NodalDOFMap::renumberLocalDOFs(const Array<int>& facetLID, 
+  int localCount)
+{
+  Tabs tab;
+  SUNDANCE_MSG1(setupVerb(), tab << "renumbering local nodal DOFs");
+
+  /* Local DOFs were assigned node by node, so the DOFs of the 
+   * k-th local node are k*nFuncs_ through (k+1)*nFuncs_-1 */
+  int nLocalNodes = localCount / nFuncs_;
+  int nFacets = mesh().numFacets(dim_, 0, 0);
+
+  Array<int> elemPtr(nElems_+1);
+  Array<int> elemNodes(nElems_*nFacets);
+  for (int c=0; c<=nElems_; c++) elemPtr[c] = c*nFacets;
+  for (int i=0; i<elemNodes.size(); i++)
+  {
+    int dof = nodeDofs_[facetLID[i]*nFuncs_];
+    elemNodes[i] = (dof >= 0) ? dof/nFuncs_ : -1;
+  }
+
+  Array<int> nodeOrder;
+  computeBlockRenumbering(nLocalNodes, elemPtr, elemNodes, nodeOrder);
+
+  Array<int> newPos(nLocalNodes);
+  for (int k=0; k<nLocalNodes; k++) newPos[nodeOrder[k]] = k;
+
+  for (int n=0; n<nNodes_; n++)
+  {
+    int dof = nodeDofs_[n*nFuncs_];
+    if (dof < 0) continue;
+    int k = newPos[dof/nFuncs_];
+    for (int i=0; i<nFuncs_; i++) nodeDofs_[n*nFuncs_ + i] = k*nFuncs_ + i;
+  }
+}
+
+
 void NodalDOFMap::computeOffsets(int localCount)
 {
   Array<int> dofOffsets;
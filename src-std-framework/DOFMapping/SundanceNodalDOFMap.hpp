@@ -89,6 +89,10 @@ protected:
 
   void computeOffsets(int localCount)  ;
 
+  /** Renumber the locally owned nodes in RCM order, given the 
+   * element-to-node table. Must be called before offsets are applied. */
+  void renumberLocalDOFs(const Array<int>& facetLID, int localCount);
+
   void shareRemoteDOFs(const Array<Array<int> >& remoteNodes);
 
   CellFilter maxCellFilter_;
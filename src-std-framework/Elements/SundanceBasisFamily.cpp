@@ -48,6 +48,7 @@
 #include "SundanceDiscreteFunctionData.hpp"
 #include "SundanceLagrange.hpp"
 #include "SundanceEdgeLocalizedBasis.hpp"
+#include "SundanceBasisTabulationCache.hpp"
 
 
 using namespace Sundance;
@@ -217,6 +218,41 @@ void BasisFamily::refEval(
 }
 
 
+RCP<const BasisTabulation> BasisFamily::tabulate(
+  const CellType& evalCellType,
+  const QuadratureFamily& quad,
+  const CellType& quadCellType,
+  int facetDim,
+  int facetIndex,
+  const SpatialDerivSpecifier& deriv,
+  int verbosity) const
+{
+  bool useCache = BasisTabulationCache::enabled();
+  BasisTabulationKey key(*this, evalCellType, deriv, quad, quadCellType,
+    facetDim, facetIndex);
+  RCP<const BasisTabulation> rtn;
+  if (useCache) rtn = BasisTabulationCache::lookup(key);
+  if (rtn.get() == 0)
+  {
+    Array<Point> pts;
+    Array<double> wgts;
+    if (facetIndex < 0) 
+    {
+      quad.getPoints(quadCellType, pts, wgts);
+    }
+    else 
+    {
+      quad.getFacetPoints(quadCellType, facetDim, facetIndex, pts, wgts);
+    }
+    Array<Array<Array<double> > > vals;
+    ptr()->refEval(evalCellType, pts, deriv, vals, verbosity);
+    rtn = rcp(new BasisTabulation(vals));
+    if (useCache) BasisTabulationCache::insert(key, rtn);
+  }
+  return rtn;
+}
+
+
 namespace Sundance
 {
 
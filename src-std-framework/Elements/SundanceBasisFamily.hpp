@@ -54,6 +54,8 @@ using Teuchos::tuple;
 using Teuchos::Array;
 
 class CommonFuncDataStub;
+class BasisTabulation;
+class QuadratureFamily;
 
 /** 
  * BasisFamily is the user-level handle class for specifying the basis with
@@ -147,6 +149,20 @@ public:
     Array<Array<Array<double> > >& result,
     int verbosity) const ;
 
+  /** Return the values of the basis, or of a derivative, on 
+   * evalCellType at the points of a quadrature rule as a contiguous 
+   * table. The points are those of quad on quadCellType or, if 
+   * facetIndex is not negative, on the given facet of quadCellType. 
+   * Tabulations are shared through the BasisTabulationCache. */
+  RCP<const BasisTabulation> tabulate(
+    const CellType& evalCellType,
+    const QuadratureFamily& quad,
+    const CellType& quadCellType,
+    int facetDim,
+    int facetIndex,
+    const SpatialDerivSpecifier& deriv,
+    int verbosity) const ;
+
   /**  */
   void getConstrainsForHNDoF( const int indexInParent,
 			      const int maxCellDim,
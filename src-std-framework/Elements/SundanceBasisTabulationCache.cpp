@@ -0,0 +1,169 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceBasisTabulationCache.hpp"
+#include <typeinfo>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+
+BasisTabulation::BasisTabulation(const Array<Array<Array<double> > >& vals)
+  : numPts_(0), numFuncs_(vals.size()), offset_(vals.size()), data_()
+{
+  if (vals.size() > 0) numPts_ = vals[0].size();
+
+  int total = 0;
+  for (int k=0; k<vals.size(); k++)
+  {
+    TEUCHOS_TEST_FOR_EXCEPTION(vals[k].size() != numPts_, std::logic_error,
+      "inconsistent number of points in basis tabulation: component "
+      << k << " has " << vals[k].size() << ", expected " << numPts_);
+    numFuncs_[k] = 0;
+    if (numPts_ > 0) numFuncs_[k] = vals[k][0].size();
+    offset_[k] = total;
+    total += numPts_ * numFuncs_[k];
+  }
+  
+  data_.resize(total);
+  for (int k=0; k<vals.size(); k++)
+  {
+    double* x = &(data_[offset_[k]]);
+    for (int q=0; q<numPts_; q++)
+    {
+      const Array<double>& v = vals[k][q];
+      TEUCHOS_TEST_FOR_EXCEPTION(v.size() != numFuncs_[k], std::logic_error,
+        "inconsistent number of functions in basis tabulation: component "
+        << k << " point " << q << " has " << v.size() 
+        << ", expected " << numFuncs_[k]);
+      for (int n=0; n<numFuncs_[k]; n++) x[q*numFuncs_[k] + n] = v[n];
+    }
+  }
+}
+
+
+BasisTabulationKey::BasisTabulationKey(const BasisFamily& basis, 
+  const CellType& evalCellType,
+  const SpatialDerivSpecifier& deriv, const QuadratureFamily& quad,
+  const CellType& quadCellType, int facetDim, int facetIndex)
+  : basis_(basis), evalCellType_(evalCellType), deriv_(deriv), 
+    quad_(quad), quadCellType_(quadCellType), 
+    facetDim_(facetIndex < 0 ? -1 : facetDim), facetIndex_(facetIndex)
+{}
+
+
+bool BasisTabulationKey::operator<(const BasisTabulationKey& other) const 
+{
+  if (basis_ < other.basis_) return true;
+  if (other.basis_ < basis_) return false;
+  if (evalCellType_ != other.evalCellType_) 
+    return evalCellType_ < other.evalCellType_;
+  if (deriv_ < other.deriv_) return true;
+  if (other.deriv_ < deriv_) return false;
+  if (quadCellType_ != other.quadCellType_) 
+    return quadCellType_ < other.quadCellType_;
+  if (facetDim_ != other.facetDim_) return facetDim_ < other.facetDim_;
+  if (facetIndex_ != other.facetIndex_) 
+    return facetIndex_ < other.facetIndex_;
+
+  /* compare rules as an ordered handle would: by type, then by 
+   * lessThan() */
+  const QuadratureFamilyStub* me = quad_.ptr().get();
+  const QuadratureFamilyStub* you = other.quad_.ptr().get();
+  if (typeid(*me).before(typeid(*you))) return true;
+  if (typeid(*you).before(typeid(*me))) return false;
+  return me->lessThan(you);
+}
+
+
+RCP<const BasisTabulation> 
+BasisTabulationCache::lookup(const BasisTabulationKey& key)
+{
+  RCP<const BasisTabulation> rtn;
+#ifdef _OPENMP
+#pragma omp critical (BasisTabulationCache)
+#endif
+  {
+    if (table().containsKey(key)) 
+    {
+      rtn = table().get(key);
+      numHits()++;
+    }
+    else
+    {
+      numMisses()++;
+    }
+  }
+  return rtn;
+}
+
+
+void BasisTabulationCache::insert(const BasisTabulationKey& key,
+  const RCP<const BasisTabulation>& tab)
+{
+#ifdef _OPENMP
+#pragma omp critical (BasisTabulationCache)
+#endif
+  {
+    if (!table().containsKey(key))
+    {
+      while (age().size() > 0 && (int) age().size() >= maxEntries())
+      {
+        table().erase(age().front());
+        age().pop_front();
+      }
+      age().push_back(key);
+    }
+    table().put(key, tab);
+  }
+}
+
+
+void BasisTabulationCache::clear()
+{
+#ifdef _OPENMP
+#pragma omp critical (BasisTabulationCache)
+#endif
+  {
+    table().clear();
+    age().clear();
+  }
+}
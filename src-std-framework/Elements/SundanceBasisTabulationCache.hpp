@@ -0,0 +1,174 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_BASISTABULATIONCACHE_H
+#define SUNDANCE_BASISTABULATIONCACHE_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceBasisFamily.hpp"
+#include "SundanceQuadratureFamily.hpp"
+#include "SundanceSpatialDerivSpecifier.hpp"
+#include "SundanceAlignedBuffer.hpp"
+#include "SundanceMap.hpp"
+#include "Teuchos_Array.hpp"
+#include <deque>
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * BasisTabulation holds the values of a basis, or of one of its 
+ * derivatives, at a set of points on a reference cell. The values
+ * for each vector component are stored contiguously in an aligned
+ * block, point-major: the value of function \f$n\f$ at point \f$q\f$
+ * of component \f$k\f$ is at values(k)[q*numFuncs(k) + n].
+ */
+class BasisTabulation : public Noncopyable
+{
+public:
+  /** Create a tabulation from values in the layout produced by 
+   * BasisFamily::refEval(), result[comp][pt][func] */
+  BasisTabulation(const Array<Array<Array<double> > >& vals);
+
+  /** */
+  int numComponents() const {return numFuncs_.size();}
+
+  /** */
+  int numPoints() const {return numPts_;}
+
+  /** */
+  int numFuncs(int comp) const {return numFuncs_[comp];}
+
+  /** Values of component comp */
+  const double* values(int comp) const {return &(data_[offset_[comp]]);}
+
+  /** Value of function n of component comp at point q */
+  double value(int comp, int q, int n) const 
+    {return data_[offset_[comp] + q*numFuncs_[comp] + n];}
+
+private:
+  int numPts_;
+  Array<int> numFuncs_;
+  Array<int> offset_;
+  AlignedBuffer data_;
+};
+
+/**
+ * BasisTabulationKey identifies a tabulation by basis, evaluation cell
+ * type, derivative, and the quadrature points it was made on. The 
+ * points are named by the rule that generates them: the rule's type
+ * and lessThan() ordering, the cell type the rule was applied to, and,
+ * for points on a facet, the facet's dimension and index.
+ */
+class BasisTabulationKey
+{
+public:
+  /** Key for points on a whole cell (facetIndex < 0) or on facet 
+   * facetIndex of dimension facetDim of quadCellType */
+  BasisTabulationKey(const BasisFamily& basis, const CellType& evalCellType,
+    const SpatialDerivSpecifier& deriv, const QuadratureFamily& quad,
+    const CellType& quadCellType, int facetDim, int facetIndex);
+
+  /** */
+  bool operator<(const BasisTabulationKey& other) const ;
+
+private:
+  BasisFamily basis_;
+  CellType evalCellType_;
+  SpatialDerivSpecifier deriv_;
+  QuadratureFamily quad_;
+  CellType quadCellType_;
+  int facetDim_;
+  int facetIndex_;
+};
+
+/**
+ * BasisTabulationCache is a process-wide store of reference basis
+ * values at quadrature points, so that the integrals and evaluation
+ * mediators built during assembler setup evaluate each basis on a 
+ * given rule only once. This matters for high-order bases, whose 
+ * reference evaluation dominates setup time. Only quadrature point 
+ * sets are cached; evaluation at arbitrary points goes through 
+ * BasisFamily::refEval() uncached. The number of entries is bounded
+ * by maxEntries(), with the oldest entry dropped first.
+ */
+class BasisTabulationCache
+{
+public:
+  /** Whether BasisFamily::tabulate() consults the cache */
+  static bool& enabled() {static bool rtn=true; return rtn;}
+
+  /** Maximum number of tabulations kept */
+  static int& maxEntries() {static int rtn=256; return rtn;}
+
+  /** Return the tabulation for the given key, or null */
+  static RCP<const BasisTabulation> lookup(const BasisTabulationKey& key);
+
+  /** Store a tabulation, evicting the oldest entries if the cache
+   * is full */
+  static void insert(const BasisTabulationKey& key,
+    const RCP<const BasisTabulation>& tab);
+
+  /** Remove all entries */
+  static void clear() ;
+
+  /** */
+  static int numEntries() {return (int) table().size();}
+
+  /** */
+  static int& numHits() {static int rtn=0; return rtn;}
+
+  /** */
+  static int& numMisses() {static int rtn=0; return rtn;}
+
+private:
+  static Map<BasisTabulationKey, RCP<const BasisTabulation> >& table() 
+    {static Map<BasisTabulationKey, RCP<const BasisTabulation> > rtn; 
+      return rtn;}
+
+  /** Keys in order of insertion */
+  static std::deque<BasisTabulationKey>& age() 
+    {static std::deque<BasisTabulationKey> rtn; return rtn;}
+};
+}
+
+#endif
@@ -59,6 +59,17 @@ XMLObject PolygonQuadrature::toXML() const
   return rtn;
 }
 
+bool PolygonQuadrature::lessThan(const QuadratureFamilyStub* other) const 
+{
+  const PolygonQuadrature* p = dynamic_cast<const PolygonQuadrature*>(other);
+  if (p == 0) return QuadratureFamilyBase::lessThan(other);
+  const QuadratureFamilyStub* me = quad_.ptr().get();
+  const QuadratureFamilyStub* you = p->quad_.ptr().get();
+  if (typeid(*me).before(typeid(*you))) return true;
+  if (typeid(*you).before(typeid(*me))) return false;
+  return me->lessThan(you);
+}
+
 
 
 void PolygonQuadrature::getLineRule(Array<Point>& quadPoints,
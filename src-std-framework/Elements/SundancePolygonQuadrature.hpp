@@ -79,6 +79,9 @@ public:
     {return "PolygonQuadrature[order=" + Teuchos::toString(order())
         +  "]";}
 
+  /** Rules of equal order differ by the rule they are built on */
+  virtual bool lessThan(const QuadratureFamilyStub* other) const ;
+
   /* handleable boilerplate */
   GET_RCP(QuadratureFamilyStub);
 
@@ -64,6 +64,17 @@ XMLObject SurfQuadrature::toXML() const
   return rtn;
 }
 
+bool SurfQuadrature::lessThan(const QuadratureFamilyStub* other) const 
+{
+  const SurfQuadrature* p = dynamic_cast<const SurfQuadrature*>(other);
+  if (p == 0) return QuadratureFamilyBase::lessThan(other);
+  const QuadratureFamilyStub* me = quad_.ptr().get();
+  const QuadratureFamilyStub* you = p->quad_.ptr().get();
+  if (typeid(*me).before(typeid(*you))) return true;
+  if (typeid(*you).before(typeid(*me))) return false;
+  return me->lessThan(you);
+}
+
 void SurfQuadrature::getQuadRule(Array<Point>& quadPoints,
                                      Array<double>& quadWeights) const
 {
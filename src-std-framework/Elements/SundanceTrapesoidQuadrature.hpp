@@ -75,6 +75,15 @@ public:
 		return "TrapesoidQuadrature[order=" + Teuchos::toString(order()) + "]";
 	}
 
+	/** Rules of equal order differ by resolution */
+	virtual bool lessThan(const QuadratureFamilyStub* other) const
+	{
+		const TrapesoidQuadrature* t 
+			= dynamic_cast<const TrapesoidQuadrature*>(other);
+		if (t == 0) return QuadratureFamilyBase::lessThan(other);
+		return resolution_ < t->resolution_;
+	}
+
 	/* handleable boilerplate */
 	GET_RCP(QuadratureFamilyStub);
 
@@ -94,6 +94,8 @@
 #include "SundanceMesh.hpp"
 #include "SundanceMeshType.hpp"
 #include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceSpaceFillingCurveReorderer.hpp"
+#include "SundanceRCMReorderer.hpp"
 #include "SundanceMeshSource.hpp"
 #include "SundanceMeshTransformation.hpp"
 #include "SundancePartitionedLineMesher.hpp"
@@ -101,6 +103,7 @@
 #include "SundancePartitionedRectangleMesher.hpp"
 #include "SundanceSerialPartitionerBase.hpp"
 #include "SundanceFileIOChacoPartitioner.hpp"
+#include "SundanceInertialPartitioner.hpp"
 #include "SundanceTriangleMeshReader.hpp"
 #include "SundanceExodusNetCDFMeshReader.hpp"
 #include "SundanceExodusMeshReader.hpp"
@@ -43,6 +43,7 @@
 #include "SundanceOut.hpp"
 #include "PlayaTabs.hpp"
 #include "SundanceAssembler.hpp"
+#include "SundanceMatrixFreeOperator.hpp"
 #include "SundanceDiscreteFunction.hpp"
 #include "SundanceEquationSet.hpp"
 #include "SundanceZeroExpr.hpp"
@@ -349,6 +350,13 @@ Playa::LinearOperator<double> LinearProblem::getOperator() const
   return A_;
 }
 
+Playa::LinearOperator<double> LinearProblem::getMatrixFreeOperator() const 
+{
+  RCP<LinearOperatorBase<double> > A 
+    = rcp(new MatrixFreeOperator(assembler_));
+  return A;
+}
+
 Expr LinearProblem::solve(const LinearSolver<double>& solver) const 
 {
   Tabs tab;
@@ -107,6 +107,11 @@ public:
   /** Return the operator on the left-hand side of the equation */
   LinearOperator<double> getOperator() const ;
 
+  /** Return the operator on the left-hand side of the equation in a 
+   * form that is applied element by element without assembling 
+   * a matrix. Only the untransposed operator can be applied. */
+  LinearOperator<double> getMatrixFreeOperator() const ;
+
   /** Return the map from cells and functions to row indices */
   const RCP<DOFMapBase>& rowMap(int blockRow) const ;
     
@@ -256,6 +256,15 @@ void NLOp::setInitialGuess(const Expr& u0New)
 }
 
 
+LinearOperator<double> NLOp::computePreconditioningMatrix() const
+{
+  if (precOp_.get()==0) return LinearOperator<double>();
+
+  precOp_->setEvalPt(currentEvalPt());
+  return precOp_->getJacobian();
+}
+
+
 LinearOperator<double> NLOp::allocateJacobian() const
 {
   return assembler_->allocateMatrix();
@@ -130,12 +130,27 @@ public:
   /** This function forces the assembler to reassemble the matrix */
   void reAssembleProblem() const;
 
+  /** Set the operator whose Jacobian is used as the preconditioning 
+   * matrix in Jacobian-free mode. It should have the same unknowns as
+   * this operator, but will usually be a cheaper discretization, for 
+   * instance one with reduced quadrature or simplified physics. */
+  void setPreconditioningOp(const RCP<NLOp>& precOp) {precOp_ = precOp;}
+
   /* Handle boilerplate */
   GET_RCP(Playa::NonlinearOperatorBase<double>);
 
 protected:
   /** */
   void updateDiscreteFunctionValue(const Vector<double>& vec) const ;
+
+  /** Compute the preconditioning matrix for Jacobian-free mode as the 
+   * Jacobian of the preconditioning operator at the current eval point */
+  LinearOperator<double> computePreconditioningMatrix() const ;
+
+  /** Put the discrete function back at the restored eval point after
+   * a trial evaluation */
+  void evalPtRestored(const Vector<double>& x) const 
+    {updateDiscreteFunctionValue(x);}
 private:
       
   /** */
@@ -152,6 +167,9 @@ private:
 
   /** */
   Expr paramVals_;
+
+  /** */
+  RCP<NLOp> precOp_;
 };
 }
 
@@ -137,6 +137,23 @@ public:
   /** This function forces the assembler to reassemble the matrix */
   void reAssembleProblem() const { op_->reAssembleProblem();}
 
+  /** Switch Jacobian-free mode on or off. In Jacobian-free mode the 
+   * Jacobian is applied by differencing residuals, and is never 
+   * assembled. Without a preconditioning problem, the linear solves
+   * are unpreconditioned. */
+  void setJacobianFree(bool jacobianFree) 
+    {op_->setJacobianFree(jacobianFree);}
+
+  /** Switch on Jacobian-free mode, building preconditioners from the
+   * assembled Jacobian of precProb. The preconditioning problem must
+   * have the same unknowns as this one, but should be cheaper to 
+   * assemble and store. */
+  void setJacobianFree(const NonlinearProblem& precProb) 
+    {
+      op_->setPreconditioningOp(precProb.op_);
+      op_->setJacobianFree(true);
+    }
+
 private:
   RCP<NLOp> op_;
 };
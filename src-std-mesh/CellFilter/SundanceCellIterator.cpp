@@ -42,6 +42,7 @@
 #include "SundanceCellIterator.hpp"
 #include "SundanceCellFilter.hpp"
 #include "SundanceOut.hpp"
+#include <algorithm>
 
 using namespace Sundance;
 using namespace Sundance;
@@ -52,71 +53,64 @@ CellIterator::CellIterator()
   :  isImplicit_(true),
     currentLID_(-1),
     reorderer_(0),
-     iter_(dummy().begin())
+    cells_(0),
+    pos_(-1)
 {;}
 
 CellIterator::CellIterator(const CellIterator& other)
   :  isImplicit_(other.isImplicit_),
      currentLID_(other.currentLID_),
      reorderer_(other.reorderer_),
-     iter_()
-{
-  if (!isImplicit_) iter_ = other.iter_;
-}
+     cells_(other.cells_),
+     pos_(other.pos_)
+{;}
 
 CellIterator::CellIterator(const Mesh& mesh, 
                            int cellDim, 
                            CellIteratorPos pos)
   : isImplicit_(true),
     currentLID_(-1),
-    reorderer_(mesh.reorderer()),
-    iter_(dummy().begin())
+    reorderer_(0),
+    cells_(0),
+    pos_(-1)
 {
-  if (cellDim == mesh.spatialDim() && reorderer_ != 0)
-    {
-      switch(pos)
-        {
-        case Begin:
-          currentLID_ = reorderer_->begin(); 
-          break;
-        case End:
-          currentLID_ = mesh.numCells(cellDim);
-        }
-      SUNDANCE_OUT(mesh.verb() > 2, 
-                   "created implicit cell iterator with LID=" << currentLID_);
-    }
-  else 
+  /* Reorderers define an ordering of the maximal cells only. Cells
+   * of lower dimension are walked in LID order, as are all cells when
+   * the reorderer is the identity. */
+  const CellReordererImplemBase* r = mesh.reorderer();
+  if (cellDim == mesh.spatialDim() && r != 0 && !r->isIdentity()) 
+  {
+    reorderer_ = r;
+  }
+
+  switch(pos)
     {
-      switch(pos)
-        {
-        case Begin:
-          currentLID_ = 0;
-          break;
-        case End:
-          currentLID_ = mesh.numCells(cellDim);
-        }
-      SUNDANCE_OUT(mesh.verb() > 2, 
-                   "created implicit cell iterator with LID=" << currentLID_);
+    case Begin:
+      currentLID_ = (reorderer_ != 0) ? reorderer_->begin() : 0;
+      break;
+    case End:
+      currentLID_ = mesh.numCells(cellDim);
     }
-
-
+  SUNDANCE_OUT(mesh.verb() > 2, 
+               "created implicit cell iterator with LID=" << currentLID_);
 }
 
 
 
-CellIterator::CellIterator(const Set<int>* cells, CellIteratorPos pos)
+CellIterator::CellIterator(const Array<int>* cells, CellIteratorPos pos)
   : isImplicit_(false),
     currentLID_(-1),
     reorderer_(0),
-    iter_(dummy().begin())
+    cells_(cells),
+    pos_(0)
 {
   switch(pos)
   {
     case Begin:
-      iter_ = cells->begin();
+      pos_ = 0;
       break;
     case End:
-      iter_ = cells->end();
+      pos_ = cells->size();
       break;
     default:
       TEUCHOS_TEST_FOR_EXCEPT(1);
@@ -127,14 +121,51 @@ CellIterator::CellIterator(const Set<int>* cells, CellIteratorPos pos)
 
 CellIterator& CellIterator::operator=(const CellIterator& other)
 {
-  if (*this!=other) 
+  /* Explicit iterators over different sets can compare equal, so
+   * the fields are copied unconditionally */
+  isImplicit_ = other.isImplicit_;
+  currentLID_ = other.currentLID_;
+  reorderer_=other.reorderer_;
+  cells_ = other.cells_;
+  pos_ = other.pos_;
+  return *this;
+}
+
+
+int CellIterator::appendBlock(const CellIterator& end, int maxCount,
+  Array<int>& lids)
+{
+  int start = lids.size();
+
+  if (!isImplicit_)
   {
-    isImplicit_ = other.isImplicit_;
-    currentLID_ = other.currentLID_;
-    reorderer_=other.reorderer_;
-    if (!isImplicit_) iter_ = other.iter_;
+    int n = std::min(maxCount, end.pos_ - pos_);
+    if (n <= 0) return 0;
+    lids.resize(start + n);
+    const int* src = &((*cells_)[pos_]);
+    std::copy(src, src + n, &(lids[start]));
+    pos_ += n;
+    return n;
   }
-  return *this;
+
+  if (reorderer_ == 0)
+  {
+    int n = std::min(maxCount, end.currentLID_ - currentLID_);
+    if (n <= 0) return 0;
+    lids.resize(start + n);
+    for (int i=0; i<n; i++) lids[start+i] = currentLID_ + i;
+    currentLID_ += n;
+    return n;
+  }
+
+  /* a reordered walk has to be done one cell at a time */
+  int n = 0;
+  for (; n<maxCount && *this != end; n++)
+  {
+    lids.append(currentLID_);
+    advance();
+  }
+  return n;
 }
 
     
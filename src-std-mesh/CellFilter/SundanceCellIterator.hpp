@@ -67,7 +67,7 @@ using namespace Teuchos;
  * a polymorphic class heirarchy used. 
  *
  * Two cell set types exist: explicit, where the member cells LIDs
- * are enumerated in a physical Set<int> object, and implicit,
+ * are enumerated in a sorted Array<int>, and implicit,
  * where no physical Set is made, rather, the sequence of cell LIDs
  * is obtained through some scheme of walking the mesh. 
  *
@@ -99,7 +99,7 @@ public:
 
   /** Construct an explicit iterator for walking an explicitly
    * enumerated set of cells. */
-  CellIterator(const Set<int>* cells, CellIteratorPos pos);
+  CellIterator(const Array<int>* cells, CellIteratorPos pos);
 
   /** */
   CellIterator& operator=(const CellIterator& other);
@@ -108,7 +108,7 @@ public:
   const int& operator*() const 
     {
       if (isImplicit_) return currentLID_;
-      else return *iter_;
+      else return (*cells_)[pos_];
     }
       
   /** Postfix increment: advances iterator and returns previous value  */
@@ -136,7 +136,7 @@ public:
       }
       else
       {
-        return iter_ == other.iter_;
+        return pos_ == other.pos_;
       }
     }
 
@@ -146,6 +146,22 @@ public:
       return !(*this == other);
     }
 
+  /** 
+   * Append up to maxCount cell LIDs to the array lids, starting at
+   * the current position and stopping at end, and advance the
+   * iterator past them. For explicit sets, and for implicit sets 
+   * without a reorderer, the LIDs are contiguous and are copied as a
+   * block rather than one cell at a time.
+   *
+   * @return the number of LIDs appended
+   */
+  int appendBlock(const CellIterator& end, int maxCount, 
+    Array<int>& lids);
+
+  /** Whether appendBlock() copies LIDs as a block rather than walking
+   * one cell at a time */
+  bool isContiguous() const {return !isImplicit_ || reorderer_ == 0;}
+
       
 private:
 
@@ -160,7 +176,7 @@ private:
         }
         else currentLID_++;
       }
-      else iter_++;
+      else pos_++;
     }
       
   /** Flag indicating whether this iterator is implicit */
@@ -174,12 +190,13 @@ private:
    * implicit cell sets. Used only for implicit iterators. */
   const CellReordererImplemBase* reorderer_; 
 
-  /** iterator for enumerated cells.
+  /** Unmanaged pointer to the sorted array of enumerated cells.
    * Used only for explicit iterators. */
-  Set<int>::const_iterator iter_;
+  const Array<int>* cells_;
 
-  /** */
-  static Set<int> dummy() {static Set<int> rtn; return rtn;}
+  /** Position in the array of enumerated cells.
+   * Used only for explicit iterators. */
+  int pos_;
 };
 }
 
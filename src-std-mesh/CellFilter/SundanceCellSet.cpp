@@ -54,6 +54,30 @@ using Playa::Handle;
 using Playa::Handleable;
 
 
+namespace
+{
+/* Copy the LIDs of a cell set into a sorted array. Explicit sets are
+ * already sorted; implicit sets are sorted unless walked through 
+ * a reorderer. */
+void getSortedLIDs(const CellSet& cells, Array<int>& lids)
+{
+  lids.resize(0);
+  CellIterator iter = cells.begin();
+  CellIterator end = cells.end();
+  while (iter.appendBlock(end, 4096, lids) > 0) {;}
+
+  for (int i=1; i<lids.size(); i++)
+  {
+    if (lids[i] < lids[i-1]) 
+    {
+      std::sort(lids.begin(), lids.end());
+      break;
+    }
+  }
+}
+}
+
+
 CellSet::CellSet(const Mesh& mesh, int cellDim,
   const CellType& cellType,
   const Set<int>& cellLIDs)
@@ -69,10 +93,15 @@ CellSet CellSet::setUnion(const CellSet& other) const
 
   checkCompatibility("union", other);
   
-  Set<int>& cells = rtn->cells();
-
-  std::set_union(this->begin(), this->end(), other.begin(), other.end(), 
-    std::insert_iterator<Set<int> >(cells, cells.begin()));
+  Array<int> a;
+  Array<int> b;
+  getSortedLIDs(*this, a);
+  getSortedLIDs(other, b);
+
+  Array<int>& cells = rtn->cells();
+  cells.reserve(a.size() + b.size());
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), 
+    std::back_inserter(cells));
   
   return rtn;
 }
@@ -86,10 +115,15 @@ CellSet CellSet::setIntersection(const CellSet& other) const
 
   checkCompatibility("intersection", other);
   
-  Set<int>& cells = rtn->cells();
-
-  std::set_intersection(this->begin(), this->end(), other.begin(), other.end(), 
-    std::insert_iterator<Set<int> >(cells, cells.begin()));
+  Array<int> a;
+  Array<int> b;
+  getSortedLIDs(*this, a);
+  getSortedLIDs(other, b);
+
+  Array<int>& cells = rtn->cells();
+  cells.reserve(std::min(a.size(), b.size()));
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), 
+    std::back_inserter(cells));
   
   return rtn;
 }
@@ -103,10 +137,15 @@ CellSet CellSet::setDifference(const CellSet& other) const
 
   checkCompatibility("difference", other);
   
-  Set<int>& cells = rtn->cells();
-
-  std::set_difference(this->begin(), this->end(), other.begin(), other.end(), 
-    std::insert_iterator<Set<int> >(cells, cells.begin()));
+  Array<int> a;
+  Array<int> b;
+  getSortedLIDs(*this, a);
+  getSortedLIDs(other, b);
+
+  Array<int>& cells = rtn->cells();
+  cells.reserve(a.size());
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), 
+    std::back_inserter(cells));
   
   return rtn;
 }
@@ -178,6 +217,10 @@ bool CellSet::operator<(const CellSet& other) const
 
 int CellSet::numCells() const 
 {
+  const ExplicitCellSet* e 
+    = dynamic_cast<const ExplicitCellSet*>(ptr().get());
+  if (e != 0) return e->cells().size();
+
   int count = 0;
   for (CellIterator i=begin(); i!=end(); i++)
   {
@@ -41,6 +41,7 @@
 
 #include "SundanceExplicitCellSet.hpp"
 #include "PlayaTabs.hpp"
+#include <algorithm>
 
 using namespace Sundance;
 using namespace Sundance;
@@ -57,9 +58,24 @@ ExplicitCellSet::ExplicitCellSet(const Mesh& mesh, int cellDim,
                                  const CellType& cellType,
                                  const Set<int>& cells)
   : CellSetBase(mesh, cellDim, cellType),
-    cells_(cells)
+    cells_(cells.begin(), cells.end())
 {;}
 
+ExplicitCellSet::ExplicitCellSet(const Mesh& mesh, int cellDim,
+                                 const CellType& cellType,
+                                 const Array<int>& cells)
+  : CellSetBase(mesh, cellDim, cellType),
+    cells_(cells)
+{
+  sortCells();
+}
+
+void ExplicitCellSet::sortCells()
+{
+  std::sort(cells_.begin(), cells_.end());
+  cells_.erase(std::unique(cells_.begin(), cells_.end()), cells_.end());
+}
+
 CellIterator ExplicitCellSet::begin() const
 {
   return CellIterator(&cells_, CellIterator::Begin);
@@ -83,6 +99,7 @@ bool ExplicitCellSet::internalLessThan(const CellSetBase* other) const
 
   if (e == 0) return true;
 
-  bool rtn = cells_ < e->cells_;
+  bool rtn = std::lexicographical_compare(cells_.begin(), cells_.end(),
+    e->cells_.begin(), e->cells_.end());
   return rtn;
 }
@@ -51,7 +51,9 @@ using namespace Teuchos;
 
 /** 
  * ExplicitCellSet is a cell set subtype where the cell LIDs
- * are stored explicitly in an STL set. 
+ * are stored explicitly in a sorted array without duplicates. 
+ * Iteration is then a walk through contiguous memory, and 
+ * set operations can be done by linear merges.
  * 
  * @see CellFilter, CellSet, CellSetBase, CellIterator 
  **/
@@ -68,6 +70,12 @@ public:
     const CellType& cellType,
     const Set<int>& cellLIDs);
 
+  /** Construct with an array of cells. The array need not be sorted, 
+   * and may contain duplicates. */
+  ExplicitCellSet(const Mesh& mesh, int cellDim,
+    const CellType& cellType,
+    const Array<int>& cellLIDs);
+
   /** Returns an iterator pointing to the first element
    * in the set. */
   virtual CellIterator begin() const ;
@@ -75,8 +83,16 @@ public:
   /** Returns a past-the-end iterator */
   virtual CellIterator end() const ;
 
-  /** Returns a modifiable reference to the set of cells */
-  Set<int>& cells() {return cells_;}
+  /** Returns a modifiable reference to the array of cells. Callers
+   * that do not fill it in increasing order must call 
+   * sortCells() when done. */
+  Array<int>& cells() {return cells_;}
+
+  /** Returns the sorted array of cells */
+  const Array<int>& cells() const {return cells_;}
+
+  /** Sort the cell array and remove duplicates */
+  void sortCells();
 
   /** */
   bool internalLessThan(const CellSetBase* other) const ;
@@ -92,8 +108,8 @@ public:
 
 private:
 
-  /** The set of cell LIDs */
-  Set<int> cells_;
+  /** The sorted array of cell LIDs */
+  Array<int> cells_;
 
       
 };
@@ -107,7 +107,7 @@ CellSet SubsetCellFilter::internalGetCells(const Mesh& mesh) const
 
   ExplicitCellSet* rtn = new ExplicitCellSet(mesh, dim, cellType);
 
-  Set<int>& cells = rtn->cells();
+  Array<int>& cells = rtn->cells();
 
   const CellPredicateBase* pred = predicate_.ptr().get();
 
@@ -116,10 +116,9 @@ CellSet SubsetCellFilter::internalGetCells(const Mesh& mesh) const
 
   cellLID.reserve(mesh.numCells(dim));
 
-  for (CellIterator i=super.begin(); i != super.end(); i++)
-    {
-      cellLID.append(*i);
-    }
+  CellIterator iter = super.begin();
+  CellIterator superEnd = super.end();
+  while (iter.appendBlock(superEnd, mesh.numCells(dim), cellLID) > 0) {;}
 
   Array<int> testResults(cellLID.size());
   pred->testBatch(cellLID, testResults);
@@ -132,7 +131,7 @@ CellSet SubsetCellFilter::internalGetCells(const Mesh& mesh) const
         {
           SUNDANCE_OUT(this->verb() > 2,
                        "accepted " << cellLID[i]);
-          cells.insert(cellLID[i]);
+          cells.append(cellLID[i]);
         }
       else
         {
@@ -141,5 +140,8 @@ CellSet SubsetCellFilter::internalGetCells(const Mesh& mesh) const
         }
     }
 
+  /* the superset may have been walked in a reordered sequence */
+  rtn->sortCells();
+
   return rtn;
 }
@@ -53,6 +53,7 @@
 #include "SundanceCollectiveExceptionCheck.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <unistd.h>
 
 using namespace Sundance;
@@ -277,6 +278,37 @@ void BasicSimplicialMesh::getJacobians(int cellDim, const Array<int>& cellLID,
       }
     }
   }
+  else if (jBatch.hasClosedForm() && nCells > 0)
+  {
+    /* Fill the batch directly in structure-of-arrays form, so that
+     * the determinants and inverses can be computed with unit-stride
+     * loops over the cells. The entry ordering matches the loop below. */
+    flops += cellDim*cellDim*nCells;
+
+    Array<double*> J(cellDim*cellDim);
+    for (int k=0; k<J.size(); k++) J[k] = jBatch.soaJVals(k);
+
+    for (int i=0; i<nCells; i++)
+    {
+      int lid = cellLID[i];
+      const Point& pa = points_[elemVerts_.value(lid, 0)];
+      if (cellDim==1)
+      {
+        const Point& pb = points_[elemVerts_.value(lid, 1)];
+        J[0][i] = fabs(pa[0]-pb[0]);
+        continue;
+      }
+      for (int v=1; v<=cellDim; v++)
+      {
+        const Point& pv = points_[elemVerts_.value(lid, v)];
+        for (int r=0; r<cellDim; r++) 
+        {
+          J[r*cellDim + v-1][i] = pv[r] - pa[r];
+        }
+      }
+    }
+    jBatch.finishSoAFill();
+  }
   else
   {
     Array<double> J(cellDim*cellDim);
@@ -838,15 +870,15 @@ int BasicSimplicialMesh::numMaxCofacets(int cellDim, int cellLID) const
 
   if (cellDim==0)
   {
-    return vertCofacets_[cellLID].length();
+    return vertCofacets_.rowLength(cellLID);
   }
   if (cellDim==1)
   {
-    return edgeCofacets_[cellLID].length();
+    return edgeCofacets_.rowLength(cellLID);
   }
   if (cellDim==2)
   {
-    return faceCofacets_[cellLID].length();
+    return faceCofacets_.rowLength(cellLID);
   }
   return -1; // -Wall
 }
@@ -860,15 +892,15 @@ int BasicSimplicialMesh::maxCofacetLID(int cellDim, int cellLID,
   int rtn = -1;
   if (cellDim==0)
   {
-    rtn = vertCofacets_[cellLID][cofacetIndex];
+    rtn = vertCofacets_.value(cellLID, cofacetIndex);
   }
   else if (cellDim==1)
   {
-    rtn = edgeCofacets_[cellLID][cofacetIndex];
+    rtn = edgeCofacets_.value(cellLID, cofacetIndex);
   }
   else if (cellDim==2)
   {
-    rtn = faceCofacets_[cellLID][cofacetIndex];
+    rtn = faceCofacets_.value(cellLID, cofacetIndex);
   }
   else
   {
@@ -935,24 +967,25 @@ void BasicSimplicialMesh::getCofacets(int cellDim, int cellLID,
     << " for cell dim=" << cellDim);
   if (cofacetDim==spatialDim())
   {
-    cofacetLIDs.resize(numMaxCofacets(cellDim, cellLID));
-    int dum=0;
-    for (int f=0; f<cofacetLIDs.size(); f++)
-    {
-      cofacetLIDs[f] = maxCofacetLID(cellDim, cellLID, f, dum);
-    }
+    /* the maximal cofacet tables hold exactly the LIDs that 
+     * maxCofacetLID() would return, so copy the row directly rather
+     * than searching for each cofacet's facet index */
+    if (cellDim==0) vertCofacets_.getRow(cellLID, cofacetLIDs);
+    else if (cellDim==1) edgeCofacets_.getRow(cellLID, cofacetLIDs);
+    else if (cellDim==2) faceCofacets_.getRow(cellLID, cofacetLIDs);
+    else TEUCHOS_TEST_FOR_EXCEPT(true);
   }
   else
   {
     if (cellDim==0)
     {
-      if (cofacetDim==1) cofacetLIDs = vertEdges_[cellLID];
-      else if (cofacetDim==2) cofacetLIDs = vertFaces_[cellLID];
+      if (cofacetDim==1) vertEdges_.getRow(cellLID, cofacetLIDs);
+      else if (cofacetDim==2) vertFaces_.getRow(cellLID, cofacetLIDs);
       else TEUCHOS_TEST_FOR_EXCEPT(true);
     }
     else if (cellDim==1)
     { 
-      if (cofacetDim==2) cofacetLIDs = edgeFaces_[cellLID];
+      if (cofacetDim==2) edgeFaces_.getRow(cellLID, cofacetLIDs);
       else TEUCHOS_TEST_FOR_EXCEPT(true);
     }
     else if (cellDim==2)
@@ -968,6 +1001,24 @@ void BasicSimplicialMesh::getCofacets(int cellDim, int cellLID,
   }
 }
 
+void BasicSimplicialMesh::freezeTopology()
+{
+  edgeFaces_.pack();
+  edgeCofacets_.pack();
+  faceCofacets_.pack();
+  vertEdges_.pack();
+  vertFaces_.pack();
+  vertCofacets_.pack();
+  vertEdgePartners_.pack();
+}
+
+size_t BasicSimplicialMesh::cofacetTableBytes() const
+{
+  return edgeFaces_.bytes() + edgeCofacets_.bytes() 
+    + faceCofacets_.bytes() + vertEdges_.bytes() + vertFaces_.bytes()
+    + vertCofacets_.bytes() + vertEdgePartners_.bytes();
+}
+
 int BasicSimplicialMesh::mapGIDToLID(int cellDim, int globalIndex) const
 {
   return GIDToLIDMap_[cellDim].get(globalIndex);
@@ -1134,8 +1185,8 @@ int BasicSimplicialMesh::addElement(int globalIndex,
     edges.resize(0);
     faces.resize(0);
     /* register the new element as a cofacet of its vertices. */
-    vertCofacets_[vertLID[0]].append(lid);
-    vertCofacets_[vertLID[1]].append(lid);
+    vertCofacets_.append(vertLID[0], lid);
+    vertCofacets_.append(vertLID[1], lid);
   }
   if (spatialDim()==2)
   {
@@ -1149,9 +1200,9 @@ int BasicSimplicialMesh::addElement(int globalIndex,
     edges[2] = addEdge(vertLID[0], vertLID[1], lid, globalIndex, 2);
 
     /* register the new element as a cofacet of its vertices. */
-    vertCofacets_[vertLID[0]].append(lid);
-    vertCofacets_[vertLID[1]].append(lid);
-    vertCofacets_[vertLID[2]].append(lid);
+    vertCofacets_.append(vertLID[0], lid);
+    vertCofacets_.append(vertLID[1], lid);
+    vertCofacets_.append(vertLID[2], lid);
 
   }
   else if (spatialDim()==3)
@@ -1169,10 +1220,10 @@ int BasicSimplicialMesh::addElement(int globalIndex,
     edges[5] = addEdge(vertLID[0], vertLID[1], lid, globalIndex,  5);
 
     /* register the new element as a cofacet of its vertices. */
-    vertCofacets_[vertLID[0]].append(lid);
-    vertCofacets_[vertLID[1]].append(lid);
-    vertCofacets_[vertLID[2]].append(lid);
-    vertCofacets_[vertLID[3]].append(lid);
+    vertCofacets_.append(vertLID[0], lid);
+    vertCofacets_.append(vertLID[1], lid);
+    vertCofacets_.append(vertLID[2], lid);
+    vertCofacets_.append(vertLID[3], lid);
 
     /* add the faces */
     static Array<int> tmpVertLID(3);
@@ -1263,10 +1314,10 @@ int BasicSimplicialMesh::addElement(int globalIndex,
     
   }
 
-  for (int i=0; i<edges.length(); i++) edgeCofacets_[edges[i]].append(lid);
+  for (int i=0; i<edges.length(); i++) edgeCofacets_.append(edges[i], lid);
 
 
-  for (int i=0; i<faces.length(); i++) faceCofacets_[faces[i]].append(lid);
+  for (int i=0; i<faces.length(); i++) faceCofacets_.append(faces[i], lid);
 
   return lid;
 }
@@ -1340,14 +1391,14 @@ int BasicSimplicialMesh::addFace(
     numCells_[spatialDim()-1]++;
 
     /* Register the face as a cofacet of its edges */
-    edgeFaces_[edgeLID[0]].append(lid);
-    edgeFaces_[edgeLID[1]].append(lid);
-    edgeFaces_[edgeLID[2]].append(lid);
+    edgeFaces_.append(edgeLID[0], lid);
+    edgeFaces_.append(edgeLID[1], lid);
+    edgeFaces_.append(edgeLID[2], lid);
 
     /* Register the face as a cofacet of its vertices */
-    vertFaces_[vertLID[0]].append(lid);
-    vertFaces_[vertLID[1]].append(lid);
-    vertFaces_[vertLID[2]].append(lid);
+    vertFaces_.append(vertLID[0], lid);
+    vertFaces_.append(vertLID[1], lid);
+    vertFaces_.append(vertLID[2], lid);
 
     /* return the LID of the new face */
     return lid;
@@ -1358,12 +1409,12 @@ int BasicSimplicialMesh::addFace(
 
 int BasicSimplicialMesh::checkForExistingEdge(int vertLID1, int vertLID2)
 {
-  const Array<int>& edgePartners = vertEdgePartners_[vertLID1];
-  for (int i=0; i<edgePartners.length(); i++)
+  int nPartners = vertEdgePartners_.rowLength(vertLID1);
+  for (int i=0; i<nPartners; i++)
   {
-    if (edgePartners[i] == vertLID2)
+    if (vertEdgePartners_.value(vertLID1, i) == vertLID2)
     {
-      return vertEdges_[vertLID1][i];
+      return vertEdges_.value(vertLID1, i);
     }
   }
   return -1;
@@ -1428,10 +1479,10 @@ int BasicSimplicialMesh::addEdge(int v1, int v2,
     else ownerProcID_[1].append(-1);
 
     /* register the new edge with its vertices */
-    vertEdges_[v1].append(lid);
-    vertEdgePartners_[v1].append(v2);
-    vertEdges_[v2].append(lid);
-    vertEdgePartners_[v2].append(v1);
+    vertEdges_.append(v1, lid);
+    vertEdgePartners_.append(v1, v2);
+    vertEdges_.append(v2, lid);
+    vertEdgePartners_.append(v2, v1);
     /* create storage for the cofacets of the new edge */
     edgeCofacets_.resize(lid+1);
     if (spatialDim() > 2) edgeFaces_.resize(lid+1);
@@ -2331,3 +2382,357 @@ string BasicSimplicialMesh::printCells(int cellDim) const
 
 
 
+/* ------------------------------------------------------------------
+ * Checkpointing
+ *
+ * The checkpoint image is a flat sequence of native-endian 32-bit 
+ * integers and doubles. Every array is stored as its length followed 
+ * by its raw contents, and arrays of arrays are stored in compressed
+ * form as an offset array followed by the concatenated entries, so that
+ * each table can be restored with a single block copy.
+ * ------------------------------------------------------------------ */
+
+namespace
+{
+const char checkpointMagic[8] = {'S','U','N','D','M','E','S','H'};
+const int checkpointByteOrderTag = 0x01020304;
+
+void writeInt(std::ostream& os, int x)
+{
+  os.write(reinterpret_cast<const char*>(&x), sizeof(int));
+}
+
+void writeInts(std::ostream& os, const int* x, int n)
+{
+  if (n > 0) os.write(reinterpret_cast<const char*>(x), n*sizeof(int));
+}
+
+void writeArray(std::ostream& os, const Array<int>& x)
+{
+  writeInt(os, x.size());
+  if (x.size() > 0) writeInts(os, &(x[0]), x.size());
+}
+
+void writeTuples(std::ostream& os, const ArrayOfTuples<int>& x)
+{
+  writeInt(os, x.length());
+  writeInt(os, x.tupleSize());
+  if (x.length() > 0) writeInts(os, &(x.value(0,0)), x.length()*x.tupleSize());
+}
+
+void writeNestedArray(std::ostream& os, const Array<Array<int> >& x)
+{
+  int n = x.size();
+  Array<int> offsets(n+1);
+  offsets[0] = 0;
+  for (int i=0; i<n; i++) offsets[i+1] = offsets[i] + x[i].size();
+
+  writeInt(os, n);
+  writeInts(os, &(offsets[0]), n+1);
+  for (int i=0; i<n; i++) 
+  {
+    if (x[i].size() > 0) writeInts(os, &(x[i][0]), x[i].size());
+  }
+}
+
+void writeNestedArray(std::ostream& os, const RaggedArray<int>& x)
+{
+  if (!x.isPacked())
+  {
+    int n = x.length();
+    Array<int> offsets(n+1);
+    offsets[0] = 0;
+    for (int i=0; i<n; i++) offsets[i+1] = offsets[i] + x.rowLength(i);
+    writeInt(os, n);
+    writeInts(os, &(offsets[0]), n+1);
+    for (int i=0; i<n; i++) 
+    {
+      if (x.rowLength(i) > 0) writeInts(os, &(x.value(i,0)), x.rowLength(i));
+    }
+    return;
+  }
+  /* a packed table is already in the on-disk layout */
+  const Array<int>& offsets = x.offsets();
+  int n = offsets.size()-1;
+  writeInt(os, n);
+  writeInts(os, &(offsets[0]), n+1);
+  if (offsets[n] > 0) writeInts(os, &(x.data()[0]), offsets[n]);
+}
+
+/* Sequential reader for a checkpoint image in memory */
+class CheckpointCursor
+{
+public:
+  CheckpointCursor(const char* data, size_t size)
+    : pos_(data), end_(data + size) {}
+
+  void readBytes(void* dst, size_t n)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(pos_ + n > end_, std::runtime_error,
+        "BasicSimplicialMesh::readCheckpoint() found truncated "
+        "checkpoint image");
+      if (n > 0) std::memcpy(dst, pos_, n);
+      pos_ += n;
+    }
+
+  int readInt()
+    {
+      int x;
+      readBytes(&x, sizeof(int));
+      return x;
+    }
+
+  void readArray(Array<int>& x)
+    {
+      int n = readInt();
+      x.resize(n);
+      if (n > 0) readBytes(&(x[0]), n*sizeof(int));
+    }
+
+  void readTuples(ArrayOfTuples<int>& x)
+    {
+      int n = readInt();
+      int tupleSize = readInt();
+      x.resize(n, tupleSize);
+      if (n > 0) readBytes(&(x.value(0,0)), n*tupleSize*sizeof(int));
+    }
+
+  void readNestedArray(Array<Array<int> >& x)
+    {
+      int n = readInt();
+      Array<int> offsets(n+1);
+      readBytes(&(offsets[0]), (n+1)*sizeof(int));
+      x.resize(n);
+      for (int i=0; i<n; i++)
+      {
+        int len = offsets[i+1] - offsets[i];
+        x[i].resize(len);
+        if (len > 0) readBytes(&(x[i][0]), len*sizeof(int));
+      }
+    }
+
+  void readNestedArray(RaggedArray<int>& x)
+    {
+      int n = readInt();
+      x.resetPacked();
+      Array<int>& offsets = x.offsets();
+      offsets.resize(n+1);
+      readBytes(&(offsets[0]), (n+1)*sizeof(int));
+      Array<int>& data = x.data();
+      data.resize(offsets[n]);
+      if (offsets[n] > 0) readBytes(&(data[0]), offsets[n]*sizeof(int));
+    }
+
+  bool atEnd() const {return pos_ == end_;}
+
+private:
+  const char* pos_;
+  const char* end_;
+};
+}
+
+
+void BasicSimplicialMesh::writeCheckpoint(std::ostream& os) const
+{
+  int dim = spatialDim();
+
+  /* header */
+  os.write(checkpointMagic, sizeof(checkpointMagic));
+  writeInt(os, checkpointVersion());
+  writeInt(os, checkpointByteOrderTag);
+  writeInt(os, sizeof(double));
+  writeInt(os, dim);
+  writeInt(os, comm().getNProc());
+  writeInt(os, comm().getRank());
+
+  writeArray(os, numCells_);
+
+  /* vertex positions */
+  writeInt(os, points_.size());
+  for (int i=0; i<points_.size(); i++)
+  {
+    os.write(reinterpret_cast<const char*>(&(points_[i][0])), 
+      dim*sizeof(double));
+  }
+
+  /* downward connectivity */
+  writeTuples(os, edgeVerts_);
+  writeTuples(os, faceVertLIDs_);
+  writeTuples(os, faceVertGIDs_);
+  writeTuples(os, faceEdges_);
+  writeTuples(os, faceEdgeSigns_);
+  writeTuples(os, elemVerts_);
+  writeTuples(os, elemEdges_);
+  writeTuples(os, elemEdgeSigns_);
+  writeTuples(os, elemFaces_);
+  writeTuples(os, elemFaceRotations_);
+
+  /* upward connectivity */
+  writeNestedArray(os, edgeFaces_);
+  writeNestedArray(os, edgeCofacets_);
+  writeNestedArray(os, faceCofacets_);
+  writeNestedArray(os, vertEdges_);
+  writeNestedArray(os, vertFaces_);
+  writeNestedArray(os, vertCofacets_);
+  writeNestedArray(os, vertEdgePartners_);
+
+  /* numbering, labels, and ownership */
+  writeNestedArray(os, LIDToGIDMap_);
+  writeNestedArray(os, labels_);
+  writeNestedArray(os, ownerProcID_);
+
+  writeInt(os, hasEdgeGIDs_);
+  writeInt(os, hasFaceGIDs_);
+  writeArray(os, neighbors_.elements());
+  writeInt(os, neighborsAreSynchronized_);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!os, std::runtime_error,
+    "BasicSimplicialMesh::writeCheckpoint() failed writing to stream");
+}
+
+
+int BasicSimplicialMesh::checkpointDimension(const char* data, size_t size)
+{
+  CheckpointCursor in(data, size);
+  char magic[sizeof(checkpointMagic)];
+  in.readBytes(magic, sizeof(magic));
+  TEUCHOS_TEST_FOR_EXCEPTION(std::memcmp(magic, checkpointMagic, 
+      sizeof(magic)) != 0, std::runtime_error,
+    "BasicSimplicialMesh::checkpointDimension() found an image that is not "
+    "a mesh checkpoint");
+  /* skip version, byte order tag, and size of double */
+  in.readInt();
+  in.readInt();
+  in.readInt();
+  return in.readInt();
+}
+
+
+void BasicSimplicialMesh::readCheckpoint(const char* data, size_t size)
+{
+  int dim = spatialDim();
+  CheckpointCursor in(data, size);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(numCells_[0] != 0, std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() called on a non-empty mesh");
+
+  /* header */
+  char magic[sizeof(checkpointMagic)];
+  in.readBytes(magic, sizeof(magic));
+  TEUCHOS_TEST_FOR_EXCEPTION(std::memcmp(magic, checkpointMagic, 
+      sizeof(magic)) != 0, std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found an image that is not "
+    "a mesh checkpoint");
+
+  int version = in.readInt();
+  TEUCHOS_TEST_FOR_EXCEPTION(version != checkpointVersion(), 
+    std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found checkpoint version "
+    << version << ", expected " << checkpointVersion());
+
+  int byteOrder = in.readInt();
+  int doubleSize = in.readInt();
+  TEUCHOS_TEST_FOR_EXCEPTION(byteOrder != checkpointByteOrderTag 
+    || doubleSize != (int) sizeof(double), std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found a checkpoint written on "
+    "a platform with a different binary representation");
+
+  int fileDim = in.readInt();
+  TEUCHOS_TEST_FOR_EXCEPTION(fileDim != dim, std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found a checkpoint of dimension "
+    << fileDim << " but the mesh has dimension " << dim);
+
+  int np = in.readInt();
+  int rank = in.readInt();
+  TEUCHOS_TEST_FOR_EXCEPTION(np != comm().getNProc() 
+    || rank != comm().getRank(), std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found a checkpoint written "
+    "by processor " << rank << " of " << np << ", but this is processor "
+    << comm().getRank() << " of " << comm().getNProc());
+
+  in.readArray(numCells_);
+
+  /* vertex positions */
+  int nPts = in.readInt();
+  points_.resize(nPts);
+  double x[3] = {0.0, 0.0, 0.0};
+  for (int i=0; i<nPts; i++)
+  {
+    in.readBytes(x, dim*sizeof(double));
+    if (dim==1) points_[i] = Point(x[0]);
+    else if (dim==2) points_[i] = Point(x[0], x[1]);
+    else points_[i] = Point(x[0], x[1], x[2]);
+  }
+
+  /* downward connectivity */
+  in.readTuples(edgeVerts_);
+  in.readTuples(faceVertLIDs_);
+  in.readTuples(faceVertGIDs_);
+  in.readTuples(faceEdges_);
+  in.readTuples(faceEdgeSigns_);
+  in.readTuples(elemVerts_);
+  in.readTuples(elemEdges_);
+  in.readTuples(elemEdgeSigns_);
+  in.readTuples(elemFaces_);
+  in.readTuples(elemFaceRotations_);
+
+  /* upward connectivity */
+  in.readNestedArray(edgeFaces_);
+  in.readNestedArray(edgeCofacets_);
+  in.readNestedArray(faceCofacets_);
+  in.readNestedArray(vertEdges_);
+  in.readNestedArray(vertFaces_);
+  in.readNestedArray(vertCofacets_);
+  in.readNestedArray(vertEdgePartners_);
+
+  /* numbering, labels, and ownership */
+  in.readNestedArray(LIDToGIDMap_);
+  in.readNestedArray(labels_);
+  in.readNestedArray(ownerProcID_);
+
+  hasEdgeGIDs_ = in.readInt();
+  hasFaceGIDs_ = in.readInt();
+  Array<int> neighbors;
+  in.readArray(neighbors);
+  for (int i=0; i<neighbors.size(); i++) neighbors_.put(neighbors[i]);
+  neighborsAreSynchronized_ = in.readInt();
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!in.atEnd(), std::runtime_error,
+    "BasicSimplicialMesh::readCheckpoint() found unexpected data at "
+    "the end of the checkpoint image");
+
+  /* The hashtables aren't stored in the image. They are refilled 
+   * from the restored arrays, which is a single pass over the cells
+   * with no connectivity lookups. */
+  for (int d=0; d<=dim; d++)
+  {
+    const Array<int>& gids = LIDToGIDMap_[d];
+    int n = gids.size();
+    GIDToLIDMap_[d] = Hashtable<int,int>(std::max(n, 1), 0.6);
+    for (int i=0; i<n; i++)
+    {
+      if (gids[i] != -1) GIDToLIDMap_[d].put(gids[i], i);
+    }
+  }
+
+  /* reset the face vertex view base pointer, using the same 
+   * phony-dereference trick as in the constructor if there are no faces */
+  int nFaces = faceVertGIDs_.length();
+  if (nFaces==0)
+  {
+    faceVertGIDs_.resize(1);
+    faceVertGIDBase_[0] = &(faceVertGIDs_.value(0,0));
+    faceVertGIDs_.resize(0);
+  }
+  else
+  {
+    faceVertGIDBase_[0] = &(faceVertGIDs_.value(0,0));
+  }
+
+  vertexSetToFaceIndexMap_ = Hashtable<VertexView, int>(std::max(nFaces, 1));
+  for (int f=0; f<nFaces; f++)
+  {
+    VertexView face(&(faceVertGIDBase_[0]), f, faceVertGIDs_.tupleSize());
+    vertexSetToFaceIndexMap_.put(face, f);
+  }
+}
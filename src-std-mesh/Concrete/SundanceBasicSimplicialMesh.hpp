@@ -49,6 +49,7 @@
 #include "SundanceSet.hpp"
 #include "SundanceBasicVertexView.hpp"
 #include "SundanceArrayOfTuples.hpp"
+#include "SundanceRaggedArray.hpp"
 #include "SundanceIncrementallyCreatableMesh.hpp"
 #include "Teuchos_Array.hpp"
 #include "Teuchos_Hashtable.hpp"
@@ -278,6 +279,17 @@ public:
   virtual int addElement(int globalIndex, const Array<int>& vertexGIDs,
     int ownerProcID, int label);
 
+  /** 
+   * Pack the upward connectivity tables into compressed-sparse-row
+   * form. Adding vertices or elements afterwards is still allowed,
+   * but unpacks the tables again.
+   */
+  virtual void freezeTopology() ;
+
+  /** Approximate number of bytes used by the upward connectivity 
+   * tables */
+  size_t cofacetTableBytes() const ;
+
   /** Set the label of the given cell */
   virtual void setLabel(int cellDim, int cellLID, int label)
     {
@@ -301,6 +313,34 @@ public:
     }
       
   //@}
+
+  /** \name Checkpointing */
+  //@{
+  /** 
+   * Write the complete state of this processor's part of the mesh, 
+   * including intermediate cells, connectivity tables, GID maps, labels
+   * and ownership, to a binary stream.
+   */
+  void writeCheckpoint(std::ostream& os) const ;
+
+  /** 
+   * Restore the state of an empty mesh from a checkpoint image
+   * previously written by writeCheckpoint(). The image is read 
+   * directly from memory, typically a mapped file, and none of the
+   * connectivity is recomputed.
+   * \param data pointer to the start of the image
+   * \param size size of the image in bytes
+   */
+  void readCheckpoint(const char* data, size_t size) ;
+
+  /** Version number of the checkpoint format */
+  static int checkpointVersion() {return 1;}
+
+  /** Read the spatial dimension recorded in the header of a checkpoint 
+   * image, so that a mesh of the right dimension can be created before
+   * calling readCheckpoint(). */
+  static int checkpointDimension(const char* data, size_t size) ;
+  //@}
 private:
 
   /** 
@@ -447,32 +487,36 @@ private:
   Hashtable<VertexView, int> vertexSetToFaceIndexMap_;
 
   /** array of face cofacets for the edges. The first index
-   * is the edge LID, the second the cofacet number. */
-  Array<Array<int> > edgeFaces_;
+   * is the edge LID, the second the cofacet number. 
+   * 
+   * This and the other upward connectivity tables below are built 
+   * row by row during incremental creation, and are packed into
+   * compressed-sparse-row form by freezeTopology(). */
+  RaggedArray<int> edgeFaces_;
 
   /** array of element cofacets for the edges. The first index
    * is the edge LID, the second the cofacet number. */
-  Array<Array<int> > edgeCofacets_;
+  RaggedArray<int> edgeCofacets_;
 
   /** array of element cofacets for the faces. The first index is the
    * face LID, the second the cofacet number. */
-  Array<Array<int> > faceCofacets_;
+  RaggedArray<int> faceCofacets_;
 
   /** array of edge cofacets for the vertices. The first index is the 
    * vertex LID, the second the edge cofacet number. */
-  Array<Array<int> > vertEdges_;
+  RaggedArray<int> vertEdges_;
 
   /** array of face cofacet LIDs for the vertices. The first index is the 
    * vertex LID, the second the cofacet number. */
-  Array<Array<int> > vertFaces_;
+  RaggedArray<int> vertFaces_;
 
   /** array of maximal cofacets for the vertices. The first index is the
    * vertex LID, the second the cafacet number. */
-  Array<Array<int> > vertCofacets_;
+  RaggedArray<int> vertCofacets_;
 
   /** array of edge partners for the vertices. The partners are other
    * vertices sharing an edge with the specified vertex. */
-  Array<Array<int> > vertEdgePartners_;
+  RaggedArray<int> vertEdgePartners_;
 
   /** map from local to global cell indices. The first index into this
    * 2D array is the cell dimension, the second the cell LID. */
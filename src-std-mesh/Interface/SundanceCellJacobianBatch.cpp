@@ -83,7 +83,8 @@ static Time& jacobianFactoringTimer()
 CellJacobianBatch::CellJacobianBatch()
   : spatialDim_(0), cellDim_(0), 
     jSize_(0), numCells_(0), numQuad_(0), iPiv_(), J_(), detJ_(), invJ_(),
-    isFactored_(false), hasInverses_(false)
+    isFactored_(false), hasInverses_(false), isClosedForm_(false),
+    soaIsCurrent_(false)
 {}
 
 void CellJacobianBatch::resize(int numCells, int numQuad, 
@@ -101,8 +102,11 @@ void CellJacobianBatch::resize(int numCells, int numQuad,
   iPiv_.resize(spatialDim_*numCells_*numQuad_);
   J_.resize(spatialDim_*spatialDim_*numCells_*numQuad_);
   detJ_.resize(numCells_*numQuad_);
+  if (hasClosedForm()) soaJ_.resize(jSize_*numCells_*numQuad_);
   isFactored_ = false;
   hasInverses_ = false;
+  isClosedForm_ = false;
+  soaIsCurrent_ = false;
 }
 
 void CellJacobianBatch::resize(int numCells, int spatialDim, int cellDim)
@@ -119,8 +123,11 @@ void CellJacobianBatch::resize(int numCells, int spatialDim, int cellDim)
   iPiv_.resize(spatialDim_*numCells_);
   J_.resize(spatialDim_*spatialDim_*numCells_);
   detJ_.resize(numCells_);
+  if (hasClosedForm()) soaJ_.resize(jSize_*numCells_);
   isFactored_ = false;
   hasInverses_ = false;
+  isClosedForm_ = false;
+  soaIsCurrent_ = false;
 }
 
 void CellJacobianBatch::factor() const 
@@ -136,6 +143,13 @@ void CellJacobianBatch::factor() const
   TEUCHOS_TEST_FOR_EXCEPTION(spatialDim_ != cellDim_, std::logic_error,
                      "Attempting to factor the Jacobian of a cell "
                      "that is not of maximal dimension");
+
+  if (hasClosedForm())
+    {
+      closedFormInvert();
+      return;
+    }
+
   Tabs tabs;
   SUNDANCE_OUT(this->verb() > 2,
                tabs << "factoring Jacobians");
@@ -176,6 +190,139 @@ void CellJacobianBatch::factor() const
   isFactored_ = true;
 }
 
+void CellJacobianBatch::finishSoAFill()
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(!hasClosedForm(), std::logic_error,
+    "CellJacobianBatch::finishSoAFill() called for a batch without "
+    "closed-form inversion");
+
+  int n = numCells_*numQuad_;
+  for (int k=0; k<jSize_; k++)
+    {
+      const double* src = &(soaJ_[k*n]);
+      for (int p=0; p<n; p++) J_[p*jSize_ + k] = src[p];
+    }
+  soaIsCurrent_ = true;
+  isFactored_ = false;
+  hasInverses_ = false;
+}
+
+void CellJacobianBatch::closedFormInvert() const 
+{
+  /* The (cell, quad) Jacobians are treated as column-major matrices 
+   * A(r,c) = J[r + D*c], the same convention as the LAPACK path, so
+   * that the inverses and applyInvJ() give identical results. All
+   * loops run over (cell, quad) pairs with unit stride. */
+  int n = numCells_*numQuad_;
+  int D = spatialDim_;
+
+  invJ_.resize(jSize_*n);
+  soaInvJ_.resize(jSize_*n);
+  isFactored_ = true;
+  hasInverses_ = true;
+  isClosedForm_ = true;
+  if (n == 0) return;
+
+  if (!soaIsCurrent_)
+    {
+      for (int k=0; k<jSize_; k++)
+        {
+          double* dest = &(soaJ_[k*n]);
+          for (int p=0; p<n; p++) dest[p] = J_[p*jSize_ + k];
+        }
+      soaIsCurrent_ = true;
+    }
+
+  const double* a = &(soaJ_[0]);
+  double* b = &(soaInvJ_[0]);
+  double* det = &(detJ_[0]);
+
+  switch(D)
+    {
+    case 1:
+      for (int p=0; p<n; p++)
+        {
+          det[p] = a[p];
+          b[p] = 1.0/a[p];
+        }
+      break;
+    case 2:
+      {
+        const double* a00 = a;
+        const double* a10 = a + n;
+        const double* a01 = a + 2*n;
+        const double* a11 = a + 3*n;
+        for (int p=0; p<n; p++)
+          {
+            double d = a00[p]*a11[p] - a01[p]*a10[p];
+            double s = 1.0/d;
+            det[p] = d;
+            b[p] = s*a11[p];
+            b[p+n] = -s*a10[p];
+            b[p+2*n] = -s*a01[p];
+            b[p+3*n] = s*a00[p];
+          }
+        break;
+      }
+    case 3:
+      {
+        const double* a00 = a;
+        const double* a10 = a + n;
+        const double* a20 = a + 2*n;
+        const double* a01 = a + 3*n;
+        const double* a11 = a + 4*n;
+        const double* a21 = a + 5*n;
+        const double* a02 = a + 6*n;
+        const double* a12 = a + 7*n;
+        const double* a22 = a + 8*n;
+        for (int p=0; p<n; p++)
+          {
+            /* cofactors; the inverse is the transposed cofactor 
+             * matrix divided by the determinant */
+            double c00 = a11[p]*a22[p] - a12[p]*a21[p];
+            double c01 = a12[p]*a20[p] - a10[p]*a22[p];
+            double c02 = a10[p]*a21[p] - a11[p]*a20[p];
+            double c10 = a02[p]*a21[p] - a01[p]*a22[p];
+            double c11 = a00[p]*a22[p] - a02[p]*a20[p];
+            double c12 = a01[p]*a20[p] - a00[p]*a21[p];
+            double c20 = a01[p]*a12[p] - a02[p]*a11[p];
+            double c21 = a02[p]*a10[p] - a00[p]*a12[p];
+            double c22 = a00[p]*a11[p] - a01[p]*a10[p];
+            double d = a00[p]*c00 + a01[p]*c01 + a02[p]*c02;
+            double s = 1.0/d;
+            det[p] = d;
+            b[p] = s*c00;
+            b[p+n] = s*c01;
+            b[p+2*n] = s*c02;
+            b[p+3*n] = s*c10;
+            b[p+4*n] = s*c11;
+            b[p+5*n] = s*c12;
+            b[p+6*n] = s*c20;
+            b[p+7*n] = s*c21;
+            b[p+8*n] = s*c22;
+          }
+        break;
+      }
+    default:
+      TEUCHOS_TEST_FOR_EXCEPT(true);
+    }
+
+  int numSingular = 0;
+  for (int p=0; p<n; p++) if (det[p] == 0.0) numSingular++;
+  TEUCHOS_TEST_FOR_EXCEPTION(numSingular > 0, std::runtime_error,
+    "CellJacobianBatch::closedFormInvert(): " << numSingular 
+    << " singular Jacobians in batch");
+
+  /* scatter the inverses into the standard layout */
+  for (int k=0; k<jSize_; k++)
+    {
+      const double* src = &(soaInvJ_[k*n]);
+      for (int p=0; p<n; p++) invJ_[p*jSize_ + k] = src[p];
+    }
+
+  addFlops(n * (D==1 ? 1.0 : (D==2 ? 10.0 : 50.0)));
+}
+
 void CellJacobianBatch::computeInverses() const 
 {
   TimeMonitor timer(jacobianInversionTimer());
@@ -188,6 +335,9 @@ void CellJacobianBatch::computeInverses() const
   invJ_.resize(spatialDim_*spatialDim_*numQuad_*numCells_);
 
   if (!isFactored_) factor();
+  /* the closed-form path computes the inverses along with the 
+   * determinants */
+  if (hasInverses_) return;
   
   for (int cell=0; cell<numCells_; cell++)
     {
@@ -228,6 +378,33 @@ void CellJacobianBatch::applyInvJ(int cell, int q,
 {
   if (!isFactored_) factor();
 
+  if (isClosedForm_)
+    {
+      /* multiply by the explicit inverse, stored column-major */
+      const double* inv = &(invJ_[(cell*numQuad_ + q)*jSize_]);
+      int D = spatialDim_;
+      double tmp[3];
+      for (int k=0; k<nRhs; k++)
+        {
+          double* b = rhs + k*D;
+          for (int r=0; r<D; r++)
+            {
+              tmp[r] = 0.0;
+              if (trans)
+                {
+                  for (int c=0; c<D; c++) tmp[r] += inv[c + D*r]*b[c];
+                }
+              else
+                {
+                  for (int c=0; c<D; c++) tmp[r] += inv[r + D*c]*b[c];
+                }
+            }
+          for (int r=0; r<D; r++) b[r] = tmp[r];
+        }
+      addFlops(2 * D * D * nRhs);
+      return;
+    }
+
   double* jFactPtr = &(J_[(cell*numQuad_ + q)*spatialDim_*spatialDim_]);
   int* iPiv = &(iPiv_[(q + cell*numQuad_)*spatialDim_]);
 
@@ -83,6 +83,16 @@ using namespace Teuchos;
  * the \f$(q + cN_{quad})D^2\f$-th
  * element.
  *
+ * <H4> Closed-form inversion </H4>
+ * When the cells are of maximal dimension and the dimension is 1, 2, or
+ * 3, determinants and inverses are computed in closed form for the whole
+ * batch at once, working on a structure-of-arrays copy of the Jacobians
+ * (all cells' values of one matrix entry stored contiguously) so that
+ * the loops over cells vectorize. In that case the Jacobian values
+ * are not overwritten by an LU factorization. Other cases, or all
+ * cases if useClosedForm() is false, use LAPACK LU factorization.
+ * A mesh can fill the structure-of-arrays form directly through 
+ * soaJVals() and finishSoAFill().
  */
 class CellJacobianBatch 
   : public ObjectWithClassVerbosity<CellJacobianBatch>
@@ -130,6 +140,29 @@ public:
   double* detJ(int c)
     {return &(detJ_[c]);}
 
+  /** Whether determinants and inverses for this batch are computed
+   * in closed form */
+  bool hasClosedForm() const 
+    {return useClosedForm() && spatialDim_==cellDim_ 
+        && spatialDim_ >= 1 && spatialDim_ <= 3;}
+
+  /**
+   * Get a pointer to the k-th Jacobian entry of all (cell, quad) pairs
+   * in structure-of-arrays form: the value for the q-th quadrature point
+   * on cell c is at offset c*numQuadPoints() + q. The index k follows
+   * the ordering used by jVals(). Valid only if hasClosedForm() is true.
+   * After filling all entries, call finishSoAFill().
+   */
+  double* soaJVals(int k)
+    {return &(soaJ_[k*numCells_*numQuad_]);}
+
+  /** 
+   * Complete a fill done through soaJVals() by copying the values into
+   * the standard layout. Determinants and inverses are computed 
+   * on demand as usual.
+   */
+  void finishSoAFill();
+
   /** get the vector of determinant values */
   const Array<double>& detJ() const 
     {if (!isFactored_ && cellDim()==spatialDim()) factor(); return detJ_;}
@@ -170,7 +203,27 @@ public:
 
 
 
-  static void addFlops(const double& flops) {totalFlops() += flops;}
+  static void addFlops(const double& flops) 
+    {
+      double& total = totalFlops();
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      total += flops;
+    }
+
+  /** 
+   * Compute the determinants and inverses of a batch of maximal cells 
+   * now rather than on first use. After this call the batch is not
+   * modified by const member functions, so it can be read by several 
+   * threads at once. 
+   */
+  void precomputeInverses() const 
+    {if (cellDim()==spatialDim()) computeInverses();}
+
+  /** Whether to use closed-form determinants and inverses for 
+   * maximal cells of dimension 1 to 3 */
+  static bool& useClosedForm() {static bool rtn=true; return rtn;}
 
 private:
           
@@ -178,6 +231,10 @@ private:
 
   void computeInverses() const ;
 
+  /** Compute determinants and inverses of all Jacobians in the batch
+   * in closed form, leaving the Jacobian values intact */
+  void closedFormInvert() const ;
+
   int spatialDim_;
   int cellDim_;
   int jSize_;
@@ -187,9 +244,13 @@ private:
   mutable Array<double> J_;
   mutable Array<double>  detJ_;
   mutable Array<double>  invJ_;
+  mutable Array<double>  soaJ_;
+  mutable Array<double>  soaInvJ_;
   mutable bool isFactored_;
   mutable bool hasInverses_;
   mutable bool hasDetJ_;
+  mutable bool isClosedForm_;
+  mutable bool soaIsCurrent_;
 };
 
 
@@ -74,6 +74,9 @@ class MeshBase;
  * \endcode
  * which return the index of the first cell to be processed,
  * and a past-the-end index. 
+ *
+ * Reorderers apply to the maximal cells only; CellIterator walks
+ * cells of lower dimension in LID order.
  */
 class CellReordererImplemBase 
   : public ObjectWithClassVerbosity<CellReordererImplemBase>
@@ -96,6 +99,11 @@ public:
       
   /** */
   virtual int end() const ;
+
+  /** Whether this reorderer leaves the cells in LID order. Iterators
+   * ignore identity reorderers so that they can walk cells in 
+   * contiguous blocks. */
+  virtual bool isIdentity() const {return false;}
 protected:
   /** */
   const MeshBase* mesh() const {return mesh_;}
@@ -68,6 +68,9 @@ public:
     
   /** */
   virtual int advance(int currentLID) const {return currentLID+1;}
+
+  /** */
+  virtual bool isIdentity() const {return true;}
 };
 
 
@@ -68,6 +68,8 @@ Mesh MeshType::createEmptyMesh(int dim, const MPIComm& comm) const
   try
     {
       rtn = ptr()->createEmptyMesh(dim, comm);
+      const CellReorderer& reorderer = ptr()->reorderer();
+      if (reorderer.ptr().get() != 0) rtn.setReorderer(reorderer);
     }
   catch(std::exception& e)
     {
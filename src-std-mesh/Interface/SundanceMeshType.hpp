@@ -59,7 +59,12 @@ namespace Sundance
  * MeshSource meshSrc = new TriangleMeshReader("meshFile", meshType, MPIComm::world());
  * \endcode
  * The internal representation of the mesh will be as a BasicSimplicialMesh
- * object. 
+ * object. A cell reorderer can be attached to the mesh type, in which
+ * case it is installed in every mesh the type creates:
+ * \code
+ * MeshType meshType = new BasicSimplicialMeshType();
+ * meshType.setReorderer(new HilbertReorderer());
+ * \endcode
  */
 class MeshType : public Playa::Handle<MeshTypeBase>
 {
@@ -75,6 +80,10 @@ public:
 
   /** Create a mesh of the given dimension */
   Mesh createEmptyMesh(int dim, const MPIComm& comm) const ;
+
+  /** Set the cell reorderer to be used by meshes of this type */
+  void setReorderer(const CellReorderer& reorderer) 
+    {ptr()->setReorderer(reorderer);}
     
 };
 }
@@ -74,8 +74,19 @@ public:
   virtual RCP<MeshBase> createEmptyMesh(int dim,
     const MPIComm& comm) const = 0 ;
 
+  /** Set the cell reorderer to be installed in meshes created by this
+   * type. If never set, meshes keep their default (identity) ordering. */
+  void setReorderer(const CellReorderer& reorderer) 
+    {reorderer_ = reorderer;}
+
+  /** */
+  const CellReorderer& reorderer() const {return reorderer_;}
+
   /** */
   virtual void print(std::ostream& os) const {os << description();}
+
+private:
+  CellReorderer reorderer_;
 };
 }
 
@@ -0,0 +1,93 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundancePermutationReorderer.hpp"
+#include "SundanceMeshBase.hpp"
+#include "PlayaExceptions.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+PermutationReordererImplemBase
+::PermutationReordererImplemBase(const MeshBase* mesh) 
+  : CellReordererImplemBase(mesh), order_(), position_() {;}
+
+void PermutationReordererImplemBase::update() const
+{
+  int n = end();
+  if (order_.size() == n) return;
+
+  order_.resize(0);
+  computeOrdering(order_);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(order_.size() != n, std::logic_error,
+    "reorderer " << typeName() << " produced an ordering of length "
+    << order_.size() << " for a mesh with " << n << " maximal cells");
+
+  position_.resize(n);
+  for (int i=0; i<n; i++) position_[i] = -1;
+  for (int i=0; i<n; i++) 
+  {
+    int lid = order_[i];
+    TEUCHOS_TEST_FOR_EXCEPTION(lid < 0 || lid >= n || position_[lid] != -1,
+      std::logic_error, "reorderer " << typeName() 
+      << " produced an invalid permutation");
+    position_[lid] = i;
+  }
+}
+
+int PermutationReordererImplemBase::begin() const
+{
+  update();
+  if (order_.size()==0) return end();
+  return order_[0];
+}
+
+int PermutationReordererImplemBase::advance(int currentLID) const
+{
+  update();
+  TEUCHOS_TEST_FOR_EXCEPTION(currentLID < 0 || currentLID >= position_.size(),
+    std::logic_error, "reorderer " << typeName() << " asked to advance "
+    "from LID " << currentLID << ", which is not a maximal cell");
+  int next = position_[currentLID] + 1;
+  if (next < order_.size()) return order_[next];
+  return end();
+}
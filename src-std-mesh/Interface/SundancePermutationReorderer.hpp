@@ -0,0 +1,95 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_PERMUTATIONREORDERER_H
+#define SUNDANCE_PERMUTATIONREORDERER_H
+
+
+#include "SundanceDefs.hpp"
+#include "SundanceCellReordererImplemBase.hpp"
+#include "Teuchos_Array.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * Base class for reorderers that visit the maximal cells according to
+ * a precomputed permutation. Subclasses implement computeOrdering(), 
+ * which fills in the LIDs of all maximal cells in the order they 
+ * should be visited. The permutation is computed the first time 
+ * the cells are walked, and recomputed if the number of cells
+ * changes, so the reorderer can be attached to a mesh before
+ * the mesh has been filled.
+ */
+class PermutationReordererImplemBase : public CellReordererImplemBase
+{
+public:
+  /** */
+  PermutationReordererImplemBase(const MeshBase* mesh);
+      
+  /** */
+  virtual ~PermutationReordererImplemBase(){;}
+
+  /** */
+  virtual int advance(int currentLID) const ;
+
+  /** */
+  virtual int begin() const ;
+
+protected:
+  /** Fill in the LIDs of the maximal cells in the order they are 
+   * to be visited */
+  virtual void computeOrdering(Array<int>& order) const = 0 ;
+
+private:
+  /** Compute the permutation if it is missing or out of date */
+  void update() const ;
+
+  mutable Array<int> order_;
+
+  mutable Array<int> position_;
+};
+
+}
+
+
+#endif
@@ -0,0 +1,200 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceRCMReorderer.hpp"
+#include "SundanceMeshBase.hpp"
+#include "PlayaExceptions.hpp"
+#include <algorithm>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+namespace
+{
+/* Compares graph nodes by degree, breaking ties by index */
+class DegreeLess
+{
+public:
+  DegreeLess(const Array<int>& ptr) : ptr_(ptr) {}
+  bool operator()(int a, int b) const 
+    {
+      int da = ptr_[a+1] - ptr_[a];
+      int db = ptr_[b+1] - ptr_[b];
+      if (da != db) return da < db;
+      return a < b;
+    }
+private:
+  const Array<int>& ptr_;
+};
+
+/* Breadth-first search from root over nodes not yet numbered. On return,
+ * level holds the nodes in visit order; the return value is the 
+ * number of levels, and lastLevelStart the position in level at which 
+ * the final level begins. The mark array is left cleared. */
+int bfsLevels(int root, const Array<int>& ptr, const Array<int>& adj,
+  const Array<int>& numbered, Array<int>& mark, Array<int>& level,
+  int& lastLevelStart)
+{
+  level.resize(0);
+  level.append(root);
+  mark[root] = 1;
+  int nLevels = 0;
+  int start = 0;
+  while (start < level.size())
+  {
+    nLevels++;
+    lastLevelStart = start;
+    int stop = level.size();
+    for (int k=start; k<stop; k++)
+    {
+      int v = level[k];
+      for (int j=ptr[v]; j<ptr[v+1]; j++)
+      {
+        int w = adj[j];
+        if (mark[w] || numbered[w]) continue;
+        mark[w] = 1;
+        level.append(w);
+      }
+    }
+    start = stop;
+  }
+  for (int k=0; k<level.size(); k++) mark[level[k]] = 0;
+  return nLevels;
+}
+}
+
+RCMReordererImplem::RCMReordererImplem(const MeshBase* mesh) 
+  : PermutationReordererImplemBase(mesh) {;}
+
+void RCMReordererImplem::computeOrdering(Array<int>& order) const
+{
+  int dim = mesh()->spatialDim();
+  int n = mesh()->numCells(dim);
+
+  /* build the facet-adjacency graph of the maximal cells */
+  Array<int> ptr(n+1);
+  Array<int> adj;
+  adj.reserve((dim+1)*n);
+  Array<int> cofacets;
+  ptr[0] = 0;
+  for (int c=0; c<n; c++)
+  {
+    int nf = mesh()->numFacets(dim, c, dim-1);
+    for (int f=0; f<nf; f++)
+    {
+      int ori;
+      int facet = mesh()->facetLID(dim, c, dim-1, f, ori);
+      mesh()->getCofacets(dim-1, facet, dim, cofacets);
+      for (int k=0; k<cofacets.size(); k++)
+      {
+        if (cofacets[k] != c) adj.append(cofacets[k]);
+      }
+    }
+    ptr[c+1] = adj.size();
+  }
+
+  reverseCuthillMcKee(ptr, adj, order);
+}
+
+
+namespace Sundance
+{
+void reverseCuthillMcKee(const Array<int>& ptr, const Array<int>& adj,
+  Array<int>& order)
+{
+  int n = ptr.size() - 1;
+  DegreeLess degreeLess(ptr);
+  Array<int> numbered(n, 0);
+  Array<int> mark(n, 0);
+  Array<int> level;
+  Array<int> nbrs;
+  order.resize(0);
+  order.reserve(n);
+
+  for (int s=0; s<n; s++)
+  {
+    if (numbered[s]) continue;
+
+    /* find a pseudo-peripheral root for this component: repeatedly jump 
+     * to a minimum-degree node in the last BFS level while the 
+     * eccentricity keeps growing */
+    int root = s;
+    int lastStart = 0;
+    int ecc = bfsLevels(root, ptr, adj, numbered, mark, level, lastStart);
+    for (int iter=0; iter<8; iter++)
+    {
+      int cand = level[lastStart];
+      for (int k=lastStart+1; k<level.size(); k++)
+      {
+        if (degreeLess(level[k], cand)) cand = level[k];
+      }
+      int candStart = 0;
+      int candEcc = bfsLevels(cand, ptr, adj, numbered, mark, level, 
+        candStart);
+      if (candEcc <= ecc) break;
+      root = cand;
+      ecc = candEcc;
+      lastStart = candStart;
+    }
+
+    /* Cuthill-McKee breadth-first numbering from the root */
+    int head = order.size();
+    order.append(root);
+    numbered[root] = 1;
+    while (head < order.size())
+    {
+      int v = order[head++];
+      nbrs.resize(0);
+      for (int j=ptr[v]; j<ptr[v+1]; j++)
+      {
+        int w = adj[j];
+        if (numbered[w]) continue;
+        numbered[w] = 1;
+        nbrs.append(w);
+      }
+      std::sort(nbrs.begin(), nbrs.end(), degreeLess);
+      for (int k=0; k<nbrs.size(); k++) order.append(nbrs[k]);
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+}
+}
@@ -0,0 +1,99 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_RCMREORDERER_H
+#define SUNDANCE_RCMREORDERER_H
+
+
+#include "SundanceDefs.hpp"
+#include "SundancePermutationReorderer.hpp"
+#include "SundanceCellReordererBase.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * Compute a reverse Cuthill-McKee ordering of a graph given in compressed
+ * row form: the neighbors of node i are adj[ptr[i]] through adj[ptr[i+1]-1].
+ * On return, order[k] is the node placed at position k. Each connected 
+ * component is started from a pseudo-peripheral node found with the 
+ * George-Liu heuristic, and neighbors are visited in order of
+ * increasing degree.
+ */
+void reverseCuthillMcKee(const Array<int>& ptr, const Array<int>& adj,
+  Array<int>& order);
+
+/**
+ * Visits cells in reverse Cuthill-McKee order on the graph in which 
+ * two maximal cells are adjacent if they share a facet.
+ */
+class RCMReordererImplem : public PermutationReordererImplemBase
+{
+public:
+  /** */
+  RCMReordererImplem(const MeshBase* mesh);
+      
+  /** */
+  virtual ~RCMReordererImplem(){;}
+
+protected:
+  /** */
+  virtual void computeOrdering(Array<int>& order) const ;
+};
+
+
+/** */
+class RCMReorderer 
+  : public GenericCellReordererFactory<RCMReordererImplem>
+{
+public:
+  RCMReorderer(){;}
+
+  virtual ~RCMReorderer(){;}
+
+  GET_RCP(CellReordererFactoryBase);
+};
+
+}
+
+
+#endif
@@ -0,0 +1,170 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceSpaceFillingCurveReorderer.hpp"
+#include "SundanceMeshBase.hpp"
+#include "PlayaExceptions.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+namespace 
+{
+/* Sort key: curve index, then LID so that ties keep mesh order */
+struct CurveKey
+{
+  unsigned int index;
+  int lid;
+  bool operator<(const CurveKey& other) const 
+    {
+      if (index != other.index) return index < other.index;
+      return lid < other.lid;
+    }
+};
+}
+
+SpaceFillingCurveReordererImplem
+::SpaceFillingCurveReordererImplem(const MeshBase* mesh) 
+  : PermutationReordererImplemBase(mesh) {;}
+
+unsigned int SpaceFillingCurveReordererImplem::interleave(
+  const unsigned int* x, int dim, int bits)
+{
+  unsigned int rtn = 0;
+  for (int b=bits-1; b>=0; b--)
+  {
+    for (int i=0; i<dim; i++)
+    {
+      rtn = (rtn << 1) | ((x[i] >> b) & 1u);
+    }
+  }
+  return rtn;
+}
+
+void SpaceFillingCurveReordererImplem::computeOrdering(Array<int>& order) const
+{
+  int dim = mesh()->spatialDim();
+  int n = mesh()->numCells(dim);
+  int bits = 32/dim;
+
+  Array<Point> centroids(n);
+  for (int c=0; c<n; c++) centroids[c] = mesh()->centroid(dim, c);
+
+  /* bounding box of the centroids */
+  double lo[3] = {0.0, 0.0, 0.0};
+  double hi[3] = {0.0, 0.0, 0.0};
+  for (int c=0; c<n; c++)
+  {
+    for (int i=0; i<dim; i++)
+    {
+      double x = centroids[c][i];
+      if (c==0 || x < lo[i]) lo[i] = x;
+      if (c==0 || x > hi[i]) hi[i] = x;
+    }
+  }
+
+  double gridMax = (double) ((bits==32) ? 0xffffffffu : ((1u << bits) - 1u));
+  double scale[3];
+  for (int i=0; i<dim; i++) 
+  {
+    scale[i] = (hi[i] > lo[i]) ? gridMax/(hi[i] - lo[i]) : 0.0;
+  }
+
+  std::vector<CurveKey> keys(n);
+  unsigned int q[3];
+  for (int c=0; c<n; c++)
+  {
+    for (int i=0; i<dim; i++)
+    {
+      double s = (centroids[c][i] - lo[i])*scale[i];
+      if (s > gridMax) s = gridMax;
+      q[i] = (unsigned int) s;
+    }
+    keys[c].index = curveIndex(q, dim, bits);
+    keys[c].lid = c;
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  order.resize(n);
+  for (int c=0; c<n; c++) order[c] = keys[c].lid;
+}
+
+unsigned int HilbertReordererImplem::curveIndex(unsigned int* x, int dim,
+  int bits) const
+{
+  /* Skilling's AxesToTranspose: convert the coordinates in place to 
+   * the "transposed" Hilbert index, whose interleaved bits are the 
+   * Hilbert index proper. */
+  unsigned int M = 1u << (bits-1);
+
+  /* inverse undo */
+  for (unsigned int Q=M; Q>1; Q >>= 1)
+  {
+    unsigned int P = Q - 1;
+    for (int i=0; i<dim; i++)
+    {
+      if (x[i] & Q) 
+      {
+        x[0] ^= P;
+      }
+      else
+      {
+        unsigned int t = (x[0] ^ x[i]) & P;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  /* Gray encode */
+  for (int i=1; i<dim; i++) x[i] ^= x[i-1];
+  unsigned int t = 0;
+  for (unsigned int Q=M; Q>1; Q >>= 1)
+  {
+    if (x[dim-1] & Q) t ^= Q - 1;
+  }
+  for (int i=0; i<dim; i++) x[i] ^= t;
+
+  return interleave(x, dim, bits);
+}
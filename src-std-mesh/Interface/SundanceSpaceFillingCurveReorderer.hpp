@@ -0,0 +1,155 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_SPACEFILLINGCURVEREORDERER_H
+#define SUNDANCE_SPACEFILLINGCURVEREORDERER_H
+
+
+#include "SundanceDefs.hpp"
+#include "SundancePermutationReorderer.hpp"
+#include "SundanceCellReordererBase.hpp"
+
+namespace Sundance
+{
+using namespace Teuchos;
+
+/**
+ * Base class for reorderers that visit the maximal cells in the order 
+ * in which their centroids are reached by a space-filling curve. 
+ * Centroids are quantized onto a \f$2^b\f$ grid in each direction 
+ * of the mesh's bounding box, with \f$b=32/d\f$ in \f$d\f$ dimensions,
+ * and cells are sorted by the curve index of their grid point. Cells that 
+ * fall in the same grid box keep their relative LID order.
+ */
+class SpaceFillingCurveReordererImplem 
+  : public PermutationReordererImplemBase
+{
+public:
+  /** */
+  SpaceFillingCurveReordererImplem(const MeshBase* mesh);
+      
+  /** */
+  virtual ~SpaceFillingCurveReordererImplem(){;}
+
+protected:
+  /** */
+  virtual void computeOrdering(Array<int>& order) const ;
+
+  /** 
+   * Compute the curve index of a grid point.
+   * @param x the grid coordinates of the point. May be overwritten.
+   * @param dim the spatial dimension
+   * @param bits the number of bits per coordinate
+   */
+  virtual unsigned int curveIndex(unsigned int* x, int dim, 
+    int bits) const = 0 ;
+
+  /** Interleave the bits of the coordinates, most significant first */
+  static unsigned int interleave(const unsigned int* x, int dim, int bits) ;
+};
+
+/**
+ * Visits cells along a Morton (Z-order) curve.
+ */
+class MortonReordererImplem : public SpaceFillingCurveReordererImplem
+{
+public:
+  /** */
+  MortonReordererImplem(const MeshBase* mesh)
+    : SpaceFillingCurveReordererImplem(mesh) {;}
+
+protected:
+  /** */
+  virtual unsigned int curveIndex(unsigned int* x, int dim, 
+    int bits) const 
+    {return interleave(x, dim, bits);}
+};
+
+/**
+ * Visits cells along a Hilbert curve. Hilbert indices are computed with 
+ * Skilling's transpose algorithm (AIP Conf. Proc. 707, 2004), which 
+ * works in any number of dimensions. Consecutive cells along a Hilbert
+ * curve are always face neighbors on the quantization grid, so 
+ * Hilbert ordering usually gives somewhat better locality than Morton 
+ * ordering.
+ */
+class HilbertReordererImplem : public SpaceFillingCurveReordererImplem
+{
+public:
+  /** */
+  HilbertReordererImplem(const MeshBase* mesh)
+    : SpaceFillingCurveReordererImplem(mesh) {;}
+
+protected:
+  /** */
+  virtual unsigned int curveIndex(unsigned int* x, int dim, 
+    int bits) const ;
+};
+
+
+/** */
+class MortonReorderer 
+  : public GenericCellReordererFactory<MortonReordererImplem>
+{
+public:
+  MortonReorderer(){;}
+
+  virtual ~MortonReorderer(){;}
+
+  GET_RCP(CellReordererFactoryBase);
+};
+
+/** */
+class HilbertReorderer 
+  : public GenericCellReordererFactory<HilbertReordererImplem>
+{
+public:
+  HilbertReorderer(){;}
+
+  virtual ~HilbertReorderer(){;}
+
+  GET_RCP(CellReordererFactoryBase);
+};
+
+}
+
+
+#endif
@@ -143,7 +143,14 @@ Mesh BamgMeshReader::fillMesh() const
 
   //readElems(mesh, ptGID, cellGID, cellOwner); //readMesh reads nodes+elems
 
-  mesh = readMesh(ptGID, ptOwner); //new -- replaces readNodes, readElems
+  if (useFastParser())
+    {
+      mesh = readMeshFast(ptGID, ptOwner);
+    }
+  else
+    {
+      mesh = readMesh(ptGID, ptOwner); //new -- replaces readNodes, readElems
+    }
 
   //  mesh.assignGlobalIndices();
 
@@ -947,3 +954,188 @@ return vel;
 }
 
 */
+
+
+
+/* Bamg keywords are the only entries in a .mesh file that don't start
+ * with a number */
+static bool isBamgKeyword(const std::string& word)
+{
+  return word.length() > 0 
+    && ((word[0] >= 'a' && word[0] <= 'z') || (word[0] >= 'A' && word[0] <= 'Z'));
+}
+
+/* A keyword's value may appear either on the keyword line itself 
+ * or on the following line */
+static int readBamgCount(MeshFileBuffer& buf)
+{
+  if (buf.atEndOfLine()) 
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(!buf.nextLine(), std::runtime_error,
+        "BamgMeshReader: unexpected end of file " << buf.filename()
+        << " while looking for a section count");
+    }
+  return buf.readInt();
+}
+
+Mesh BamgMeshReader::readMeshFast(Array<int>& ptGID, 
+                                  Array<int>& ptOwner) const 
+{
+  Mesh mesh;
+  RCP<MeshFileBuffer> buf = openBuffer(meshFilename_, "node & elem info");
+
+  int dimension = 0;
+  int nPoints = -1;
+  int nCells = -1;
+  /* Bamg numbers vertices starting from 1 */
+  const int offset = 1;
+
+  Array<double> velVector;
+  int nAttributes = 0;
+
+  while (buf->nextLine())
+    {
+      std::string word = buf->readWord();
+      if (!isBamgKeyword(word)) continue;
+
+      if (word == "Dimension")
+        {
+          dimension = readBamgCount(*buf);
+        }
+      else if (word == "Vertices")
+        {
+          TEUCHOS_TEST_FOR_EXCEPTION(dimension==0, std::runtime_error,
+            "BamgMeshReader::readMeshFast() found Vertices section "
+            "before Dimension in file " << meshFilename_);
+
+          nPoints = readBamgCount(*buf);
+          SUNDANCE_OUT(this->verb() > 3,
+                       "expecting to read " << nPoints << " points");
+          ptGID.resize(nPoints);
+          ptOwner.resize(nPoints);
+          for (int i=0; i<nPoints; i++)
+            {
+              ptGID[i] = i;
+              ptOwner[i] = 0;
+            }
+
+          if (bbAttr_) nAttributes = readVelocitiesFast(nPoints, velVector);
+
+          mesh = createMesh(dimension);
+          mesh.estimateNumVertices(nPoints);
+          nodeAttributes()->resize(nPoints);
+
+          for (int count=0; count<nPoints; count++)
+            {
+              TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine(), std::runtime_error,
+                "BamgMeshReader::readMeshFast() found only " << count
+                << " of " << nPoints << " vertices in file " 
+                << meshFilename_);
+
+              double x = buf->readDouble();
+              double y = buf->readDouble();
+              Point pt;
+              if (dimension==3)
+                {
+                  double z = buf->readDouble();
+                  pt = Point(x,y,z);
+                }
+              else
+                {
+                  pt = Point(x,y);
+                }
+              int ptLabel = 0;
+              mesh.addVertex(ptGID[count], pt, ptOwner[count], ptLabel);
+
+              Array<double>& attr = (*nodeAttributes())[count];
+              attr.resize(nAttributes);
+              for (int i=0; i<nAttributes; i++) attr[i] = 0.0;
+              if (nAttributes > 0) attr[0] = velVector[count];
+              if (nAttributes > 1) attr[1] = velVector[count + nPoints];
+            }
+        }
+      else if (word == "Triangles")
+        {
+          TEUCHOS_TEST_FOR_EXCEPTION(nPoints < 0, std::runtime_error,
+            "BamgMeshReader::readMeshFast() found Triangles section "
+            "before Vertices in file " << meshFilename_);
+
+          nCells = readBamgCount(*buf);
+          mesh.estimateNumElements(nCells);
+          elemAttributes()->resize(nCells);
+
+          int dim = mesh.spatialDim();
+          Array<int> nodes(dim+1);
+
+          for (int count=0; count<nCells; count++)
+            {
+              TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine(), std::runtime_error,
+                "BamgMeshReader::readMeshFast() found only " << count
+                << " of " << nCells << " triangles in file " 
+                << meshFilename_);
+
+              for (int d=0; d<=dim; d++)
+                {
+                  int v = buf->readInt() - offset;
+                  TEUCHOS_TEST_FOR_EXCEPTION(v < 0 || v >= nPoints, 
+                    std::runtime_error,
+                    "BamgMeshReader::readMeshFast() found out-of-range "
+                    "vertex index in line \n[" << buf->currentLine() 
+                    << "]\n in file " << meshFilename_);
+                  nodes[d] = ptGID[v];
+                }
+              int elemLabel = 0;
+              mesh.addElement(count, nodes, 0, elemLabel);
+              (*elemAttributes())[count].resize(0);
+            }
+        }
+      else if (word == "SubDomainFromMesh" || word == "End") 
+        {
+          break;
+        }
+    }
+
+  TEUCHOS_TEST_FOR_EXCEPTION(nCells < 0, std::runtime_error,
+    "BamgMeshReader::readMeshFast() found no Triangles section in file "
+    << meshFilename_);
+
+  return mesh;
+}
+
+int BamgMeshReader::readVelocitiesFast(int nPoints, 
+                                       Array<double>& vel) const 
+{
+  RCP<MeshFileBuffer> buf = openBuffer(bbFilename_, "velocity info");
+
+  /* header: dimension, solutions per vertex, number of vertices, 
+   * solution type */
+  TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine() || buf->countEntries() != 4, 
+    std::runtime_error,
+    "BamgMeshReader::readVelocitiesFast() requires 4 entries on the "
+    "header line of file " << bbFilename_);
+
+  int bbDim = buf->readInt();
+  int nSolns = buf->readInt();
+  int bbPoints = buf->readInt();
+
+  TEUCHOS_TEST_FOR_EXCEPTION(bbDim != 2, std::runtime_error,
+    "BamgMeshReader::readVelocitiesFast() expected dimension 2, found "
+    << bbDim << " in file " << bbFilename_);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(bbPoints != nPoints, std::runtime_error,
+    "BamgMeshReader::readVelocitiesFast() found " << bbPoints 
+    << " points in file " << bbFilename_ << " but the mesh has "
+    << nPoints);
+
+  vel.resize(2*nPoints);
+  for (int i=0; i<nPoints; i++)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine(), std::runtime_error,
+        "BamgMeshReader::readVelocitiesFast() found only " << i
+        << " of " << nPoints << " solution lines in file " << bbFilename_);
+      vel[i] = buf->readDouble();
+      vel[i+nPoints] = buf->readDouble();
+    }
+
+  return nSolns;
+}
@@ -154,6 +154,16 @@ private:
   /** add method for reading a .bb file */
   //Array<double> getVelocityField(const std::string& bbFile) const ;
 
+  /** Read nodes and elements from the .mesh file by parsing in place
+   * from a mapped buffer */
+  Mesh readMeshFast(Array<int>& ptGID,
+    Array<int>& ptOwner) const ;
+
+  /** Read the velocity field from the .bb file by parsing in place.
+   * Upon return, vel holds the x components of all nodes followed by
+   * the y components. Returns the number of solutions per node. */
+  int readVelocitiesFast(int nPoints, Array<double>& vel) const ;
+
   /** */
   std::string nodeFilename_;
 
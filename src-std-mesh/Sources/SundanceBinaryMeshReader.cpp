@@ -0,0 +1,112 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceBinaryMeshReader.hpp"
+#include "SundanceBasicSimplicialMesh.hpp"
+#include "SundanceOut.hpp"
+#include "PlayaExceptions.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+
+using namespace Teuchos;
+using namespace Sundance;
+
+static Time& binaryReaderFillTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("binary mesh reader fillMesh"); 
+  return *rtn;
+}
+
+
+BinaryMeshReader::BinaryMeshReader(const std::string& fname,
+                                   const MeshType& meshType,
+                                   int verbosity,
+                                   const MPIComm& comm)
+  : MeshReaderBase(fname, meshType, verbosity, comm),
+    meshFilename_(checkpointFilename(filename(), nProc(), myRank()))
+{
+  SUNDANCE_OUT(this->verb() > 1,
+               "checkpoint filename = " << meshFilename_);
+}
+
+BinaryMeshReader::BinaryMeshReader(const ParameterList& params)
+  : MeshReaderBase(params),
+    meshFilename_(checkpointFilename(filename(), nProc(), myRank()))
+{
+  SUNDANCE_OUT(this->verb() > 1,
+               "checkpoint filename = " << meshFilename_);
+}
+
+std::string BinaryMeshReader::checkpointFilename(const std::string& stem,
+                                                 int nProc, int rank)
+{
+  if (nProc > 1)
+    {
+      return stem + "." + Teuchos::toString(nProc) 
+        + "." + Teuchos::toString(rank) + ".smesh";
+    }
+  return stem + ".smesh";
+}
+
+Mesh BinaryMeshReader::fillMesh() const 
+{
+  TimeMonitor timer(binaryReaderFillTimer());
+
+  RCP<MeshFileBuffer> buf = openBuffer(meshFilename_, "mesh checkpoint");
+
+  int dim = BasicSimplicialMesh::checkpointDimension(buf->data(), 
+    buf->size());
+
+  Mesh mesh = createMesh(dim);
+
+  BasicSimplicialMesh* bsm 
+    = dynamic_cast<BasicSimplicialMesh*>(mesh.ptr().get());
+
+  TEUCHOS_TEST_FOR_EXCEPTION(bsm==0, std::runtime_error,
+    "BinaryMeshReader::fillMesh() requires a BasicSimplicialMesh, "
+    "but the mesh type created a different mesh class");
+
+  bsm->readCheckpoint(buf->data(), buf->size());
+
+  return mesh;
+}
@@ -0,0 +1,106 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_BINARYMESHREADER_H
+#define SUNDANCE_BINARYMESHREADER_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceMeshReaderBase.hpp"
+
+namespace Sundance
+{
+  using namespace Teuchos;
+  
+  /**
+   * BinaryMeshReader reloads a mesh from the native binary checkpoint
+   * files written by BinaryMeshWriter. The checkpoint holds the fully 
+   * built mesh, including intermediate-dimension cells, connectivity,
+   * GID numbering, labels, and ownership, so reloading skips the 
+   * element-by-element construction done by the text readers. The file
+   * is mapped into memory and its tables are copied directly into 
+   * the mesh.
+   *
+   * A reader constructed with filename <tt>joe</tt> reads 
+   * <tt>joe.smesh</tt> in serial. On <i>np</i> processors, processor 
+   * <i>p</i> reads <tt>joe.</tt><i>np</i><tt>.</tt><i>p</i><tt>.smesh</tt>,
+   * and the checkpoint must have been written with the same number 
+   * of processors.
+   *
+   * Checkpoints can only be loaded into meshes of type 
+   * BasicSimplicialMeshType.
+   */
+  class BinaryMeshReader : public MeshReaderBase
+  {
+  public:
+    /** */
+    BinaryMeshReader(const std::string& filename, 
+      const MeshType& meshType,
+      int verbosity=0,
+      const MPIComm& comm = MPIComm::world());
+
+    /** Construct from a ParameterList */
+    BinaryMeshReader(const ParameterList& params);
+
+    /** virtual dtor */
+    virtual ~BinaryMeshReader(){;}
+
+    /** Create a mesh */
+    virtual Mesh fillMesh() const ;
+
+    /** Print a short descriptive std::string */
+    virtual std::string description() const 
+    {return "BinaryMeshReader[file=" + filename() + "]";}
+
+    /** Return a ref count pointer to self */
+    virtual RCP<MeshSourceBase> getRcp() {return rcp(this);}
+
+    /** Return the name of the checkpoint file used by processor
+     * rank of nProc for the given stem */
+    static std::string checkpointFilename(const std::string& stem,
+      int nProc, int rank) ;
+
+  private:
+    /** */
+    std::string meshFilename_;
+  };
+}
+
+#endif
@@ -0,0 +1,272 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceMeshFileBuffer.hpp"
+#include "PlayaExceptions.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SUNDANCE_HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace Sundance;
+using namespace Teuchos;
+
+
+MeshFileBuffer::MeshFileBuffer(const std::string& filename, char comment)
+  : filename_(filename),
+    comment_(comment),
+    begin_(0),
+    end_(0),
+    pos_(0),
+    lineStart_(0),
+    size_(0),
+    isMapped_(false),
+    started_(false),
+    heapData_(0)
+{
+#ifdef SUNDANCE_HAVE_MMAP
+  int fd = open(filename.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPTION(fd < 0, std::runtime_error,
+    "MeshFileBuffer unable to open file " << filename);
+
+  struct stat info;
+  if (fstat(fd, &info)==0 && info.st_size > 0)
+  {
+    size_ = info.st_size;
+    void* addr = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED)
+    {
+#ifdef MADV_SEQUENTIAL
+      madvise(addr, size_, MADV_SEQUENTIAL);
+#endif
+      begin_ = static_cast<const char*>(addr);
+      isMapped_ = true;
+    }
+  }
+  close(fd);
+#endif
+
+  /* If the file could not be mapped, read it in one block */
+  if (!isMapped_)
+  {
+    FILE* fp = std::fopen(filename.c_str(), "rb");
+    TEUCHOS_TEST_FOR_EXCEPTION(fp==0, std::runtime_error,
+      "MeshFileBuffer unable to open file " << filename);
+    std::fseek(fp, 0, SEEK_END);
+    long n = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    size_ = (n > 0) ? n : 0;
+    heapData_ = new char[size_ + 1];
+    size_t nRead = std::fread(heapData_, 1, size_, fp);
+    std::fclose(fp);
+    TEUCHOS_TEST_FOR_EXCEPTION(nRead != size_, std::runtime_error,
+      "MeshFileBuffer read " << nRead << " of " << size_ 
+      << " bytes from file " << filename);
+    heapData_[size_] = '\0';
+    begin_ = heapData_;
+  }
+
+  end_ = begin_ + size_;
+  pos_ = begin_;
+  lineStart_ = begin_;
+}
+
+MeshFileBuffer::~MeshFileBuffer()
+{
+#ifdef SUNDANCE_HAVE_MMAP
+  if (isMapped_) munmap(const_cast<char*>(begin_), size_);
+#endif
+  delete [] heapData_;
+}
+
+bool MeshFileBuffer::nextLine()
+{
+  const char* p = pos_;
+
+  /* skip whatever is left of the current line */
+  if (started_)
+  {
+    while (p < end_ && *p != '\n') p++;
+    if (p < end_) p++;
+  }
+  started_ = true;
+
+  while (p < end_)
+  {
+    const char* q = p;
+    while (q < end_ && (*q==' ' || *q=='\t')) q++;
+    if (q < end_ && !isEndOfLine(*q))
+    {
+      lineStart_ = p;
+      pos_ = q;
+      return true;
+    }
+    /* blank or comment line: skip to its end */
+    p = q;
+    while (p < end_ && *p != '\n') p++;
+    if (p < end_) p++;
+  }
+  lineStart_ = end_;
+  pos_ = end_;
+  return false;
+}
+
+void MeshFileBuffer::skipBlanks() const
+{
+  while (pos_ < end_ && (*pos_==' ' || *pos_=='\t')) pos_++;
+}
+
+const char* MeshFileBuffer::endOfEntry(const char* p) const
+{
+  while (p < end_ && *p!=' ' && *p!='\t'&& !isEndOfLine(*p)) p++;
+  return p;
+}
+
+bool MeshFileBuffer::atEndOfLine() const 
+{
+  skipBlanks();
+  return pos_ >= end_ || isEndOfLine(*pos_);
+}
+
+int MeshFileBuffer::countEntries() const 
+{
+  const char* save = pos_;
+  int n = 0;
+  while (!atEndOfLine())
+  {
+    pos_ = endOfEntry(pos_);
+    n++;
+  }
+  pos_ = save;
+  return n;
+}
+
+int MeshFileBuffer::readInt()
+{
+  if (atEndOfLine()) parseError("expected an integer entry");
+
+  const char* p = pos_;
+  bool neg = false;
+  if (*p=='-' || *p=='+') 
+  {
+    neg = (*p=='-');
+    p++;
+  }
+  const char* digits = p;
+  long val = 0;
+  while (p < end_ && *p >= '0' && *p <= '9')
+  {
+    val = 10*val + (*p - '0');
+    p++;
+  }
+  if (p==digits || p != endOfEntry(pos_))
+  {
+    parseError("malformed integer entry [" 
+      + std::string(pos_, endOfEntry(pos_)) + "]");
+  }
+  pos_ = p;
+  return neg ? -((int) val) : (int) val;
+}
+
+double MeshFileBuffer::readDouble()
+{
+  if (atEndOfLine()) parseError("expected a floating-point entry");
+
+  const char* e = endOfEntry(pos_);
+  size_t len = e - pos_;
+
+  /* The mapped buffer isn't null terminated, so copy the entry 
+   * to a small local buffer before handing it to strtod */
+  char tmp[64];
+  if (len >= sizeof(tmp)) 
+  {
+    parseError("floating-point entry too long [" 
+      + std::string(pos_, e) + "]");
+  }
+  std::memcpy(tmp, pos_, len);
+  tmp[len] = '\0';
+
+  char* stop = 0;
+  double val = std::strtod(tmp, &stop);
+  if (stop != tmp + len) 
+  {
+    parseError("malformed floating-point entry [" + std::string(tmp) + "]");
+  }
+  pos_ = e;
+  return val;
+}
+
+std::string MeshFileBuffer::readWord()
+{
+  if (atEndOfLine()) parseError("expected an entry");
+  const char* e = endOfEntry(pos_);
+  std::string rtn(pos_, e);
+  pos_ = e;
+  return rtn;
+}
+
+void MeshFileBuffer::skipEntry()
+{
+  if (atEndOfLine()) parseError("expected an entry");
+  pos_ = endOfEntry(pos_);
+}
+
+std::string MeshFileBuffer::currentLine() const
+{
+  const char* e = lineStart_;
+  while (e < end_ && *e != '\n' && *e != '\r') e++;
+  return std::string(lineStart_, e);
+}
+
+void MeshFileBuffer::parseError(const std::string& msg) const
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error,
+    "MeshFileBuffer: " << msg << " in line \n[" << currentLine() 
+    << "]\n of file " << filename_);
+}
@@ -0,0 +1,156 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_MESHFILEBUFFER_H
+#define SUNDANCE_MESHFILEBUFFER_H
+
+
+#include "SundanceDefs.hpp"
+#include <string>
+
+namespace Sundance
+{
+
+/**
+ * MeshFileBuffer gives the mesh readers random access to the contents
+ * of a text mesh file without going through a stream. The file is mapped
+ * into memory (or, where mapping is unavailable, read in a single block)
+ * and numbers are parsed directly from the buffer, so that no per-line
+ * strings or token arrays are ever created. 
+ *
+ * The buffer is consumed one line at a time: nextLine() positions
+ * the cursor at the start of the next line that is neither empty nor
+ * a comment, after which the entries of that line are read in order 
+ * with readInt() and readDouble(). Asking for an entry past the end
+ * of the line, or finding a malformed number, raises an exception.
+ */
+class MeshFileBuffer
+{
+public:
+  /** Map the file with the given name. Throws if the file cannot be
+   * opened. */
+  MeshFileBuffer(const std::string& filename, char comment='#');
+
+  /** Release the mapping */
+  ~MeshFileBuffer();
+
+  /** Name of the file being read */
+  const std::string& filename() const {return filename_;}
+
+  /** Size of the file in bytes */
+  size_t size() const {return size_;}
+
+  /** Raw view of the file contents, for binary formats */
+  const char* data() const {return begin_;}
+
+  /** 
+   * Advance to the start of the next non-empty, non-comment line.
+   * Any unread entries on the current line are skipped.
+   * @return false if the end of the file was reached
+   */
+  bool nextLine() ;
+
+  /** Read the next integer entry on the current line */
+  int readInt() ;
+
+  /** Read the next floating-point entry on the current line */
+  double readDouble() ;
+
+  /** Read the next whitespace-delimited word on the current line */
+  std::string readWord() ;
+
+  /** Skip the next entry on the current line */
+  void skipEntry() ;
+
+  /** Return the number of entries remaining on the current line */
+  int countEntries() const ;
+
+  /** Indicate whether all entries of the current line have been read */
+  bool atEndOfLine() const ;
+
+  /** Return a copy of the current line, for use in error messages */
+  std::string currentLine() const ;
+
+private:
+  /** Not copyable */
+  MeshFileBuffer(const MeshFileBuffer&);
+  /** Not assignable */
+  MeshFileBuffer& operator=(const MeshFileBuffer&);
+
+  /** Advance past blanks within the current line */
+  void skipBlanks() const ;
+
+  /** Find the end of the entry starting at p */
+  const char* endOfEntry(const char* p) const ;
+
+  /** Throw a parse error that quotes the current line */
+  void parseError(const std::string& msg) const ;
+
+  /** Is c a line terminator or the comment character? */
+  bool isEndOfLine(char c) const 
+    {return c=='\n' || c=='\r' || c==comment_;}
+
+  std::string filename_;
+
+  char comment_;
+
+  const char* begin_;
+
+  const char* end_;
+
+  mutable const char* pos_;
+
+  const char* lineStart_;
+
+  size_t size_;
+
+  bool isMapped_;
+
+  bool started_;
+
+  char* heapData_;
+};
+
+}
+
+
+
+#endif
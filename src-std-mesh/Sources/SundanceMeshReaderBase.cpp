@@ -121,3 +121,29 @@ RCP<std::ifstream> MeshReaderBase::openFile(const std::string& fname,
 
   return rtn;
 }
+
+RCP<MeshFileBuffer> MeshReaderBase::openBuffer(const std::string& fname,
+  const std::string& description) const
+{
+  std::string f = searchForFile(fname);
+
+  SUNDANCE_OUT(this->verb() > 2,
+               "trying to map " << description << " file " << f);
+
+  RCP<MeshFileBuffer> rtn;
+  try
+  {
+    rtn = rcp(new MeshFileBuffer(f, '#'));
+  }
+  catch(std::exception& e)
+  {
+    TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error,
+      "MeshReaderBase::openBuffer() unable to open "
+      << description << " file " << f);
+  }
+
+  SUNDANCE_OUT(this->verb() > 0,
+               "reading " << description << " from " << fname);
+
+  return rtn;
+}
@@ -45,6 +45,7 @@
 
 #include "SundanceDefs.hpp"
 #include "SundanceMeshSourceBase.hpp"
+#include "SundanceMeshFileBuffer.hpp"
 #include "Teuchos_StrUtils.hpp"
 
 namespace Sundance
@@ -72,6 +73,13 @@ public:
   /** */
   virtual ~MeshReaderBase(){;}
 
+  /** 
+   * Whether readers should parse text mesh files in place from a
+   * MeshFileBuffer rather than tokenizing line by line. The 
+   * line-by-line readers are kept as the reference implementation.
+   */
+  static bool& useFastParser() {static bool rtn = true; return rtn;}
+
 protected:
   /** access to the filename */
   const std::string& filename() const {return filename_;}
@@ -93,6 +101,14 @@ protected:
   RCP<std::ifstream> openFile(const std::string& fname, 
     const std::string& description) const ;
 
+  /** Map a file "fname" for in-place parsing, checking for success.
+   * @param fname name of the file to be opened
+   * @param description a description of the file, to be included
+   * in any error messages generated.
+   **/
+  RCP<MeshFileBuffer> openBuffer(const std::string& fname, 
+    const std::string& description) const ;
+
   /** 
    * Read the next non-empty, non-comment line from a stream
    * @param is the stream from which to get the line
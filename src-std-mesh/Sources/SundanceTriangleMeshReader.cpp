@@ -44,6 +44,8 @@
 #include "SundanceOut.hpp"
 #include "SundanceGeomUtils.hpp"
 #include "PlayaExceptions.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 
 using namespace Sundance;
 using namespace Sundance;
@@ -51,6 +53,12 @@ using namespace Sundance;
 using namespace Teuchos;
 using namespace Sundance;
 
+static Time& triangleFillTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("triangle reader fillMesh"); 
+  return *rtn;
+}
 
 TriangleMeshReader::TriangleMeshReader(const std::string& fname,
 				       const MeshType& meshType,
@@ -128,6 +136,7 @@ TriangleMeshReader::TriangleMeshReader(const ParameterList& params)
 
 Mesh TriangleMeshReader::fillMesh() const 
 {
+  TimeMonitor timer(triangleFillTimer());
   Mesh mesh;
 
   Array<int> ptGID;
@@ -137,13 +146,20 @@ Mesh TriangleMeshReader::fillMesh() const
 
   readParallelInfo(ptGID, ptOwner, cellGID, cellOwner);
 
-  mesh = readNodes(ptGID, ptOwner);
-
-  readElems(mesh, ptGID, cellGID, cellOwner);
-
-  mesh.freezeTopology();
-
-  readSides(mesh);
+  if (useFastParser())
+    {
+      mesh = readNodesFast(ptGID, ptOwner);
+      readElemsFast(mesh, ptGID, cellGID, cellOwner);
+      mesh.freezeTopology();
+      readSidesFast(mesh);
+    }
+  else
+    {
+      mesh = readNodes(ptGID, ptOwner);
+      readElems(mesh, ptGID, cellGID, cellOwner);
+      mesh.freezeTopology();
+      readSides(mesh);
+    }
 
   readEdges(mesh);
 
@@ -632,3 +648,289 @@ void TriangleMeshReader::readEdges(Mesh& mesh) const
       SUNDANCE_TRACE(ex);
     }
 }
+
+
+
+Mesh TriangleMeshReader::readNodesFast(Array<int>& ptGID,
+                                       Array<int>& ptOwner) const 
+{
+  Mesh mesh;
+  int nPoints = -1;
+
+  RCP<MeshFileBuffer> buf = openBuffer(nodeFilename_, "node info");
+	
+  /* read the header line */
+  buf->nextLine();
+  TEUCHOS_TEST_FOR_EXCEPTION(buf->countEntries() != 4, std::runtime_error,
+			     "TriangleMeshReader::getMesh() requires 4 "
+			     "entries on the header line in "
+			     "the .node file. Found line \n[" << buf->currentLine()
+			     << "]\n in file " << nodeFilename_);
+  SUNDANCE_OUT(this->verb() > 2,
+               "read point header " << buf->currentLine());
+
+  int nPointsInFile = buf->readInt();
+  int dimension = buf->readInt();
+  int nAttributes = buf->readInt();
+  int nBdryMarkers = buf->readInt();
+  
+  if (nProc()==1)
+    {
+      nPoints = nPointsInFile;
+      ptGID.resize(nPoints);
+      ptOwner.resize(nPoints);
+      for (int i=0; i<nPoints; i++)
+        {
+          ptGID[i] = i;
+          ptOwner[i] = 0;
+        }
+    }
+  else
+    {
+      nPoints = ptGID.length();
+      TEUCHOS_TEST_FOR_EXCEPTION(nPointsInFile != nPoints, std::runtime_error,
+				 "TriangleMeshReader::getMesh() found inconsistent "
+				 "numbers of points in .node file and par file. Node "
+				 "file " << nodeFilename_ << " had nPoints=" 
+				 << nPointsInFile << " but .par file " 
+				 << parFilename_ << " had nPoints=" << nPoints);
+    }
+
+  SUNDANCE_OUT(this->verb() > 3,
+               "expecting to read " << nPoints << " points");
+
+  mesh = createMesh(dimension);
+  mesh.estimateNumVertices(nPoints);
+
+  nodeAttributes()->resize(nAttributes);
+  for (int i=0; i<nAttributes; i++)
+    {
+      (*nodeAttributes())[i].resize(nPoints);
+    }
+  offset_=-1;
+
+  for (int count=0; count<nPoints; count++)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine(), std::runtime_error,
+				 "TriangleMeshReader::getMesh() found only " << count
+				 << " of " << nPoints << " nodes in file " 
+				 << nodeFilename_);
+
+      int label = buf->readInt();
+      /* Triangle files can use either 0-offset or 1-offset numbering. We'll
+       * inspect the first node line to decide which numbering to use. */
+      if (count==0)
+        {
+          offset_ = label;
+          TEUCHOS_TEST_FOR_EXCEPTION(offset_ < 0 || offset_ > 1, std::runtime_error,
+				     "TriangleMeshReader::getMesh() expected "
+				     "either 0-offset or 1-offset numbering. Found an "
+				     "initial offset of " << offset_ << " in line \n["
+				     << buf->currentLine() << "]\n of file " 
+				     << nodeFilename_);
+        }
+
+      double x = buf->readDouble();
+      double y = buf->readDouble();
+      Point pt;
+      if (dimension==3)
+	{
+	  double z = buf->readDouble();
+          pt = Point(x,y,z);
+	}
+      else 
+	{
+          pt = Point(x,y);
+	}
+
+      for (int i=0; i<nAttributes; i++)
+	{
+	  (*nodeAttributes())[i][count] = buf->readDouble();
+	}
+      for (int i=0; i<nBdryMarkers; i++) buf->skipEntry();
+
+      TEUCHOS_TEST_FOR_EXCEPTION(!buf->atEndOfLine(),
+				 std::runtime_error,
+				 "TriangleMeshReader::getMesh() found bad node input "
+				 "line. Expected " 
+				 << (1 + dimension + nAttributes + nBdryMarkers)
+				 << " entries but found line \n[" << 
+				 buf->currentLine() << "]\n in file " << nodeFilename_);
+
+      int ptLabel = 0;
+      mesh.addVertex(ptGID[count], pt, ptOwner[count], ptLabel);
+    }
+  return mesh;
+}
+
+void TriangleMeshReader::readElemsFast(Mesh& mesh,
+                                       const Array<int>& ptGID,
+                                       Array<int>& elemGID,
+                                       Array<int>& elemOwner) const 
+{
+  try
+    {
+      RCP<MeshFileBuffer> buf = openBuffer(elemFilename_, "element info");
+
+      buf->nextLine();
+      TEUCHOS_TEST_FOR_EXCEPTION(buf->countEntries() != 3, std::runtime_error,
+				 "TriangleMeshReader::getMesh() requires 3 "
+				 "entries on the header line in "
+				 "the .ele file. Found line \n[" << buf->currentLine()
+				 << "]\n in file " << elemFilename_);
+
+      int nElemsInFile = buf->readInt();
+      int ptsPerElem = buf->readInt();
+      int nAttributes = buf->readInt();
+      int nElems = -1;
+
+      if (nProc()==1)
+        {
+          nElems = nElemsInFile;
+          elemGID.resize(nElems);
+          elemOwner.resize(nElems);
+          for (int i=0; i<nElems; i++)
+            {
+              elemGID[i] = i;
+              elemOwner[i] = 0;
+            }
+        }
+      else
+        {
+          nElems = elemGID.length();
+          TEUCHOS_TEST_FOR_EXCEPTION(nElemsInFile != nElems, std::runtime_error,
+				     "TriangleMeshReader::readElems() found inconsistent "
+				     "numbers of elements in .ele file and par file. Elem "
+				     "file " << elemFilename_ << " had nElems=" 
+				     << nElemsInFile << " but .par file " 
+				     << parFilename_ << " had nElems=" << nElems);
+        }
+
+      TEUCHOS_TEST_FOR_EXCEPTION(ptsPerElem != mesh.spatialDim()+1, std::runtime_error,
+				 "TriangleMeshReader::readElems() found inconsistency "
+				 "between number of points per element=" << ptsPerElem 
+				 << " and dimension=" << mesh.spatialDim() << ". Number of pts "
+				 "per element should be dimension + 1");
+
+      elemAttributes()->resize(nElems);
+      mesh.estimateNumElements(nElems);
+
+      int dim = mesh.spatialDim();
+      int nPts = ptGID.length();
+      Array<int> nodes(dim+1);
+
+      for (int count=0; count<nElems; count++)
+        {
+          TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine(), std::runtime_error,
+				     "TriangleMeshReader::readElems() found only " 
+				     << count << " of " << nElems 
+				     << " elements in file " << elemFilename_);
+
+          buf->skipEntry();
+          for (int d=0; d<=dim; d++)
+            {
+              int v = buf->readInt() - offset_;
+              TEUCHOS_TEST_FOR_EXCEPTION(v < 0 || v >= nPts, std::runtime_error,
+					 "TriangleMeshReader::readElems() found "
+					 "out-of-range vertex index in line \n[" 
+					 << buf->currentLine() << "]\n in file " 
+					 << elemFilename_);
+              nodes[d] = ptGID[v];
+            }
+
+          Array<double>& attr = (*elemAttributes())[count];
+          attr.resize(nAttributes);
+          for (int i=0; i<nAttributes; i++)
+            {
+              attr[i] = buf->readDouble();
+            }
+
+          TEUCHOS_TEST_FOR_EXCEPTION(!buf->atEndOfLine(),
+				     std::runtime_error,
+				     "TriangleMeshReader::readElems() found bad elem "
+				     "input line. Expected " 
+				     << (1 + ptsPerElem + nAttributes)
+				     << " entries but found line \n[" << 
+				     buf->currentLine() << "]\n in file " << elemFilename_);
+
+          int elemLabel = 0;
+          try
+            {
+              mesh.addElement(elemGID[count], nodes, elemOwner[count], elemLabel);
+            }
+          catch(std::exception& ex1)
+            {
+              SUNDANCE_TRACE(ex1);
+            }
+        }
+    }
+  catch(std::exception& ex)
+    {
+      SUNDANCE_TRACE(ex);
+    }
+}
+
+
+void TriangleMeshReader::readSidesFast(Mesh& mesh) const 
+{
+  try
+    {
+      RCP<MeshFileBuffer> buf;
+      bool fileOK = false;
+
+      try
+        {
+          buf = openBuffer(sideFilename_, "side info");
+          fileOK = true;
+        }
+      catch(std::exception& e) {;}
+
+      /* Not all meshes will have sides files.
+       * If the sides file doesn't exist, return. */
+      if (!fileOK)
+        {
+          SUNDANCE_VERB_LOW("side file [" << sideFilename_ << "] not found");
+          return;
+        }
+
+      buf->nextLine();
+      TEUCHOS_TEST_FOR_EXCEPTION(buf->countEntries() != 1, std::runtime_error,
+				 "TriangleMeshReader::readSides() requires 1 "
+				 "entry on the header line in "
+				 "the .side file. Found line \n[" << buf->currentLine()
+				 << "]\n in file " << sideFilename_);
+
+      int nSides = buf->readInt();
+
+      int elemDim = mesh.spatialDim();
+      int sideDim = elemDim - 1;
+
+      for (int i=0; i<nSides; i++)
+        {
+          TEUCHOS_TEST_FOR_EXCEPTION(!buf->nextLine() || buf->countEntries() != 4,
+				     std::runtime_error,
+				     "TriangleMeshReader::readSides() found bad side "
+				     "input line. Expected 4 entries but found line \n[" 
+				     << buf->currentLine() << "]\n in file " 
+				     << sideFilename_);
+
+          buf->skipEntry();
+          int elemGID = buf->readInt();
+          int elemFacet = buf->readInt();
+          int sideLabel = buf->readInt();
+
+          TEUCHOS_TEST_FOR_EXCEPTION(!mesh.hasGID(elemDim, elemGID), std::runtime_error,
+				     "element GID " << elemGID << " not found");
+          int elemLID = mesh.mapGIDToLID(elemDim, elemGID);
+          int o=0; // dummy orientation variable; not needed here
+          int sideLID = mesh.facetLID(elemDim, elemLID, sideDim, 
+				      elemFacet, o);
+
+          mesh.setLabel(sideDim, sideLID, sideLabel);
+        }
+    }
+  catch(std::exception& ex)
+    {
+      SUNDANCE_TRACE(ex);
+    }
+}
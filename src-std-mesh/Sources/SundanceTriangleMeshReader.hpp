@@ -144,6 +144,19 @@ namespace Sundance
                    const Array<int>& nodeGID,
                    Array<int>& elemGID,
                    Array<int>& elemOwner) const ;
+
+    /** Read the .node file by parsing in place from a mapped buffer */
+    Mesh readNodesFast(Array<int>& ptGID,
+                       Array<int>& ptOwner) const ;
+
+    /** Read the .ele file by parsing in place from a mapped buffer */
+    void readElemsFast(Mesh& mesh,
+                       const Array<int>& nodeGID,
+                       Array<int>& elemGID,
+                       Array<int>& elemOwner) const ;
+
+    /** Read the .side file by parsing in place from a mapped buffer */
+    void readSidesFast(Mesh& mesh) const ;
     
 
     /** */
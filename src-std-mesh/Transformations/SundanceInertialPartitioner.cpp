@@ -0,0 +1,296 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceInertialPartitioner.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+using std::endl;
+
+static Time& inertialPartitionTimer() 
+{
+  static RCP<Time> rtn 
+    = TimeMonitor::getNewTimer("inertial partitioning"); 
+  return *rtn;
+}
+
+namespace 
+{
+/* Orders elements by their projection onto the bisection axis, 
+ * with ties broken by element index so results are reproducible */
+class ProjectionLess
+{
+public:
+  ProjectionLess(const Array<double>& key) : key_(key) {}
+  bool operator()(int a, int b) const 
+    {
+      if (key_[a] < key_[b]) return true;
+      if (key_[b] < key_[a]) return false;
+      return a < b;
+    }
+private:
+  const Array<double>& key_;
+};
+}
+
+
+InertialPartitioner::InertialPartitioner(bool refine, double imbalanceTol,
+  bool ignoreGhosts)
+  : SerialPartitionerBase(ignoreGhosts), 
+    refine_(refine), 
+    imbalanceTol_(imbalanceTol)
+{}
+
+
+void InertialPartitioner::getAssignments(const Mesh& mesh, int np,
+  Array<int>& assignments) const 
+{
+  TimeMonitor timer(inertialPartitionTimer());
+
+  TEUCHOS_TEST_FOR_EXCEPTION(np < 1, std::runtime_error,
+    "invalid number of partitions np=" << np);
+
+  int dim = mesh.spatialDim();
+  int nElems = mesh.numCells(dim);
+  assignments.resize(nElems);
+  if (nElems == 0) return;
+
+  /* Compute element centroids as vertex averages */
+  Array<int> elemLID(nElems);
+  for (int c=0; c<nElems; c++) elemLID[c] = c;
+  Array<int> elemVerts;
+  Array<int> orient;
+  mesh.getFacetLIDs(dim, elemLID, 0, elemVerts, orient);
+  int nv = elemVerts.size() / nElems;
+
+  Array<double> x(nElems*dim, 0.0);
+  for (int c=0; c<nElems; c++)
+  {
+    for (int j=0; j<nv; j++)
+    {
+      const double* xv = mesh.nodePositionView(elemVerts[c*nv+j]);
+      for (int d=0; d<dim; d++) x[c*dim+d] += xv[d];
+    }
+    for (int d=0; d<dim; d++) x[c*dim+d] /= nv;
+  }
+
+  Array<int> perm(elemLID);
+  Array<double> key(nElems);
+  bisect(dim, x, perm, key, 0, nElems, 0, np, assignments);
+
+  if (refine_ && np > 1)
+  {
+    Array<int> ptr;
+    Array<int> adj;
+    getDualGraph(mesh, ptr, adj);
+    refine(np, ptr, adj, assignments);
+  }
+}
+
+
+void InertialPartitioner::bisect(int dim, const Array<double>& x, 
+  Array<int>& perm, Array<double>& key,
+  int begin, int end, int firstPart, int np,
+  Array<int>& assignments) const
+{
+  if (np == 1)
+  {
+    for (int i=begin; i<end; i++) assignments[perm[i]] = firstPart;
+    return;
+  }
+
+  int npLeft = np/2;
+  int n = end - begin;
+  int nLeft = (int) ((((long long) n) * npLeft) / np);
+
+  double axis[3];
+  principalAxis(dim, x, perm, begin, end, axis);
+
+  for (int i=begin; i<end; i++)
+  {
+    int c = perm[i];
+    double s = 0.0;
+    for (int d=0; d<dim; d++) s += axis[d]*x[c*dim+d];
+    key[c] = s;
+  }
+
+  std::nth_element(perm.begin()+begin, perm.begin()+begin+nLeft, 
+    perm.begin()+end, ProjectionLess(key));
+
+  bisect(dim, x, perm, key, begin, begin+nLeft, firstPart, npLeft, 
+    assignments);
+  bisect(dim, x, perm, key, begin+nLeft, end, firstPart+npLeft, np-npLeft, 
+    assignments);
+}
+
+
+void InertialPartitioner::principalAxis(int dim, const Array<double>& x, 
+  const Array<int>& perm, int begin, int end, 
+  double* axis) const 
+{
+  double mean[3] = {0.0, 0.0, 0.0};
+  double C[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  int n = end - begin;
+
+  for (int i=begin; i<end; i++)
+  {
+    int c = perm[i];
+    for (int d=0; d<dim; d++) mean[d] += x[c*dim+d];
+  }
+  for (int d=0; d<dim; d++) mean[d] /= std::max(n, 1);
+
+  for (int i=begin; i<end; i++)
+  {
+    int c = perm[i];
+    for (int d=0; d<dim; d++)
+    {
+      double xd = x[c*dim+d] - mean[d];
+      for (int e=0; e<=d; e++) C[d][e] += xd*(x[c*dim+e] - mean[e]);
+    }
+  }
+  for (int d=0; d<dim; d++)
+  {
+    for (int e=d+1; e<dim; e++) C[d][e] = C[e][d];
+  }
+
+  /* Start from the coordinate direction of largest spread. This is 
+   * also the fallback if the power iteration degenerates. */
+  int best = 0;
+  for (int d=1; d<dim; d++) if (C[d][d] > C[best][best]) best = d;
+  for (int d=0; d<3; d++) axis[d] = 0.0;
+  axis[best] = 1.0;
+
+  /* The covariance matrix is symmetric positive semidefinite, so power
+   * iteration converges to the axis of largest inertia */
+  for (int iter=0; iter<32; iter++)
+  {
+    double y[3] = {0.0, 0.0, 0.0};
+    for (int d=0; d<dim; d++)
+    {
+      for (int e=0; e<dim; e++) y[d] += C[d][e]*axis[e];
+    }
+    double norm = 0.0;
+    for (int d=0; d<dim; d++) norm += y[d]*y[d];
+    norm = ::sqrt(norm);
+    if (norm <= 1.0e-300) break;
+    double change = 0.0;
+    for (int d=0; d<dim; d++) 
+    {
+      y[d] /= norm;
+      change += ::fabs(y[d] - axis[d]);
+      axis[d] = y[d];
+    }
+    if (change < 1.0e-10) break;
+  }
+}
+
+
+void InertialPartitioner::refine(int np, 
+  const Array<int>& ptr, const Array<int>& adj,
+  Array<int>& assignments) const 
+{
+  int nElems = ptr.size()-1;
+
+  Array<int> partSize(np, 0);
+  for (int c=0; c<nElems; c++) partSize[assignments[c]]++;
+
+  int maxSize = (int) ::ceil((1.0 + imbalanceTol_) * nElems / np);
+  for (int p=0; p<np; p++) maxSize = std::max(maxSize, partSize[p]);
+
+  Array<int> nbrPart;
+  Array<int> nbrCount;
+
+  for (int sweep=0; sweep<maxRefinementSweeps(); sweep++)
+  {
+    int numMoved = 0;
+    for (int c=0; c<nElems; c++)
+    {
+      int p = assignments[c];
+      if (partSize[p] <= 1) continue;
+
+      /* Tally the connections from c to each part */
+      int internal = 0;
+      nbrPart.resize(0);
+      nbrCount.resize(0);
+      for (int k=ptr[c]; k<ptr[c+1]; k++)
+      {
+        int q = assignments[adj[k]];
+        if (q == p) {internal++; continue;}
+        int j = 0;
+        for (; j<nbrPart.size(); j++) if (nbrPart[j]==q) break;
+        if (j == nbrPart.size()) 
+        {
+          nbrPart.append(q);
+          nbrCount.append(0);
+        }
+        nbrCount[j]++;
+      }
+      if (nbrPart.size()==0) continue;
+
+      /* Find the move with the largest reduction in edge cut that 
+       * keeps the target part within the balance tolerance */
+      int bestPart = -1;
+      int bestGain = 0;
+      for (int j=0; j<nbrPart.size(); j++)
+      {
+        int gain = nbrCount[j] - internal;
+        if (gain > bestGain && partSize[nbrPart[j]] < maxSize)
+        {
+          bestGain = gain;
+          bestPart = nbrPart[j];
+        }
+      }
+      if (bestPart >= 0)
+      {
+        partSize[p]--;
+        partSize[bestPart]++;
+        assignments[c] = bestPart;
+        numMoved++;
+      }
+    }
+    if (numMoved==0) break;
+  }
+}
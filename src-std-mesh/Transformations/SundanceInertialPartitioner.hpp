@@ -0,0 +1,109 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#ifndef SUNDANCE_INERTIALPARTITIONER_H
+#define SUNDANCE_INERTIALPARTITIONER_H
+
+#include "SundanceDefs.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceSerialPartitionerBase.hpp"
+
+namespace Sundance
+{
+/**
+ * InertialPartitioner divides a mesh by recursive inertial bisection
+ * of the element centroids, followed by an optional greedy boundary
+ * refinement on the element dual graph to reduce the edge cut. Unlike
+ * FileIOChacoPartitioner, it runs entirely in memory and needs no
+ * external executable.
+ *
+ * At each level the elements are split across the plane normal to their
+ * principal axis of inertia, with the split point chosen so that the 
+ * two halves receive element counts proportional to the number of 
+ * processors assigned to each. Any processor count is allowed. 
+ */
+class InertialPartitioner : public SerialPartitionerBase
+{
+public:
+  /** 
+   * @param refine whether to do boundary refinement after bisection
+   * @param imbalanceTol the allowed relative excess of a part's size over
+   * the average part size during refinement
+   */
+  InertialPartitioner(bool refine=true, double imbalanceTol=0.03,
+    bool ignoreGhosts=false);
+
+  /** */
+  virtual ~InertialPartitioner(){;}
+
+  /** */
+  virtual void getAssignments(const Mesh& mesh, int np, 
+    Array<int>& assignments) const ;
+
+  /** Maximum number of boundary refinement sweeps */
+  static int& maxRefinementSweeps() {static int rtn=8; return rtn;}
+
+private:
+
+  /** Bisect the elements perm[begin] ... perm[end-1] recursively
+   * into np parts numbered from firstPart */
+  void bisect(int dim, const Array<double>& x, 
+    Array<int>& perm, Array<double>& key,
+    int begin, int end, int firstPart, int np,
+    Array<int>& assignments) const ;
+
+  /** Compute the principal axis of inertia of a set of points */
+  void principalAxis(int dim, const Array<double>& x, 
+    const Array<int>& perm, int begin, int end, 
+    double* axis) const ;
+
+  /** Greedily move boundary elements to reduce the edge cut */
+  void refine(int np, const Array<int>& ptr, const Array<int>& adj,
+    Array<int>& assignments) const ;
+
+  bool refine_;
+
+  double imbalanceTol_;
+};
+}
+
+#endif
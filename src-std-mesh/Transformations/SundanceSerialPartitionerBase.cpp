@@ -43,6 +43,8 @@
 #include "SundanceSerialPartitionerBase.hpp"
 #include "SundanceMap.hpp"
 #include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceCellType.hpp"
+#include <algorithm>
 
 using namespace Sundance;
 using namespace Sundance;
@@ -73,6 +75,117 @@ int SerialPartitionerBase::max(const Set<int>& s) const
   return *(s.rbegin());
 }
 
+void SerialPartitionerBase::getDualGraph(const Mesh& mesh, 
+  Array<int>& ptr, Array<int>& adj) const
+{
+  int dim = mesh.spatialDim();
+  int nElems = mesh.numCells(dim);
+  int nVerts = mesh.numCells(0);
+
+  ptr.resize(nElems+1);
+  ptr[0] = 0;
+  adj.resize(0);
+  if (nElems == 0) return;
+
+  /* Get the vertices of all elements in one batch */
+  Array<int> elemLID(nElems);
+  for (int c=0; c<nElems; c++) elemLID[c] = c;
+  Array<int> elemVerts;
+  Array<int> orient;
+  mesh.getFacetLIDs(dim, elemLID, 0, elemVerts, orient);
+  int nv = elemVerts.size() / nElems;
+
+  /* Number of vertices on a facet of the maximal cell type. All facets
+   * must agree, which rules out prisms. */
+  CellType elemType = mesh.cellType(dim);
+  int facetVerts = 1;
+  if (dim > 1)
+  {
+    facetVerts = numFacets(facetType(elemType, dim-1, 0), 0);
+    for (int f=1; f<numFacets(elemType, dim-1); f++)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(
+        numFacets(facetType(elemType, dim-1, f), 0) != facetVerts,
+        std::runtime_error, "SerialPartitionerBase::getDualGraph() "
+        "requires all facets of a " << elemType << " to have the same "
+        "number of vertices");
+    }
+  }
+
+  /* Invert to a vertex-to-element table in CSR form */
+  Array<int> vertPtr(nVerts+1, 0);
+  for (int i=0; i<elemVerts.size(); i++) vertPtr[elemVerts[i]+1]++;
+  for (int v=0; v<nVerts; v++) vertPtr[v+1] += vertPtr[v];
+  Array<int> vertElems(vertPtr[nVerts]);
+  Array<int> pos(vertPtr.begin(), vertPtr.end()-1);
+  for (int c=0; c<nElems; c++)
+  {
+    for (int j=0; j<nv; j++) vertElems[pos[elemVerts[c*nv+j]]++] = c;
+  }
+
+  /* Two elements of a conforming mesh share a facet if they have 
+   * facetVerts vertices in common. Count the shared vertices with a scratch array that is reset
+   * after each element. */
+  Array<int> shared(nElems, 0);
+  Array<int> touched;
+  Array<int> nbors;
+  adj.reserve(nElems*numFacets(elemType, dim-1));
+  for (int c=0; c<nElems; c++)
+  {
+    touched.resize(0);
+    for (int j=0; j<nv; j++)
+    {
+      int v = elemVerts[c*nv+j];
+      for (int k=vertPtr[v]; k<vertPtr[v+1]; k++)
+      {
+        int e = vertElems[k];
+        if (e == c) continue;
+        if (shared[e]==0) touched.append(e);
+        shared[e]++;
+      }
+    }
+    nbors.resize(0);
+    for (int i=0; i<touched.size(); i++)
+    {
+      if (shared[touched[i]]==facetVerts) nbors.append(touched[i]);
+      shared[touched[i]] = 0;
+    }
+    std::sort(nbors.begin(), nbors.end());
+    for (int i=0; i<nbors.size(); i++) adj.append(nbors[i]);
+    ptr[c+1] = adj.size();
+  }
+}
+
+
+void SerialPartitionerBase::getPartitionStatistics(int np,
+  const Array<int>& ptr, const Array<int>& adj,
+  const Array<int>& assignments,
+  int& edgeCut, double& imbalance) 
+{
+  int nElems = ptr.size()-1;
+  TEUCHOS_TEST_FOR_EXCEPTION(assignments.size() != nElems, std::runtime_error,
+    "number of assignments " << assignments.size() 
+    << " does not match number of graph vertices " << nElems);
+
+  Array<int> partSize(np, 0);
+  edgeCut = 0;
+  for (int c=0; c<nElems; c++)
+  {
+    partSize[assignments[c]]++;
+    for (int k=ptr[c]; k<ptr[c+1]; k++)
+    {
+      /* count each edge once */
+      if (adj[k] > c && assignments[adj[k]] != assignments[c]) edgeCut++;
+    }
+  }
+
+  int maxSize = 0;
+  for (int p=0; p<np; p++) maxSize = std::max(maxSize, partSize[p]);
+  imbalance = 1.0;
+  if (nElems > 0) imbalance = ((double) maxSize * np) / ((double) nElems);
+}
+
+
 void SerialPartitionerBase::getNeighbors(const Mesh& mesh, 
   Array<Array<int> >& neighbors, int& nEdges) const
 {
@@ -69,6 +69,30 @@ public:
   void getNeighbors(const Mesh& mesh, 
     Array<Array<int> >& neighbors, int& nEdges) const ;
 
+  /** 
+   * Build the element dual graph in compressed-row form: the neighbors
+   * of element c are adj[ptr[c]] ... adj[ptr[c+1]-1], sorted. Two 
+   * elements are neighbors if they share a facet, detected as having
+   * all of a facet's vertices in common; this needs a conforming mesh
+   * whose facets all have the same number of vertices (any mesh of
+   * simplices, quads or bricks). Unlike getNeighbors(),
+   * this uses flat arrays only and is suitable for very large meshes.
+   */
+  void getDualGraph(const Mesh& mesh, 
+    Array<int>& ptr, Array<int>& adj) const ;
+
+  /** 
+   * Compute quality statistics for a partition of a dual graph.
+   * @param edgeCut upon return, the number of graph edges 
+   * whose endpoints are assigned to different processors
+   * @param imbalance upon return, the ratio of the largest part
+   * size to the average part size
+   */
+  static void getPartitionStatistics(int np,
+    const Array<int>& ptr, const Array<int>& adj,
+    const Array<int>& assignments,
+    int& edgeCut, double& imbalance) ;
+
   /** */
   Set<int> arrayToSet(const Array<int>& a) const ;
 
@@ -0,0 +1,95 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_BINARYMESHWRITER_H
+#define SUNDANCE_BINARYMESHWRITER_H
+
+
+#include "SundanceDefs.hpp"
+#include "SundanceFieldWriterBase.hpp"
+
+namespace Sundance
+{
+/**
+ * BinaryMeshWriter writes a checkpoint of a mesh in Sundance's native
+ * binary format, one file per processor, for fast reloading with 
+ * BinaryMeshReader. Fields are not written. The mesh must be a 
+ * BasicSimplicialMesh.
+ */
+class BinaryMeshWriter : public FieldWriterBase
+{
+public:
+  /** */
+  BinaryMeshWriter(const std::string& filename="") 
+    : FieldWriterBase(filename) {;}
+    
+  /** virtual dtor */
+  virtual ~BinaryMeshWriter(){;}
+
+  /** */
+  virtual void write() const ;
+
+  /** Return a ref count pointer to self */
+  virtual RCP<FieldWriterBase> getRcp() {return rcp(this);}
+};
+
+/** 
+ * BinaryMeshWriterFactory produces a binary mesh writer in contexts 
+ * where a user cannot do so directly.
+ */
+class BinaryMeshWriterFactory : public FieldWriterFactoryBase
+{
+public:
+  /** */
+  BinaryMeshWriterFactory() {}
+
+  /** Create a writer with the specified filename */
+  RCP<FieldWriterBase> createWriter(const string& name) const 
+    {return rcp(new BinaryMeshWriter(name));}
+
+  /** */
+  virtual RCP<FieldWriterFactoryBase> getRcp() {return rcp(this);}
+  
+};
+
+}
+
+#endif
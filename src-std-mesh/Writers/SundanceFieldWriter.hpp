@@ -60,6 +60,12 @@ namespace Sundance
    * vtkWriter.write();
    * \endcode
    *
+   * <h4> Example: </h4> Write the same fields as raw binary data, which is
+   * much faster and more compact than the default ASCII format
+   * \code
+   * FieldWriter vtkWriter = new VTKWriter("results", VTKAppended);
+   * \endcode
+   *
    * <h4> Example: </h4> Write verbose mesh information to cout
    * \code
    * FieldWriter writer = new VerboseFieldWriter();
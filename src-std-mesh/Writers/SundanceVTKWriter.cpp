@@ -44,6 +44,8 @@
 #include "SundanceOut.hpp"
 #include "PlayaTabs.hpp"
 #include "Teuchos_XMLObject.hpp"
+#include <fstream>
+#include <algorithm>
 
 
 
@@ -54,6 +56,58 @@ using namespace Teuchos;
 
 
 
+namespace
+{
+
+/* Base64 encoding of a block of bytes, as used for inline binary
+ * VTK data arrays */
+std::string base64Encode(const unsigned char* data, std::size_t n)
+{
+  static const char table[] = 
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string rtn;
+  rtn.reserve(4*((n+2)/3));
+
+  std::size_t i=0;
+  for (; i+2<n; i+=3)
+  {
+    unsigned int w = (data[i] << 16) | (data[i+1] << 8) | data[i+2];
+    rtn += table[(w >> 18) & 0x3f];
+    rtn += table[(w >> 12) & 0x3f];
+    rtn += table[(w >> 6) & 0x3f];
+    rtn += table[w & 0x3f];
+  }
+  if (i < n)
+  {
+    unsigned int w = data[i] << 16;
+    if (i+1 < n) w |= data[i+1] << 8;
+    rtn += table[(w >> 18) & 0x3f];
+    rtn += table[(w >> 12) & 0x3f];
+    rtn += (i+1 < n) ? table[(w >> 6) & 0x3f] : '=';
+    rtn += '=';
+  }
+  return rtn;
+}
+
+bool isLittleEndian()
+{
+  int one = 1;
+  return *(reinterpret_cast<char*>(&one)) == 1;
+}
+
+/* Type names used in the VTK XML format */
+std::string vtkTypeName(const float*) {return "Float32";}
+std::string vtkTypeName(const int*) {return "Int32";}
+std::string vtkTypeName(const unsigned char*) {return "UInt8";}
+
+/* Text output of a value. UInt8 values must be written as numbers, 
+ * not characters. */
+template <class T> inline T asciiValue(const T& x) {return x;}
+inline int asciiValue(const unsigned char& x) {return x;}
+
+}
+
 
 void VTKWriter::write() const 
 {
@@ -80,11 +134,17 @@ void VTKWriter::lowLevelWrite(const std::string& filename, bool isPHeader) const
   
   SUNDANCE_VERB_MEDIUM("writing VTK file " << f);
 
-  std::ofstream os(f.c_str());
+  std::ofstream os(f.c_str(), std::ios::out | std::ios::binary);
+  appendedData_.resize(0);
 
   XMLObject head("VTKFile");
   head.addAttribute("type", PHeader + "UnstructuredGrid");
   head.addAttribute("version", "0.1");
+  if (format_ != VTKAscii)
+    {
+      head.addAttribute("byte_order", 
+        isLittleEndian() ? "LittleEndian" : "BigEndian");
+    }
   
   os << head.header() << std::endl;
 
@@ -131,9 +191,66 @@ void VTKWriter::lowLevelWrite(const std::string& filename, bool isPHeader) const
     }
 
 	os << ug.footer() << std::endl;
+
+  if (format_ == VTKAppended && !isPHeader)
+    {
+      os << "<AppendedData encoding=\"raw\">" << std::endl << "_";
+      os.write(appendedData_.data(), appendedData_.size());
+      os << std::endl << "</AppendedData>" << std::endl;
+      appendedData_.resize(0);
+    }
+
 	os << head.footer() << std::endl;
 }
 
+
+template <class T>
+void VTKWriter::writeArrayValues(std::ostream& os, XMLObject& xml, 
+  const Array<T>& vals, int valsPerLine) const 
+{
+  /* VTK stores the size of each binary block in a 32-bit header */
+  unsigned int nBytes = vals.size() * sizeof(T);
+  const char* data = 0;
+  if (vals.size() > 0) data = reinterpret_cast<const char*>(&(vals[0]));
+
+  switch(format_)
+    {
+    case VTKAscii:
+      xml.addAttribute("format", "ascii");
+      os << xml.header() << std::endl;
+      for (int i=0; i<vals.size(); i++)
+        {
+          os << asciiValue(vals[i]);
+          if ((i+1) % valsPerLine == 0) os << std::endl;
+          else os << " ";
+        }
+      break;
+    case VTKBinary:
+      xml.addAttribute("format", "binary");
+      os << xml.header() << std::endl;
+      /* the size header and the data are encoded separately, as VTK 
+       * itself does */
+      os << base64Encode(reinterpret_cast<const unsigned char*>(&nBytes), 
+        sizeof(nBytes));
+      os << base64Encode(reinterpret_cast<const unsigned char*>(data), 
+        nBytes) << std::endl;
+      break;
+    case VTKAppended:
+      xml.addAttribute("format", "appended");
+      xml.addAttribute("offset", Teuchos::toString(appendedData_.size()));
+      os << xml.header() << std::endl;
+      appendedData_.append(reinterpret_cast<const char*>(&nBytes), 
+        sizeof(nBytes));
+      appendedData_.append(data, nBytes);
+      break;
+    default:
+      TEUCHOS_TEST_FOR_EXCEPT(true);
+    }
+
+  os << xml.footer() << std::endl;
+}
+
+
 void VTKWriter::writePoints(std::ostream& os, bool isPHeader) const 
 {
   std::string PHeader = "";
@@ -145,33 +262,28 @@ void VTKWriter::writePoints(std::ostream& os, bool isPHeader) const
   XMLObject xml(PHeader + "DataArray");
   xml.addAttribute("NumberOfComponents", "3");
   xml.addAttribute("type", "Float32");
-  xml.addAttribute("format", "ascii");
-
-  os << xml.header() << std::endl;
 
   /* write the points, unless this call is for the dummy header on the root proc */
   if (!isPHeader)
     {
       int np = mesh().numCells(0);
       int dim = mesh().spatialDim();
+      Array<float> x(3*np, 0.0);
       
       for (int i=0; i<np; i++)
         {
-          const Point& x = mesh().nodePosition(i);
-          
+          const Point& xi = mesh().nodePosition(i);
           for (int d=0; d<dim; d++)
             {
-              os << x[d] << " ";
-            }
-          for (int d=dim; d<3; d++)
-            {
-              os << "0.0 ";
+              x[3*i + d] = xi[d];
             }
-          os << std::endl;
         }
+      writeArrayValues(os, xml, x, 3);
+    }
+  else
+    {
+      os << xml << std::endl;
     }
-
-  os << xml.footer() << std::endl;
 
   os << pts.footer() << std::endl;
 }
@@ -182,108 +294,70 @@ void VTKWriter::writeCells(std::ostream& os) const
   XMLObject cells("Cells");
   os << cells.header() << std::endl;
 
-  XMLObject conn("DataArray");
-  conn.addAttribute("type", "Int32");
-  conn.addAttribute("Name", "connectivity");
-  conn.addAttribute("format", "ascii");
-
   int dim = mesh().spatialDim();
   int nc = mesh().numCells(dim);
   int dummySign;
-
-  os << conn.header() << std::endl;
   CellType cellType = mesh().cellType(dim);
-  
-  for (int c=0; c<nc; c++)
+
+  /* VTK's node ordering differs from ours for quads and bricks */
+  Array<int> nodeOrder;
+  int vtkCode = 0;
+  switch(cellType)
     {
-      int nNodes = mesh().numFacets( dim , c , 0 );
-
-		switch(cellType)
-			{
-			case TriangleCell: case LineCell: case TetCell:
-			      for (int i=0; i<nNodes; i++)
-			        {
-			          os << " " << mesh().facetLID(dim,c,0,i,dummySign);
-			        }
-			      os << std::endl;
-				break;
-			case QuadCell:  // for quads we have different order
-		          os << " " << mesh().facetLID(dim,c,0,0,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,1,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,3,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,2,dummySign);
-		          os << std::endl;
-				break;
-			case BrickCell:  // for quads we have different order
-		          os << " " << mesh().facetLID(dim,c,0,0,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,1,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,2,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,3,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,4,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,5,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,6,dummySign);
-		          os << " " << mesh().facetLID(dim,c,0,7,dummySign);
-		          os << std::endl;
-				break;
-            default:
-            	 TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error, "call type " << cellType <<
-            			 " not handled in VTKWriter::writeCells()");
-			}
+    case LineCell:
+      vtkCode = 3;
+      nodeOrder = tuple(0, 1);
+      break;
+    case TriangleCell:
+      vtkCode = 5;
+      nodeOrder = tuple(0, 1, 2);
+      break;
+    case QuadCell:
+      vtkCode = 9;
+      nodeOrder = tuple(0, 1, 3, 2);
+      break;
+    case TetCell:
+      vtkCode = 10;
+      nodeOrder = tuple(0, 1, 2, 3);
+      break;
+    case BrickCell:
+      vtkCode = 11;
+      nodeOrder = tuple(0, 1, 2, 3, 4, 5, 6, 7);
+      break;
+    default:
+      TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error, 
+        "call type " << cellType << " not handled in VTKWriter::writeCells()");
     }
-  
-  os << conn.footer() << std::endl;
+  int nNodes = nodeOrder.size();
 
+  Array<int> connectivity(nc*nNodes);
+  Array<int> offsets(nc);
+  Array<unsigned char> types(nc, (unsigned char) vtkCode);
 
-  XMLObject offsets("DataArray");
-  offsets.addAttribute("type", "Int32");
-  offsets.addAttribute("Name", "offsets");
-  offsets.addAttribute("format", "ascii");
-  
-  os << offsets.header() << std::endl;
-
-  int count = 0;
   for (int c=0; c<nc; c++)
     {
-			count += mesh().numFacets(dim, c, 0);
-      os << count << std::endl;
+      for (int i=0; i<nNodes; i++)
+        {
+          connectivity[c*nNodes + i] 
+            = mesh().facetLID(dim, c, 0, nodeOrder[i], dummySign);
+        }
+      offsets[c] = (c+1)*nNodes;
     }
 
-  os << offsets.footer() << std::endl;
-
-  XMLObject types("DataArray");
-  types.addAttribute("type", "UInt8");
-  types.addAttribute("Name", "types");
-  types.addAttribute("format", "ascii");
-
-  os << types.header() << std::endl;
-
-  for (int c=0; c<nc; c++)
-    {
+  XMLObject conn("DataArray");
+  conn.addAttribute("type", "Int32");
+  conn.addAttribute("Name", "connectivity");
+  writeArrayValues(os, conn, connectivity, nNodes);
 
-			int vtkCode = 0;
-			switch(cellType)
-				{
-				case TriangleCell:
-					vtkCode = 5;
-					break;
-				case QuadCell:
-					vtkCode = 9;
-					break;
-				case TetCell:
-					vtkCode = 10;
-					break;
-				case BrickCell:
-					vtkCode = 11;
-					break;
-        default:
-          TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error,
-                             "call type " << cellType << " not handled "
-                             "in VTKWriter::writeCells()");
-				}
-			os << vtkCode << std::endl;
-    }
+  XMLObject offs("DataArray");
+  offs.addAttribute("type", "Int32");
+  offs.addAttribute("Name", "offsets");
+  writeArrayValues(os, offs, offsets, 1);
 
-  os << types.footer() << std::endl;
+  XMLObject typesXML("DataArray");
+  typesXML.addAttribute("type", "UInt8");
+  typesXML.addAttribute("Name", "types");
+  writeArrayValues(os, typesXML, types, 1);
 
   os << cells.footer() << std::endl;
 }
@@ -349,65 +423,48 @@ void VTKWriter::writeDataArray(std::ostream& os, const std::string& name,
   XMLObject xml(PHeader + "DataArray");
   xml.addAttribute("type", "Float32");
   xml.addAttribute("Name", name);
-  xml.addAttribute("format", "ascii");
-  
-  if (expr->numElems() > 1)
+
+  /* Since we are plotting always in 3D, vectors have at least 3 
+   * components and not "expr->numElems()" */
+  int nElems = expr->numElems();
+  int nComps = 1;
+  if (nElems > 1)
     {
-	  // Since we are plotting always in 3D the vector components have 3 component and not "expr->numElems()"
-      xml.addAttribute("NumberOfComponents", "3" );
+      nComps = std::max(3, nElems);
+      xml.addAttribute("NumberOfComponents", Teuchos::toString(nComps));
     }
-  
-  os << xml.header() << std::endl;
 
   /* write the point|cell data, unless this is a parallel header */
-  if (!isPHeader)
+  if (isPHeader)
     {
+      os << xml << std::endl;
+      return;
+    }
 
-      if (isPointData)
-        {
-          int numNodes = mesh().numCells(0);
+  int cellDim = 0;
+  if (!isPointData) cellDim = mesh().spatialDim();
+  int n = mesh().numCells(cellDim);
+  float undef = undefinedValue();
+
+  /* the components beyond numElems() are left at zero */
+  Array<float> vals(n*nComps, 0.0);
 
-          for (int i=0; i<numNodes; i++)
+  for (int i=0; i<n; i++)
+    {
+      for (int j=0; j<nElems; j++)
+        {
+          if (expr->isDefined(cellDim,i,j))
             {
-              for (int j=0; j < expr->numElems(); j++)
-                {
-                  if (expr->isDefined(0,i,j)){
-                	double val = expr->getData(0, i, j);
-                    val = (fabs(val) > 1e-16) ? val : 0.0;
-                    os << (float) val << std::endl;
-                  }else
-                    os << undefinedValue() << std::endl;
-                }
-              // write the rest with 0.0 if it is a zero component
-              if (expr->numElems() > 1)
-            	  for (int j= expr->numElems(); j < 3 ; j++)
-            		  os << "0.0 " << std::endl;
+              double val = expr->getData(cellDim, i, j);
+              val = (fabs(val) > 1e-16) ? val : 0.0;
+              vals[i*nComps + j] = val;
             }
-        }
-      else
-        {
-          int dim = mesh().spatialDim();
-          int nc = mesh().numCells(dim);
-          
-          for (int c=0; c<nc; c++)
+          else
             {
-              for (int j=0; j < expr->numElems(); j++)
-                {
-                  if (expr->isDefined(dim,c,j)){
-                   	double val = expr->getData(dim, c, j);
-                    val = (fabs(val) > 1e-16) ? val : 0.0;
-                    os << (float) val << std::endl;
-                  }else
-                    os << undefinedValue() << std::endl;
-                }
-              // write the rest with 0.0 if it is a zero component
-              if (expr->numElems() > 1)
-            	  for (int j= expr->numElems(); j < 3 ; j++)
-            		  os << "0.0 " << std::endl;
+              vals[i*nComps + j] = undef;
             }
         }
     }
 
-  os << xml.footer() << std::endl;
+  writeArrayValues(os, xml, vals, 1);
 }
-
@@ -45,9 +45,22 @@
 
 #include "SundanceDefs.hpp"
 #include "SundanceFieldWriterBase.hpp"
+#include "Teuchos_XMLObject.hpp"
 
 namespace Sundance
 {
+/** 
+ * Encoding of the data arrays in a VTK file. 
+ * <ul>
+ * <li> VTKAscii writes values as text.
+ * <li> VTKBinary writes each array inline as base64-encoded binary.
+ * <li> VTKAppended writes all arrays as raw binary in a single 
+ * AppendedData section at the end of the file. This gives the smallest
+ * files and the fastest writes.
+ * </ul>
+ */
+enum VTKFormat {VTKAscii, VTKBinary, VTKAppended};
+
 /**
  * VTKWriter writes a mesh or fields to a VTK file
  */
@@ -55,8 +68,8 @@ class VTKWriter : public FieldWriterBase
 {
 public:
   /** */
-  VTKWriter(const std::string& filename="") 
-    : FieldWriterBase(filename) {;}
+  VTKWriter(const std::string& filename="", VTKFormat format=VTKAscii) 
+    : FieldWriterBase(filename), format_(format), appendedData_() {;}
     
   /** virtual dtor */
   virtual ~VTKWriter(){;}
@@ -64,6 +77,9 @@ public:
   /** */
   virtual void write() const ;
 
+  /** */
+  VTKFormat format() const {return format_;}
+
   /** Return a ref count pointer to self */
   virtual RCP<FieldWriterBase> getRcp() {return rcp(this);}
 
@@ -87,6 +103,19 @@ private:
   /** */
   void writeDataArray(std::ostream& os, const std::string& name,
     const RCP<FieldBase>& expr, bool isPHeader, bool isPointData) const ;
+
+  /** Write the values of a data array, encoded according to the 
+   * writer's format. The XML element must have all attributes except
+   * the format already set. */
+  template <class T>
+  void writeArrayValues(std::ostream& os, XMLObject& xml, 
+    const Array<T>& vals, int valsPerLine) const ;
+
+  /** */
+  VTKFormat format_;
+
+  /** Raw data to be written to the AppendedData section */
+  mutable std::string appendedData_;
 };
 
 /** 
@@ -96,15 +125,17 @@ class VTKWriterFactory : public FieldWriterFactoryBase
 {
 public:
   /** */
-  VTKWriterFactory() {}
+  VTKWriterFactory(VTKFormat format=VTKAscii) : format_(format) {}
 
   /** Create a writer with the specified filename */
   RCP<FieldWriterBase> createWriter(const string& name) const 
-    {return rcp(new VTKWriter(name));}
+    {return rcp(new VTKWriter(name, format_));}
 
   /** */
   virtual RCP<FieldWriterFactoryBase> getRcp() {return rcp(this);}
-  
+
+private:
+  VTKFormat format_;
 };
 
 }
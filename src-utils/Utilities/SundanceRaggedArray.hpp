@@ -0,0 +1,205 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#ifndef SUNDANCE_RAGGEDARRAY_H
+#define SUNDANCE_RAGGEDARRAY_H
+
+#include "Teuchos_Array.hpp"
+
+namespace Sundance
+{
+  using namespace Teuchos;
+
+  /** 
+   * Class RaggedArray stores a 2D array whose rows have varying lengths.
+   * While a data structure is being built, rows can be appended to 
+   * independently and are stored as separate arrays. Once building is 
+   * done, pack() compresses the rows into compressed-sparse-row form, 
+   * an array of row offsets plus a single array of entries, removing 
+   * the per-row allocations. Appending to a packed array unpacks it.
+   */
+  template<class T>
+    class RaggedArray
+    {
+    public:
+      /** Empty ctor */
+      RaggedArray();
+
+      /** Returns the number of rows */
+      int length() const 
+        {return isPacked_ ? offsets_.length()-1 : rows_.length();}
+
+      /** Returns the number of entries in the i-th row */
+      int rowLength(int i) const 
+        {
+          if (isPacked_) return offsets_[i+1] - offsets_[i];
+          return rows_[i].length();
+        }
+
+      /** Get the j-th entry in the i-th row */
+      const T& value(int i, int j) const 
+        {
+          if (isPacked_) return data_[offsets_[i]+j];
+          return rows_[i][j];
+        }
+
+      /** Copy the i-th row into an array */
+      void getRow(int i, Array<T>& row) const ;
+
+      /** Change the number of rows, unpacking if necessary */
+      void resize(int n) {if (isPacked_) unpack(); rows_.resize(n);}
+
+      /** Reserve memory for a number of rows */
+      void reserve(int n) {if (!isPacked_) rows_.reserve(n);}
+
+      /** Append an entry to the i-th row, unpacking if necessary */
+      void append(int i, const T& x) 
+        {
+          if (isPacked_) unpack(); 
+          rows_[i].append(x);
+        }
+
+      /** Whether the array is in packed form */
+      bool isPacked() const {return isPacked_;}
+
+      /** Compress the rows into packed form */
+      void pack() ;
+
+      /** Expand a packed array back into separately stored rows */
+      void unpack() ;
+
+      /** Make this an empty packed array, ready to have its row offsets
+       * and entries filled in directly through offsets() and data() */
+      void resetPacked() ;
+
+      /** Row offsets of the packed form. Only valid when packed. */
+      const Array<int>& offsets() const {return offsets_;}
+
+      /** Row offsets of the packed form. Only valid when packed. */
+      Array<int>& offsets() {return offsets_;}
+
+      /** Entries of the packed form. Only valid when packed. */
+      const Array<T>& data() const {return data_;}
+
+      /** Entries of the packed form. Only valid when packed. */
+      Array<T>& data() {return data_;}
+
+      /** Approximate number of bytes of heap storage in use */
+      size_t bytes() const ;
+
+    private:
+      bool isPacked_;
+      Array<Array<T> > rows_;
+      Array<int> offsets_;
+      Array<T> data_;
+    };
+
+  template<class T> inline RaggedArray<T>::RaggedArray()
+    : isPacked_(false), rows_(), offsets_(1, 0), data_()
+    {;}
+
+  template<class T> inline void RaggedArray<T>::getRow(int i, 
+    Array<T>& row) const
+    {
+      int n = rowLength(i);
+      row.resize(n);
+      for (int j=0; j<n; j++) row[j] = value(i,j);
+    }
+
+  template<class T> inline void RaggedArray<T>::pack()
+    {
+      if (isPacked_) return;
+      int n = rows_.length();
+      offsets_.resize(n+1);
+      offsets_[0] = 0;
+      for (int i=0; i<n; i++) offsets_[i+1] = offsets_[i] + rows_[i].length();
+      data_.resize(offsets_[n]);
+      for (int i=0; i<n; i++)
+        {
+          const Array<T>& r = rows_[i];
+          int base = offsets_[i];
+          for (int j=0; j<r.length(); j++) data_[base+j] = r[j];
+        }
+      /* assign an empty array to release the row storage */
+      rows_ = Array<Array<T> >();
+      isPacked_ = true;
+    }
+
+  template<class T> inline void RaggedArray<T>::unpack()
+    {
+      if (!isPacked_) return;
+      int n = offsets_.length()-1;
+      rows_.resize(n);
+      for (int i=0; i<n; i++)
+        {
+          int len = offsets_[i+1] - offsets_[i];
+          rows_[i].resize(len);
+          for (int j=0; j<len; j++) rows_[i][j] = data_[offsets_[i]+j];
+        }
+      offsets_ = Array<int>(1, 0);
+      data_ = Array<T>();
+      isPacked_ = false;
+    }
+
+  template<class T> inline void RaggedArray<T>::resetPacked()
+    {
+      rows_ = Array<Array<T> >();
+      offsets_ = Array<int>(1, 0);
+      data_ = Array<T>();
+      isPacked_ = true;
+    }
+
+  template<class T> inline size_t RaggedArray<T>::bytes() const
+    {
+      if (isPacked_) 
+        {
+          return offsets_.capacity()*sizeof(int) + data_.capacity()*sizeof(T);
+        }
+      size_t rtn = rows_.capacity()*sizeof(Array<T>);
+      for (int i=0; i<rows_.length(); i++) 
+        {
+          rtn += rows_[i].capacity()*sizeof(T);
+        }
+      return rtn;
+    }
+}
+
+#endif
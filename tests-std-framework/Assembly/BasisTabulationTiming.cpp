@@ -0,0 +1,236 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "SundanceBasisFamily.hpp"
+#include "SundanceBasisTabulationCache.hpp"
+#include "SundanceLagrange.hpp"
+#include "SundanceQuadratureFamily.hpp"
+#include "SundanceGaussianQuadrature.hpp"
+
+using namespace Teuchos;
+using namespace Sundance;
+
+/* 
+ * Checks that reference basis values served from the tabulation cache
+ * are identical to those computed directly by refEval(), for Lagrange
+ * bases up to high order on whole cells and on facets, and times 
+ * repeated tabulation with and without the cache. The repeated
+ * tabulations stand in for the integrals and mediators that request
+ * the same tables during assembler setup. Also checks that the cache
+ * stays within its size bound.
+ */
+
+static double tabulateRepeatedly(const BasisFamily& basis, 
+  const CellType& cellType, const QuadratureFamily& quad, int facetIndex,
+  const Array<MultiIndex>& derivs, int nReps,
+  Array<RCP<const BasisTabulation> >& vals)
+{
+  Time timer("tabulate");
+  int dim = dimension(cellType);
+  vals.resize(derivs.size());
+  timer.start();
+  for (int r=0; r<nReps; r++)
+  {
+    for (int d=0; d<derivs.size(); d++)
+    {
+      vals[d] = basis.tabulate(cellType, quad, cellType, dim-1, facetIndex,
+        derivs[d], 0);
+    }
+  }
+  timer.stop();
+  return timer.totalElapsedTime();
+}
+
+static int countDiffs(const BasisFamily& basis, const CellType& cellType,
+  const QuadratureFamily& quad, int facetIndex,
+  const Array<MultiIndex>& derivs, 
+  const Array<RCP<const BasisTabulation> >& vals)
+{
+  Array<Point> qPts;
+  Array<double> qWts;
+  if (facetIndex < 0) quad.getPoints(cellType, qPts, qWts);
+  else quad.getFacetPoints(cellType, dimension(cellType)-1, facetIndex, 
+    qPts, qWts);
+
+  int nDiff = 0;
+  for (int d=0; d<derivs.size(); d++)
+  {
+    Array<Array<Array<double> > > direct;
+    basis.refEval(cellType, qPts, derivs[d], direct, 0);
+    if (direct.size() != vals[d]->numComponents()) {nDiff++; continue;}
+    for (int k=0; k<direct.size(); k++)
+    {
+      if (direct[k].size() != vals[d]->numPoints()) {nDiff++; continue;}
+      for (int q=0; q<direct[k].size(); q++)
+      {
+        if (direct[k][q].size() != vals[d]->numFuncs(k)) 
+        {nDiff++; continue;}
+        for (int n=0; n<direct[k][q].size(); n++)
+        {
+          if (direct[k][q][n] != vals[d]->value(k, q, n)) nDiff++;
+        }
+      }
+    }
+  }
+  return nDiff;
+}
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+  {
+    GlobalMPISession session(&argc, &argv);
+
+    int pMax = 5;
+    int nReps = 20;
+    int numErrors = 0;
+
+    Array<CellType> cellTypes = tuple(TriangleCell, TetCell);
+
+    for (int c=0; c<cellTypes.size(); c++)
+    {
+      CellType cellType = cellTypes[c];
+      int dim = dimension(cellType);
+      Array<MultiIndex> derivs;
+      derivs.append(MultiIndex());
+      for (int dir=0; dir<dim; dir++)
+      {
+        MultiIndex mi;
+        mi[dir] = 1;
+        derivs.append(mi);
+      }
+
+      for (int p=1; p<=pMax; p++)
+      {
+        BasisFamily basis = new Lagrange(p);
+        QuadratureFamily quad = new GaussianQuadrature(2*p);
+
+        for (int facetIndex=-1; facetIndex<1; facetIndex++)
+        {
+          Array<RCP<const BasisTabulation> > direct;
+          Array<RCP<const BasisTabulation> > cached;
+
+          BasisTabulationCache::enabled() = false;
+          double tDirect = tabulateRepeatedly(basis, cellType, quad, 
+            facetIndex, derivs, nReps, direct);
+
+          BasisTabulationCache::clear();
+          BasisTabulationCache::enabled() = true;
+          int hits0 = BasisTabulationCache::numHits();
+          double tCached = tabulateRepeatedly(basis, cellType, quad, 
+            facetIndex, derivs, nReps, cached);
+          int hits = BasisTabulationCache::numHits() - hits0;
+
+          /* the values must be bitwise identical */
+          int nDiff = countDiffs(basis, cellType, quad, facetIndex, derivs,
+            direct)
+            + countDiffs(basis, cellType, quad, facetIndex, derivs, cached);
+        
+          /* every tabulation after the first pass should be a hit */
+          int expectedHits = (nReps-1)*derivs.size();
+
+          std::cerr << "cell=" << cellType << " p=" << p 
+                    << " facet=" << facetIndex
+                    << " nQuad=" << cached[0]->numPoints() << std::endl;
+          std::cerr << "   direct: time=" << tDirect << "s" << std::endl;
+          std::cerr << "   cached: time=" << tCached << "s"
+                    << " speedup=" << tDirect/std::max(tCached, 1.0e-12) 
+                    << " hits=" << hits << std::endl;
+          if (nDiff != 0)
+          {
+            std::cerr << "******** ERROR: tabulated values differ from "
+              "direct evaluation" << std::endl;
+            numErrors++;
+          }
+          if (hits != expectedHits)
+          {
+            std::cerr << "******** ERROR: expected " << expectedHits 
+                      << " cache hits" << std::endl;
+            numErrors++;
+          }
+        }
+      }
+    }
+
+    /* the cache must not grow past its bound */
+    BasisTabulationCache::clear();
+    int oldMax = BasisTabulationCache::maxEntries();
+    BasisTabulationCache::maxEntries() = 4;
+    BasisFamily basis = new Lagrange(2);
+    for (int p=1; p<=5; p++)
+    {
+      QuadratureFamily quad = new GaussianQuadrature(2*p);
+      basis.tabulate(TriangleCell, quad, TriangleCell, 1, -1, 
+        MultiIndex(), 0);
+    }
+    if (BasisTabulationCache::numEntries() != 4)
+    {
+      std::cerr << "******** ERROR: cache holds " 
+                << BasisTabulationCache::numEntries() 
+                << " entries, bound is 4" << std::endl;
+      numErrors++;
+    }
+    BasisTabulationCache::maxEntries() = oldMax;
+    BasisTabulationCache::clear();
+
+    if (numErrors == 0)
+    {
+      std::cerr << "basis tabulation timing test PASSED" << std::endl;
+    }
+    else
+    {
+      stat = -1;
+      std::cerr << "basis tabulation timing test FAILED" << std::endl;
+    }
+  }
+	catch(std::exception& e)
+  {
+    stat = -1;
+    std::cerr << "basis tabulation timing test FAILED" << std::endl;
+    std::cerr << e.what() << std::endl;
+  }
+
+  return stat;
+}
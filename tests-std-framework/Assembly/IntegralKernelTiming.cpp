@@ -0,0 +1,259 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "PlayaTabs.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundancePartitionedLineMesher.hpp"
+#include "SundanceDummyParametrizedCurve.hpp"
+#include "SundanceBasisFamily.hpp"
+#include "SundanceLagrange.hpp"
+#include "SundanceGaussianQuadrature.hpp"
+#include "SundanceQuadratureIntegral.hpp"
+#include "SundanceRefIntegral.hpp"
+#include "SundanceSmallGemm.hpp"
+#include "SundanceIntegrationContext.hpp"
+
+using namespace Teuchos;
+using namespace Sundance;
+
+/* 
+ * Compares the optimized and the original integral transformation 
+ * kernels on grad-grad two-forms for P1-P3 triangles and P1-P2 tets 
+ * (the highest orders Lagrange supports on those cells): cell-batched
+ * against cell-by-cell quadrature, for both the sum-first and the 
+ * sum-last quadrature methods, and specialized small matrix
+ * products against dgemm for reference integrals. Results of each pair 
+ * of kernels must agree, and the timings are printed.
+ */
+
+static void fillJacobians(int dim, CellJacobianBatch& JBatch)
+{
+  int nCells = JBatch.numCells();
+  double* J = JBatch.jVals(0);
+  for (int c=0; c<nCells; c++)
+  {
+    /* a well-conditioned perturbation of the identity, differing by cell */
+    for (int i=0; i<dim; i++)
+    {
+      for (int j=0; j<dim; j++)
+      {
+        double x = 0.1*sin(1.0 + c + 3.0*i + 7.0*j);
+        if (i==j) x += 1.0;
+        J[c*dim*dim + i*dim + j] = x;
+      }
+    }
+  }
+}
+
+static double runKernel(const QuadratureIntegral& quad, 
+  const CellJacobianBatch& JBatch,
+  const Array<double>& coeff, int nReps,
+  RCP<Array<double> >& A)
+{
+  Array<int> dummy;
+  RCP<Array<int> > cellLIDs;
+  Time timer("kernel");
+
+  A->resize(JBatch.numCells() * quad.nNodes());
+  for (int r=0; r<nReps; r++)
+  {
+    for (int i=0; i<A->size(); i++) (*A)[i] = 0.0;
+    IntegrationContext intCtx;
+    timer.start();
+    quad.transformTwoForm(intCtx, JBatch, JBatch, dummy, cellLIDs, 
+      &(coeff[0]), A);
+    timer.stop();
+  }
+  return timer.totalElapsedTime();
+}
+
+static double runRefKernel(const RefIntegral& ref, 
+  const CellJacobianBatch& JBatch, int nReps,
+  RCP<Array<double> >& A)
+{
+  Array<int> dummy;
+  RCP<Array<int> > cellLIDs;
+  Time timer("kernel");
+  double coeff = 1.5;
+
+  A->resize(JBatch.numCells() * ref.nNodes());
+  for (int r=0; r<nReps; r++)
+  {
+    for (int i=0; i<A->size(); i++) (*A)[i] = 0.0;
+    IntegrationContext intCtx;
+    timer.start();
+    ref.transformTwoForm(intCtx, JBatch, JBatch, dummy, cellLIDs, 
+      coeff, A);
+    timer.stop();
+  }
+  return timer.totalElapsedTime();
+}
+
+static bool compare(const std::string& label, 
+  const Array<double>& A, double tA, 
+  const Array<double>& B, double tB)
+{
+  Tabs tab;
+  double err = 0.0;
+  double norm = 0.0;
+  for (int i=0; i<A.size(); i++)
+  {
+    err = std::max(err, fabs(A[i] - B[i]));
+    norm = std::max(norm, fabs(A[i]));
+  }
+  bool OK = err <= 1.0e-12 * norm;
+
+  std::cerr << tab << label 
+            << ": original=" << tA 
+            << "s optimized=" << tB 
+            << "s speedup=" << tA/std::max(tB, 1.0e-12)
+            << " max diff=" << err
+            << (OK ? "" : " ERROR DETECTED!!!") << std::endl;
+  return OK;
+}
+
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  int verb = 0;
+  try
+  {
+    GlobalMPISession session(&argc, &argv);
+
+    int nCells = 4001;
+    int nReps = 10;
+    bool isInternalBdry = false;
+    int nErrors = 0;
+
+    ParametrizedCurve curve = new DummyParametrizedCurve();
+    MeshType meshType = new BasicSimplicialMeshType();
+    MeshSource mesher = new PartitionedLineMesher(0.0, 1.0, 10, meshType);
+    Mesh mesh = mesher.getMesh();
+
+    for (int dim=2; dim<=3; dim++)
+    {
+      CellType cellType = TriangleCell;
+      int pMax = 3;
+      if (dim==3) 
+      {
+        cellType = TetCell;
+        pMax = 2;
+      }
+
+      CellJacobianBatch JBatch;
+      JBatch.resize(nCells, dim, dim);
+      fillJacobians(dim, JBatch);
+
+      for (int p=1; p<=pMax; p++)
+      {
+        BasisFamily P = new Lagrange(p);
+        QuadratureFamily q = new GaussianQuadrature(2*p);
+
+        for (int sumFirst=1; sumFirst>=0; sumFirst--)
+        {
+          QuadratureIntegral::useSumFirstByDefault() = sumFirst;
+          QuadratureIntegral quad(dim, cellType, dim, cellType, P, 0, 1,
+            P, 0, 1, q, isInternalBdry, curve, mesh, verb);
+
+          Array<double> coeff(nCells*quad.nQuad());
+          for (int i=0; i<coeff.size(); i++) coeff[i] = 1.0 + 0.5*cos(1.0*i);
+
+          RCP<Array<double> > AScalar = rcp(new Array<double>());
+          RCP<Array<double> > ABatched = rcp(new Array<double>());
+
+          QuadratureIntegral::useCellBatchedKernels() = false;
+          double tScalar = runKernel(quad, JBatch, coeff, nReps, AScalar);
+          QuadratureIntegral::useCellBatchedKernels() = true;
+          double tBatched = runKernel(quad, JBatch, coeff, nReps, ABatched);
+
+          std::ostringstream quadLabel;
+          quadLabel << cellType << " P" << p << " quadrature, " 
+                    << (sumFirst ? "sum-first" : "sum-last");
+          if (!compare(quadLabel.str(), *AScalar, tScalar, *ABatched, tBatched))
+            nErrors++;
+        }
+        QuadratureIntegral::useSumFirstByDefault() = true;
+
+        RefIntegral ref(dim, cellType, dim, cellType, P, 0, 1,
+          P, 0, 1, q, isInternalBdry, curve, mesh, verb);
+
+        RCP<Array<double> > ABlas = rcp(new Array<double>());
+        RCP<Array<double> > ASmall = rcp(new Array<double>());
+
+        SmallGemm::useSpecializedKernels() = false;
+        double tBlas = runRefKernel(ref, JBatch, nReps, ABlas);
+        SmallGemm::useSpecializedKernels() = true;
+        double tSmall = runRefKernel(ref, JBatch, nReps, ASmall);
+
+        std::ostringstream refLabel;
+        refLabel << cellType << " P" << p << " reference";
+        if (!compare(refLabel.str(), *ABlas, tBlas, *ASmall, tSmall))
+          nErrors++;
+      }
+    }
+
+    if (nErrors == 0)
+    {
+      std::cerr << "Integral kernel timing test PASSED" << std::endl;
+    }
+    else
+    {
+      stat = -1;
+      std::cerr << "Integral kernel timing test FAILED" << std::endl;
+    }
+  }
+	catch(std::exception& e)
+  {
+    stat = -1;
+    std::cerr << "Integral kernel timing test FAILED" << std::endl;
+    std::cerr << e.what() << std::endl;
+  }
+
+  return stat;
+}
@@ -0,0 +1,179 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundanceMeshTransformation.hpp"
+#include "SundanceExtrusionMeshTransformation.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+#include "SundanceCellJacobianBatch.hpp"
+
+using namespace Teuchos;
+using namespace Sundance;
+
+/* 
+ * Compares closed-form Jacobian determinants and inverses against 
+ * the LAPACK path on every cell of a triangle mesh and a tet mesh, 
+ * processed in worksets as during assembly, and prints the timings.
+ */
+
+static double runJacobians(const Mesh& mesh, int workSetSize, int nReps,
+  Array<double>& detJ, Array<double>& invJ, Array<double>& x)
+{
+  int dim = mesh.spatialDim();
+  int nCells = mesh.numCells(dim);
+  CellJacobianBatch JBatch;
+  Array<int> workSet;
+  Array<double> inv;
+  Time timer("jacobians");
+
+  for (int r=0; r<nReps; r++)
+  {
+    detJ.resize(0);
+    invJ.resize(0);
+    x.resize(0);
+    timer.start();
+    for (int start=0; start<nCells; start+=workSetSize)
+    {
+      workSet.resize(0);
+      for (int c=start; c<nCells && c<start+workSetSize; c++) 
+        workSet.append(c);
+      mesh.getJacobians(dim, workSet, JBatch);
+      for (int c=0; c<workSet.size(); c++)
+      {
+        detJ.append(::fabs(JBatch.detJ()[c]));
+        JBatch.getInvJ(c, inv);
+        for (int i=0; i<inv.size(); i++) invJ.append(inv[i]);
+        /* solve with J and with its transpose */
+        double rhs[6] = {1.0, 2.0, 3.0, -1.0, 0.5, 0.25};
+        JBatch.applyInvJ(c, rhs, 1, false);
+        JBatch.applyInvJ(c, rhs+dim, 1, true);
+        for (int i=0; i<2*dim; i++) x.append(rhs[i]);
+      }
+    }
+    timer.stop();
+  }
+  return timer.totalElapsedTime();
+}
+
+static double maxRelDiff(const Array<double>& a, const Array<double>& b)
+{
+  TEUCHOS_TEST_FOR_EXCEPT(a.size() != b.size());
+  double rtn = 0.0;
+  for (int i=0; i<a.size(); i++)
+  {
+    double d = ::fabs(a[i]-b[i]) / (1.0 + ::fabs(a[i]));
+    if (d > rtn) rtn = d;
+  }
+  return rtn;
+}
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+  {
+    GlobalMPISession session(&argc, &argv);
+
+    int n = 64;
+    int nReps = 5;
+    int workSetSize = 400;
+
+    MeshType meshType = new BasicSimplicialMeshType();
+    MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+      0.0, 1.0, n, 1, meshType);
+    Mesh mesh2D = mesher.getMesh();
+
+    MeshTransformation extruder 
+      = new ExtrusionMeshTransformation(0.0, 1.0, n/4, meshType);
+    Mesh mesh3D = extruder.apply(mesh2D);
+
+    Array<Mesh> meshes = tuple(mesh2D, mesh3D);
+
+    for (int m=0; m<meshes.size(); m++)
+    {
+      int dim = meshes[m].spatialDim();
+      Array<double> detLU, invLU, xLU;
+      Array<double> detCF, invCF, xCF;
+
+      CellJacobianBatch::useClosedForm() = false;
+      double tLU = runJacobians(meshes[m], workSetSize, nReps, 
+        detLU, invLU, xLU);
+      CellJacobianBatch::useClosedForm() = true;
+      double tCF = runJacobians(meshes[m], workSetSize, nReps, 
+        detCF, invCF, xCF);
+
+      double err = std::max(maxRelDiff(detLU, detCF),
+        std::max(maxRelDiff(invLU, invCF), maxRelDiff(xLU, xCF)));
+
+      std::cerr << "dim=" << dim << " cells=" 
+                << meshes[m].numCells(dim) << std::endl;
+      std::cerr << "   LU: time=" << tLU << "s" << std::endl;
+      std::cerr << "   closed form: time=" << tCF << "s"
+                << " speedup=" << tLU/std::max(tCF, 1.0e-12) << std::endl;
+      std::cerr << "   max relative difference=" << err << std::endl;
+      if (err > 1.0e-12) stat = -1;
+    }
+
+    if (stat == 0)
+    {
+      std::cerr << "Jacobian batch timing test PASSED" << std::endl;
+    }
+    else
+    {
+      std::cerr << "Jacobian batch timing test FAILED" << std::endl;
+    }
+  }
+	catch(std::exception& e)
+  {
+    stat = -1;
+    std::cerr << "Jacobian batch timing test FAILED" << std::endl;
+    std::cerr << e.what() << std::endl;
+  }
+
+  return stat;
+}
@@ -75,6 +75,7 @@
 #include "SundanceEvalVector.hpp"
 #include "SundanceRefIntegral.hpp"
 #include "SundanceQuadratureIntegral.hpp"
+#include "SundanceIntegrationContext.hpp"
 #include "PlayaVectorType.hpp"
 #include "PlayaEpetraVectorType.hpp"
 
@@ -126,6 +127,7 @@ int main(int argc, char** argv)
 
     CellJacobianBatch JBatch;
     JBatch.resize(nCells, 2, 2);
+    IntegrationContext intCtx;
     double* J = JBatch.jVals(0);
     J[0] = b[0] - a[0];
     J[1] = c[0] - a[0];
@@ -174,7 +176,7 @@ int main(int argc, char** argv)
           RefIntegral ref(dim, cellType, dim, cellType, P, alpha, dp, q4 , isInternalBdry, curve, mesh ,verb);
           A->resize(JBatch.numCells() * ref.nNodes());
           for (int ai=0; ai<A->size(); ai++) (*A)[ai]=0.0;
-          ref.transformOneForm(JBatch, JBatch, dummy, cellLIDs , coeff, A);
+          ref.transformOneForm(intCtx, JBatch, JBatch, dummy, cellLIDs , coeff, A);
           std::cerr << tab << "transformed reference element" << std::endl;
           if (dp>0) std::cerr << tab << "test diff direction=" << t << std::endl;
           for (int cell=0; cell<nCells; cell++)
@@ -191,7 +193,7 @@ int main(int argc, char** argv)
           Array<double> quadCoeff(2*quad.nQuad(), 1.0);
           B->resize(JBatch.numCells() * quad.nNodes());
           for (int ai=0; ai<B->size(); ai++) (*B)[ai]=0.0;
-          quad.transformOneForm(JBatch, JBatch, dummy, cellLIDs , &(quadCoeff[0]), B);
+          quad.transformOneForm(intCtx, JBatch, JBatch, dummy, cellLIDs , &(quadCoeff[0]), B);
           std::cerr << tab << "transformed quad element" << std::endl;
           if (dp>0) std::cerr << tab << "test diff direction =" << t << std::endl;
           for (int cell=0; cell<nCells; cell++)
@@ -280,7 +282,7 @@ int main(int argc, char** argv)
                   dp, Q, beta, dq, quad_1 , isInternalBdry, curve , mesh , verb);
                 A->resize(JBatch.numCells() * ref.nNodes());
                 for (int ai=0; ai<A->size(); ai++) (*A)[ai]=0.0;
-                ref.transformTwoForm(JBatch, JBatch, dummy, cellLIDs , coeff, A);
+                ref.transformTwoForm(intCtx, JBatch, JBatch, dummy, cellLIDs , coeff, A);
                 std::cerr << tab << "transformed ref element" << std::endl;
                 std::cerr << tab << "test diff order = " << dp << std::endl;
                 if (dp>0) std::cerr << tab << "t=dx(" << t << ")" << std::endl;
@@ -310,7 +312,7 @@ int main(int argc, char** argv)
                 Array<double> quadCoeff(2*quad.nQuad(), 1.0);
                 B->resize(JBatch.numCells() * quad.nNodes());
                 for (int ai=0; ai<B->size(); ai++) (*B)[ai]=0.0;
-                quad.transformTwoForm(JBatch, JBatch, dummy, cellLIDs , &(quadCoeff[0]), B);
+                quad.transformTwoForm(intCtx, JBatch, JBatch, dummy, cellLIDs , &(quadCoeff[0]), B);
 
                 std::cerr << tab << "transformed quad element" << std::endl;
                 std::cerr << tab << "test diff order = " << dp << std::endl;
@@ -0,0 +1,167 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "Sundance.hpp"
+#include "Teuchos_Time.hpp"
+#include <set>
+#include <algorithm>
+#include <iterator>
+
+/* 
+ * Checks the set operations on explicit cell sets against std::set, 
+ * and compares the time for walking a large subset one cell at a time
+ * with the time for copying it out in workset-sized blocks.
+ */
+
+CELL_PREDICATE(LeftTest, {return x[0] <= 0.6;});
+
+CELL_PREDICATE(BottomTest, {return x[1] <= 0.3;});
+
+std::set<int> toStdSet(const CellSet& cells)
+{
+  std::set<int> rtn;
+  for (CellIterator i=cells.begin(); i!=cells.end(); i++) rtn.insert(*i);
+  return rtn;
+}
+
+bool sameCells(const CellSet& cells, const std::set<int>& ref)
+{
+  Array<int> a;
+  for (CellIterator i=cells.begin(); i!=cells.end(); i++) a.append(*i);
+  if (a.size() != (int) ref.size() || cells.numCells() != a.size()) 
+    return false;
+  return std::equal(a.begin(), a.end(), ref.begin());
+}
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+
+      int n = 256;
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+        0.0, 1.0, n, 1, meshType);
+      Mesh mesh = mesher.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter left = interior.subset(new LeftTest());
+      CellFilter bottom = interior.subset(new BottomTest());
+
+      CellSet L = left.getCells(mesh);
+      CellSet B = bottom.getCells(mesh);
+      std::set<int> refL = toStdSet(L);
+      std::set<int> refB = toStdSet(B);
+
+      std::set<int> refUnion;
+      std::set<int> refInter;
+      std::set<int> refDiff;
+      std::set_union(refL.begin(), refL.end(), refB.begin(), refB.end(),
+        std::inserter(refUnion, refUnion.begin()));
+      std::set_intersection(refL.begin(), refL.end(), refB.begin(), refB.end(),
+        std::inserter(refInter, refInter.begin()));
+      std::set_difference(refL.begin(), refL.end(), refB.begin(), refB.end(),
+        std::inserter(refDiff, refDiff.begin()));
+
+      bool ok = sameCells(L.setUnion(B), refUnion)
+        && sameCells(L.setIntersection(B), refInter)
+        && sameCells(L.setDifference(B), refDiff)
+        && sameCells((left + bottom).getCells(mesh), refUnion)
+        && sameCells((left - bottom).getCells(mesh), refDiff);
+      Out::root() << "set operations agree with std::set: " 
+                  << ok << std::endl;
+
+      /* walk the left subset in worksets, cell by cell and by blocks */
+      int nReps = 20;
+      int workSetSize = 400;
+      Array<int> workSet;
+      workSet.reserve(workSetSize);
+
+      int sum1 = 0;
+      Time t1("cell by cell");
+      t1.start();
+      for (int r=0; r<nReps; r++)
+      {
+        CellIterator iter = L.begin();
+        while (iter != L.end())
+        {
+          workSet.resize(0);
+          for (int c=0; c<workSetSize && iter != L.end(); c++, iter++)
+          {
+            workSet.append(*iter);
+          }
+          sum1 += workSet[workSet.size()-1];
+        }
+      }
+      t1.stop();
+
+      int sum2 = 0;
+      Time t2("blocks");
+      t2.start();
+      for (int r=0; r<nReps; r++)
+      {
+        CellIterator iter = L.begin();
+        while (iter != L.end())
+        {
+          workSet.resize(0);
+          iter.appendBlock(L.end(), workSetSize, workSet);
+          sum2 += workSet[workSet.size()-1];
+        }
+      }
+      t2.stop();
+
+      Out::root() << "num cells in subset = " << L.numCells() << std::endl;
+      Out::root() << "cell by cell: time=" << t1.totalElapsedTime() 
+                  << "s" << std::endl;
+      Out::root() << "blocks: time=" << t2.totalElapsedTime() << "s" 
+                  << std::endl;
+
+      double err = (ok && sum1==sum2) ? 0.0 : 1.0;
+      Sundance::passFailTest(err, 1.0e-12);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
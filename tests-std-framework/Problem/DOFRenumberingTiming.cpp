@@ -0,0 +1,163 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+#include "PlayaEpetraMatrix.hpp"
+#include "PlayaILUKPreconditionerFactory.hpp"
+#include "SundanceDOFMapBase.hpp"
+#include "Epetra_CrsMatrix.h"
+#include "Teuchos_Time.hpp"
+
+/* 
+ * Compares matrix bandwidth, SpMV time, and ILU(1) setup and apply 
+ * times for a two-component P1 problem on the unit disk with and 
+ * without RCM renumbering of the DOFs. The solution norm must not
+ * depend on the numbering.
+ */
+
+int bandwidth(const LinearOperator<double>& A)
+{
+  RCP<const Epetra_CrsMatrix> crs = EpetraMatrix::getConcretePtr(A);
+  int rtn = 0;
+  for (int r=0; r<crs->NumMyRows(); r++)
+  {
+    int nnz;
+    double* vals;
+    int* cols;
+    crs->ExtractMyRowView(r, nnz, vals, cols);
+    for (int k=0; k<nnz; k++)
+    {
+      int b = std::abs(cols[k] - r);
+      if (b > rtn) rtn = b;
+    }
+  }
+  return rtn;
+}
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+
+      VectorType<double> vecType = new EpetraVectorType();
+      LinearSolver<double> solver 
+        = LinearSolverBuilder::createSolver("amesos.xml");
+
+      ParameterList iluParams;
+      iluParams.set("Graph Fill", 1);
+      ILUKPreconditionerFactory<double> iluFactory(iluParams);
+
+      int nReps = 20;
+      double refNorm = 0.0;
+      double err = 0.0;
+
+      for (int pass=0; pass<2; pass++)
+      {
+        DOFMapBase::useRCMRenumbering() = (pass==1);
+
+        MeshType meshType = new BasicSimplicialMeshType();
+        MeshSource meshReader = new TriangleMeshReader("disk.1", meshType);
+        Mesh mesh = meshReader.getMesh();
+
+        CellFilter interior = new MaximalCellFilter();
+        CellFilter bdry = new BoundaryCellFilter();
+
+        Expr u = List(new UnknownFunction(new Lagrange(1), "u0"),
+          new UnknownFunction(new Lagrange(1), "u1"));
+        Expr v = List(new TestFunction(new Lagrange(1), "v0"),
+          new TestFunction(new Lagrange(1), "v1"));
+        Expr grad = gradient(2);
+
+        QuadratureFamily quad = new GaussianQuadrature(2);
+        Expr eqn = Integral(interior, 
+          (grad*v[0])*(grad*u[0]) + (grad*v[1])*(grad*u[1])
+          + v[0]*u[1] + v[0] + 2.0*v[1], quad);
+        Expr bc = EssentialBC(bdry, v*u, quad);
+
+        LinearProblem prob(mesh, eqn, bc, v, u, vecType);
+        LinearOperator<double> A = prob.getOperator();
+
+        Vector<double> x = A.domain().createMember();
+        Vector<double> y = A.range().createMember();
+        x.randomize();
+
+        Time spmvTimer("SpMV");
+        spmvTimer.start();
+        for (int r=0; r<nReps; r++) A.apply(x, y);
+        spmvTimer.stop();
+
+        Time iluSetupTimer("ILU setup");
+        iluSetupTimer.start();
+        Preconditioner<double> P = iluFactory.createPreconditioner(A);
+        iluSetupTimer.stop();
+
+        LinearOperator<double> M = P.right();
+        Time iluApplyTimer("ILU apply");
+        iluApplyTimer.start();
+        for (int r=0; r<nReps; r++) M.apply(y, x);
+        iluApplyTimer.stop();
+
+        Expr soln = prob.solve(solver);
+        double norm = L2Norm(mesh, interior, soln, quad);
+        if (pass==0) refNorm = norm;
+        err = std::max(err, std::fabs(norm - refNorm));
+
+        Out::root() << (pass==0 ? "traversal order" : "RCM order      ")
+                    << " bandwidth = " << bandwidth(A) 
+                    << " SpMV = " << spmvTimer.totalElapsedTime()/nReps
+                    << " ILU setup = " << iluSetupTimer.totalElapsedTime()
+                    << " ILU apply = " 
+                    << iluApplyTimer.totalElapsedTime()/nReps 
+                    << " |u| = " << norm << std::endl;
+      }
+      DOFMapBase::useRCMRenumbering() = false;
+      
+      Sundance::passFailTest(err, 1.0e-10);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
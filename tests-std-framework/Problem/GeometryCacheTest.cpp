@@ -0,0 +1,135 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "Sundance.hpp"
+#include "SundanceGeometryCache.hpp"
+#include "Teuchos_Time.hpp"
+
+/* 
+ * Assembles the same operator repeatedly, as in the steps of a 
+ * transient run, with and without the geometry cache. The problem uses
+ * coordinate functions and a derivative on the boundary so that the 
+ * cached physical quadrature points and cofacet Jacobians are used. 
+ * Results must be identical, and after the first assembly every 
+ * workset should be a cache hit.
+ */
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+
+      VectorType<double> vecType = new EpetraVectorType();
+
+      int n = 64;
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+        0.0, 1.0, n, 1, meshType);
+      Mesh mesh = mesher.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter bdry = new BoundaryCellFilter();
+
+      Expr u = new UnknownFunction(new Lagrange(1), "u");
+      Expr v = new TestFunction(new Lagrange(1), "v");
+      Expr dx = new Derivative(0);
+      Expr grad = gradient(2);
+      Expr x = new CoordExpr(0);
+      Expr y = new CoordExpr(1);
+
+      QuadratureFamily quad = new GaussianQuadrature(2);
+      Expr eqn = Integral(interior, (1.0 + x*y)*(grad*v)*(grad*u) 
+        + v*sin(x), quad)
+        + Integral(bdry, v*(dx*u) + x*v*u, quad);
+      Expr bc;
+
+      int nSteps = 5;
+
+      /* reference: no caching */
+      LinearProblem prob0(mesh, eqn, bc, v, u, vecType);
+      LinearOperator<double> A0 = prob0.getOperator();
+      Vector<double> b0 = prob0.getSingleRHS();
+      Vector<double> z = A0.domain().createMember();
+      z.randomize();
+      Vector<double> Az0 = A0*z;
+
+      Time tOff("no cache");
+      tOff.start();
+      for (int s=0; s<nSteps; s++) prob0.getOperator();
+      tOff.stop();
+
+      GeometryCache::enable(mesh);
+      LinearProblem prob(mesh, eqn, bc, v, u, vecType);
+
+      double err = 0.0;
+      Time tOn("cache");
+      tOn.start();
+      for (int s=0; s<nSteps; s++) 
+      {
+        LinearOperator<double> A = prob.getOperator();
+        Vector<double> b = prob.getSingleRHS();
+        Vector<double> Az = A*z;
+        err = std::max(err, (Az - Az0).norm2() + (b - b0).norm2());
+      }
+      tOn.stop();
+
+      GeometryCache::printStats(Out::root());
+      Out::root() << "time without cache=" << tOff.totalElapsedTime() 
+                  << "s, with cache=" << tOn.totalElapsedTime() << "s"
+                  << std::endl;
+      Out::root() << "max difference = " << err << std::endl;
+
+      if (GeometryCache::numHits() == 0 
+        || GeometryCache::hitRate() < 0.5) err = 1.0;
+
+      GeometryCache::disable(mesh);
+      if (GeometryCache::bytesInUse() != 0) err = 1.0;
+      
+      Sundance::passFailTest(err, 1.0e-10);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
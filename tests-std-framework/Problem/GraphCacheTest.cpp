@@ -0,0 +1,108 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+#include "SundanceMatrixGraphCache.hpp"
+
+/* 
+ * Builds a stiffness matrix and a mass matrix for the same unknown and
+ * test functions, then a second stiffness matrix. The second stiffness
+ * matrix should reuse the graph of the first, and applying it must 
+ * give the same result.
+ */
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+
+      VectorType<double> vecType = new EpetraVectorType();
+
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource meshReader = new TriangleMeshReader("disk.1", meshType);
+      Mesh mesh = meshReader.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter bdry = new BoundaryCellFilter();
+
+      Expr u = new UnknownFunction(new Lagrange(1), "u");
+      Expr v = new TestFunction(new Lagrange(1), "v");
+      Expr grad = gradient(2);
+
+      QuadratureFamily quad = new GaussianQuadrature(2);
+      Expr stiff = Integral(interior, (grad*v)*(grad*u) + v, quad);
+      Expr mass = Integral(interior, v*u + v, quad);
+      Expr bc = EssentialBC(bdry, v*u, quad);
+
+      int hits0 = MatrixGraphCache::numHits();
+
+      LinearProblem prob1(mesh, stiff, bc, v, u, vecType);
+      LinearOperator<double> A1 = prob1.getOperator();
+
+      LinearProblem probM(mesh, mass, bc, v, u, vecType);
+      LinearOperator<double> M = probM.getOperator();
+
+      LinearProblem prob2(mesh, stiff, bc, v, u, vecType);
+      LinearOperator<double> A2 = prob2.getOperator();
+
+      int hits = MatrixGraphCache::numHits() - hits0;
+      Out::root() << "graph cache hits = " << hits << std::endl;
+
+      Vector<double> x = A1.domain().createMember();
+      x.randomize();
+      Vector<double> y1 = A1*x;
+      Vector<double> y2 = A2*x;
+      double err = (y1 - y2).norm2();
+      Out::root() << "|A1*x - A2*x| = " << err << std::endl;
+
+      if (hits < 1) err = 1.0;
+      
+      Sundance::passFailTest(err, 1.0e-12);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
@@ -0,0 +1,184 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "Sundance.hpp"
+
+/** 
+ * Solves the equation
+ * 
+ * \f[ -\left((1+u^2) u'\right)' = 10 \f]
+ *
+ * with homogeneous Dirichlet BC on the interval \f$ (0, 1) \f$, once 
+ * with an assembled Jacobian and then Jacobian-free, both with a 
+ * preconditioner built from the Jacobian of the simplified problem 
+ * \f$ -u'' = 10 \f$ and with no preconditioner at all. Each 
+ * Jacobian-free solution is compared with the assembled-Jacobian one.
+ */
+
+CELL_PREDICATE(LeftPointTest, {return fabs(x[0]) < 1.0e-10;})
+CELL_PREDICATE(RightPointTest, {return fabs(x[0]-1.0) < 1.0e-10;})
+
+/* Newton parameters shared by the solves */
+ParameterList newtonParams()
+{
+  ParameterList rtn("NewtonArmijoSolver");
+  rtn.set("Tau Relative", 1.0e-12);
+  rtn.set("Tau Absolute", 1.0e-12);
+  rtn.set("Max Iterations", 40);
+  rtn.set("Forcing Term", std::string("Eisenstat-Walker"));
+  rtn.set("Verbosity", 0);    
+  return rtn;
+}
+
+/* Unpreconditioned GMRES, with a Krylov space large enough for the
+ * whole problem */
+LinearSolver<double> unpreconditionedSolver()
+{
+  ParameterList params;
+  ParameterList& ls = params.sublist("Linear Solver");
+  ls.set("Type", std::string("Aztec"));
+  ls.set("Method", std::string("GMRES"));
+  ls.set("Precond", std::string("None"));
+  ls.set("Restart Size", 600);
+  ls.set("Max Iterations", 2000);
+  ls.set("Tolerance", 1.0e-12);
+  ls.set("Verbosity", 0);
+  return LinearSolverBuilder::createSolver(params);
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    Sundance::init(&argc, &argv);
+    int np = MPIComm::world().getNProc();
+
+    /* We will do our linear algebra using Epetra */
+    VectorType<double> vecType = new EpetraVectorType();
+
+    /* Create a mesh */
+    MeshType meshType = new BasicSimplicialMeshType();
+    MeshSource mesher = new PartitionedLineMesher(0.0, 1.0, 128*np, meshType);
+    Mesh mesh = mesher.getMesh();
+
+    CellFilter interior = new MaximalCellFilter();
+    CellFilter points = new DimensionalCellFilter(0);
+    CellFilter right = points.subset(new RightPointTest());
+    CellFilter left = points.subset(new LeftPointTest());
+
+    BasisFamily basis = new Lagrange(2);
+    Expr u = new UnknownFunction(basis, "u");
+    Expr v = new TestFunction(basis, "v");
+
+    Expr dx = new Derivative(0);
+    QuadratureFamily quad = new GaussianQuadrature(4);
+
+    Expr eqn = Integral(interior, 
+      (1.0 + u*u)*(dx*v)*(dx*u) - 10.0*v, quad);
+    Expr bc = EssentialBC(left+right, v*u, quad);
+
+    /* simplified physics for building preconditioners */
+    Expr precEqn = Integral(interior, (dx*v)*(dx*u) - 10.0*v, quad);
+
+    DiscreteSpace ds(mesh, basis, vecType);
+
+    /* Reference solve with an assembled Jacobian */
+    Expr uRef = new DiscreteFunction(ds, 0.0);
+    NonlinearProblem refProb(mesh, eqn, bc, v, u, uRef, vecType);
+
+    LinearSolver<double> directSolver 
+      = LinearSolverBuilder::createSolver("amesos.xml");
+    ParameterList refParams = newtonParams();
+    refParams.remove("Forcing Term");
+    NonlinearSolver<double> refSolver 
+      = new NewtonArmijoSolver<double>(refParams, directSolver);
+
+    SolverState<double> refState = refProb.solve(refSolver);
+    Out::root() << "reference: " << refState.finalIters() 
+                << " iterations" << endl;
+    bool pass = refState.finalState() == SolveConverged;
+
+    LinearSolver<double> iterSolver 
+      = LinearSolverBuilder::createSolver("aztec-ifpack.xml");
+
+    Array<std::string> names = tuple<std::string>(
+      "Jacobian-free, preconditioned", "Jacobian-free, unpreconditioned");
+
+    for (int i=0; i<names.size(); i++)
+    {
+      Expr uSoln = new DiscreteFunction(ds, 0.0);
+      NonlinearProblem prob(mesh, eqn, bc, v, u, uSoln, vecType);
+
+      ParameterList params = newtonParams();
+      LinearSolver<double> linSolver = iterSolver;
+      if (i==0)
+      {
+        NonlinearProblem precProb(mesh, precEqn, bc, v, u, uSoln, vecType);
+        prob.setJacobianFree(precProb);
+      }
+      else
+      {
+        prob.setJacobianFree(true);
+        linSolver = unpreconditionedSolver();
+      }
+
+      NonlinearSolver<double> solver 
+        = new NewtonArmijoSolver<double>(params, linSolver);
+      SolverState<double> state = prob.solve(solver);
+
+      /* the discrete function must hold the converged solution, not a
+       * point perturbed by a Jacobian-free product */
+      Expr diff = Integral(interior, pow(uRef - uSoln, 2.0), quad);
+      double err = sqrt(evaluateIntegral(mesh, diff));
+      Out::root() << names[i] << ": " << state.finalIters() 
+                  << " iterations, difference = " << err << endl;
+
+      pass = pass && state.finalState() == SolveConverged && err < 1.0e-7;
+    }
+
+    Sundance::passFailTest(pass);
+  }
+	catch(std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+  Sundance::finalize(); return Sundance::testStatus(); 
+}
@@ -0,0 +1,160 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+#include "Sundance.hpp"
+
+/** 
+ * Solves the mildly nonlinear equation
+ * 
+ * \f[ -\left((1+u^2) u'\right)' = 10 \f]
+ *
+ * with homogeneous Dirichlet BC on the interval \f$ (0, 1) \f$, once with
+ * a Jacobian built on every Newton step and once with a lagged Jacobian,
+ * lagged preconditioner, and Eisenstat-Walker forcing terms. The two
+ * solutions are compared. 
+ */
+
+CELL_PREDICATE(LeftPointTest, {return fabs(x[0]) < 1.0e-10;})
+CELL_PREDICATE(RightPointTest, {return fabs(x[0]-1.0) < 1.0e-10;})
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    Sundance::init(&argc, &argv);
+    int np = MPIComm::world().getNProc();
+
+    /* We will do our linear algebra using Epetra */
+    VectorType<double> vecType = new EpetraVectorType();
+
+    /* Create a mesh */
+    MeshType meshType = new BasicSimplicialMeshType();
+    MeshSource mesher = new PartitionedLineMesher(0.0, 1.0, 128*np, meshType);
+    Mesh mesh = mesher.getMesh();
+
+    CellFilter interior = new MaximalCellFilter();
+    CellFilter points = new DimensionalCellFilter(0);
+    CellFilter right = points.subset(new RightPointTest());
+    CellFilter left = points.subset(new LeftPointTest());
+
+    BasisFamily basis = new Lagrange(2);
+    Expr u = new UnknownFunction(basis, "u");
+    Expr v = new TestFunction(basis, "v");
+
+    Expr dx = new Derivative(0);
+    QuadratureFamily quad = new GaussianQuadrature(4);
+
+    Expr eqn = Integral(interior, 
+      (1.0 + u*u)*(dx*v)*(dx*u) - 10.0*v, quad);
+    Expr bc = EssentialBC(left+right, v*u, quad);
+
+    DiscreteSpace ds(mesh, basis, vecType);
+
+    /* Reference solve: Jacobian and preconditioner rebuilt every step */
+    Expr uFresh = new DiscreteFunction(ds, 0.0);
+    NonlinearProblem freshProb(mesh, eqn, bc, v, u, uFresh, vecType);
+
+    LinearSolver<double> directSolver 
+      = LinearSolverBuilder::createSolver("amesos.xml");
+    ParameterList freshParams("NewtonArmijoSolver");
+    freshParams.set("Tau Relative", 1.0e-12);
+    freshParams.set("Tau Absolute", 1.0e-12);
+    freshParams.set("Verbosity", 0);    
+    RCP<NewtonArmijoSolver<double> > freshNewton
+      = rcp(new NewtonArmijoSolver<double>(freshParams, directSolver));
+    NonlinearSolver<double> freshSolver(freshNewton);
+
+    SolverState<double> freshState = freshProb.solve(freshSolver);
+
+    /* Lagged solve: Jacobian rebuilt every third step, preconditioner 
+     * every second Jacobian, adaptive linear tolerance */
+    Expr uLagged = new DiscreteFunction(ds, 0.0);
+    NonlinearProblem laggedProb(mesh, eqn, bc, v, u, uLagged, vecType);
+
+    LinearSolver<double> iterSolver 
+      = LinearSolverBuilder::createSolver("aztec-ifpack.xml");
+    ParameterList laggedParams("NewtonArmijoSolver");
+    laggedParams.set("Tau Relative", 1.0e-12);
+    laggedParams.set("Tau Absolute", 1.0e-12);
+    laggedParams.set("Max Iterations", 40);
+    laggedParams.set("Jacobian Rebuild Interval", 3);
+    laggedParams.set("Jacobian Rebuild Ratio", 0.5);
+    laggedParams.set("Preconditioner Rebuild Interval", 2);
+    laggedParams.set("Forcing Term", std::string("Eisenstat-Walker"));
+    laggedParams.set("Verbosity", 0);    
+    RCP<NewtonArmijoSolver<double> > laggedNewton
+      = rcp(new NewtonArmijoSolver<double>(laggedParams, iterSolver));
+    NonlinearSolver<double> laggedSolver(laggedNewton);
+
+    SolverState<double> laggedState = laggedProb.solve(laggedSolver);
+
+    Out::root() << "fresh Jacobian: " << freshState.finalIters() 
+                << " iterations, " << freshNewton->numJacobianBuilds()
+                << " Jacobians" << endl;
+    Out::root() << "lagged Jacobian: " << laggedState.finalIters() 
+                << " iterations, " << laggedNewton->numJacobianBuilds()
+                << " Jacobians, " << laggedNewton->numPreconditionerBuilds()
+                << " preconditioners" << endl;
+
+    Expr diff = Integral(interior, pow(uFresh - uLagged, 2.0), 
+      new GaussianQuadrature(4));
+    double err = sqrt(evaluateIntegral(mesh, diff));
+    Out::root() << "difference = " << err << endl;
+
+    bool pass = freshState.finalState() == SolveConverged
+      && laggedState.finalState() == SolveConverged
+      && err < 1.0e-8;
+
+    /* the fresh solve builds one Jacobian per step; the lagged solve 
+     * must have reused its Jacobians and preconditioners */
+    pass = pass 
+      && freshNewton->numJacobianBuilds() == freshState.finalIters()
+      && laggedNewton->numJacobianBuilds() < laggedState.finalIters()
+      && laggedNewton->numPreconditionerBuilds() 
+      <= laggedNewton->numJacobianBuilds();
+    Sundance::passFailTest(pass);
+  }
+	catch(std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+  Sundance::finalize(); return Sundance::testStatus(); 
+}
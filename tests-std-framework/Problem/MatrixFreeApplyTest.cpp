@@ -0,0 +1,97 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+
+/* 
+ * Applies the operator of a cubic Lagrange Poisson problem to a random
+ * vector, once with the assembled matrix and once element by element
+ * without assembly. The two results must agree.
+ */
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+      int np = MPIComm::world().getNProc();
+
+      VectorType<double> vecType = new EpetraVectorType();
+
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, 8*np, np,
+        0.0, 1.0, 8, 1, meshType);
+      Mesh mesh = mesher.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter bdry = new BoundaryCellFilter();
+
+      BasisFamily basis = new Lagrange(3);
+      Expr u = new UnknownFunction(basis, "u");
+      Expr v = new TestFunction(basis, "v");
+      Expr grad = gradient(2);
+      Expr x = new CoordExpr(0);
+
+      QuadratureFamily quad = new GaussianQuadrature(6);
+      Expr eqn = Integral(interior, (grad*v)*(grad*u) + x*v*u + v, quad);
+      Expr bc = EssentialBC(bdry, v*u, quad);
+
+      LinearProblem prob(mesh, eqn, bc, v, u, vecType);
+      LinearOperator<double> A = prob.getOperator();
+      LinearOperator<double> AFree = prob.getMatrixFreeOperator();
+
+      Vector<double> z = A.domain().createMember();
+      z.randomize();
+      Vector<double> y1 = A*z;
+      Vector<double> y2 = AFree*z;
+      double err = (y1 - y2).norm2() / y1.norm2();
+      Out::root() << "|A*z - AFree*z|/|A*z| = " << err << std::endl;
+      
+      Sundance::passFailTest(err, 1.0e-12);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
@@ -0,0 +1,198 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+#include "SundanceAssembler.hpp"
+#include "SundanceEquationSet.hpp"
+#include "SundanceDOFMapBase.hpp"
+#include <algorithm>
+
+/* 
+ * Builds the matrix graph of a mixed P2-P1 problem with a Dirichlet
+ * condition on one field, and compares it row by row with a graph
+ * built cell by cell into one Set<int> per local row. Rows owned by 
+ * other processors must not appear in the graph, and Dirichlet rows
+ * must hold only the columns coupled by the boundary condition.
+ */
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+      int np = MPIComm::world().getNProc();
+
+      VectorType<double> vecType = new EpetraVectorType();
+
+      int npx = -1;
+      int npy = -1;
+      PartitionedRectangleMesher::balanceXY(np, &npx, &npy);
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, 8*npx, npx,
+        0.0, 1.0, 8*npy, npy, meshType);
+      Mesh mesh = mesher.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter bdry = new BoundaryCellFilter();
+
+      Expr u = new UnknownFunction(new Lagrange(2), "u");
+      Expr v = new TestFunction(new Lagrange(2), "v");
+      Expr p = new UnknownFunction(new Lagrange(1), "p");
+      Expr q = new TestFunction(new Lagrange(1), "q");
+      Expr grad = gradient(2);
+
+      /* every test function is coupled to every unknown in the interior */
+      QuadratureFamily quad = new GaussianQuadrature(4);
+      Expr eqn = Integral(interior, 
+        (grad*v)*(grad*u) + v*p + q*u + q*p, quad);
+      Expr bc = EssentialBC(bdry, v*u, quad);
+
+      Expr unkParams;
+      Expr fixedParams;
+      Array<Expr> fixedFields;
+      Expr unkParamValues;
+      Expr fixedParamValues;
+      Array<Expr> fixedFieldValues;
+      Expr u0 = List(new ZeroExpr(), new ZeroExpr());
+
+      RCP<EquationSet> eqnSet 
+        = rcp(new EquationSet(eqn, bc, tuple(List(v, q)), tuple(List(u, p)), 
+            tuple(u0), unkParams, unkParamValues,
+            fixedParams, fixedParamValues,
+            fixedFields, fixedFieldValues));
+      Assembler assembler(mesh, eqnSet, tuple(vecType), tuple(vecType), false);
+
+      const DOFMapBase& rowMap = *(assembler.rowMap()[0]);
+      const DOFMapBase& colMap = *(assembler.colMap()[0]);
+      const Set<int>& bcRows = *(assembler.bcRows()[0]);
+      int lowestRow = rowMap.lowestLocalDOF();
+      int nRows = rowMap.numLocalDOFs();
+
+      /* reference graph: funcs 0 and 1 are (v,q) in the rows and (u,p) in
+       * the columns */
+      Array<Set<int> > ref(nRows);
+      int nOffProc = 0;
+      Array<int> rowDOFs;
+      Array<int> colDOFs;
+      Array<int> dofs;
+
+      CellSet cells = interior.getCells(mesh);
+      for (CellIterator i=cells.begin(); i!=cells.end(); i++)
+        {
+          int dim = mesh.spatialDim();
+          rowDOFs.resize(0);
+          colDOFs.resize(0);
+          for (int f=0; f<2; f++)
+            {
+              rowMap.getDOFsForCell(dim, *i, f, dofs);
+              for (int j=0; j<dofs.size(); j++) rowDOFs.append(dofs[j]);
+              colMap.getDOFsForCell(dim, *i, f, dofs);
+              for (int j=0; j<dofs.size(); j++) colDOFs.append(dofs[j]);
+            }
+          for (int r=0; r<rowDOFs.size(); r++)
+            {
+              int row = rowDOFs[r] - lowestRow;
+              if (row < 0 || row >= nRows) {nOffProc++; continue;}
+              if (bcRows.contains(row)) continue;
+              for (int c=0; c<colDOFs.size(); c++) ref[row].put(colDOFs[c]);
+            }
+        }
+
+      CellSet bdryCells = bdry.getCells(mesh);
+      for (CellIterator i=bdryCells.begin(); i!=bdryCells.end(); i++)
+        {
+          int dim = mesh.spatialDim() - 1;
+          rowMap.getDOFsForCell(dim, *i, 0, rowDOFs);
+          colMap.getDOFsForCell(dim, *i, 0, colDOFs);
+          for (int r=0; r<rowDOFs.size(); r++)
+            {
+              int row = rowDOFs[r] - lowestRow;
+              if (row < 0 || row >= nRows) continue;
+              if (!bcRows.contains(row)) continue;
+              for (int c=0; c<colDOFs.size(); c++) ref[row].put(colDOFs[c]);
+            }
+        }
+
+      Array<int> graphData;
+      Array<int> rowPtrs;
+      Array<int> nnzPerRow;
+      assembler.getGraph(0, 0, graphData, rowPtrs, nnzPerRow);
+
+      int nBadRows = 0;
+      if (rowPtrs.size() != nRows || nnzPerRow.size() != nRows) 
+        {
+          nBadRows = nRows;
+        }
+      else
+        {
+          for (int r=0; r<nRows; r++)
+            {
+              Array<int> cols(nnzPerRow[r]);
+              for (int j=0; j<nnzPerRow[r]; j++) 
+                cols[j] = graphData[rowPtrs[r] + j];
+              std::sort(cols.begin(), cols.end());
+              Array<int> refCols = ref[r].elements();
+              if (cols.size() != refCols.size()
+                || !std::equal(cols.begin(), cols.end(), refCols.begin())) 
+                nBadRows++;
+            }
+        }
+
+      Out::os() << "p=" << MPIComm::world().getRank() 
+                << " local rows=" << nRows 
+                << " BC rows=" << bcRows.size()
+                << " off-processor rows skipped=" << nOffProc
+                << " nonzeros=" << graphData.size()
+                << " mismatched rows=" << nBadRows << std::endl;
+
+      int nBad = nBadRows;
+      MPIComm::world().allReduce(&nBadRows, &nBad, 1, MPIDataType::intType(),
+        MPIOp::sumOp());
+      Sundance::passFailTest(nBad == 0);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
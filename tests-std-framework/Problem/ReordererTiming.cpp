@@ -0,0 +1,177 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+#include "PlayaEpetraMatrix.hpp"
+#include "Epetra_CrsMatrix.h"
+#include "Teuchos_Time.hpp"
+
+/* 
+ * Compares assembly time and matrix bandwidth for a P1 Poisson problem
+ * on the unit disk under the available cell orderings. The solution
+ * norm must be independent of the ordering. Cells of lower dimension 
+ * must be walked in LID order, and the boundary must contain the same
+ * cells, whatever the ordering of the maximal cells. Under the identity
+ * ordering, maximal cells must be walked in contiguous blocks.
+ */
+
+int bandwidth(const LinearOperator<double>& A)
+{
+  RCP<const Epetra_CrsMatrix> crs = EpetraMatrix::getConcretePtr(A);
+  int rtn = 0;
+  for (int r=0; r<crs->NumMyRows(); r++)
+  {
+    int nnz;
+    double* vals;
+    int* cols;
+    crs->ExtractMyRowView(r, nnz, vals, cols);
+    for (int k=0; k<nnz; k++)
+    {
+      int b = std::abs(cols[k] - r);
+      if (b > rtn) rtn = b;
+    }
+  }
+  return rtn;
+}
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+
+      VectorType<double> vecType = new EpetraVectorType();
+      LinearSolver<double> solver 
+        = LinearSolverBuilder::createSolver("amesos.xml");
+
+      Array<std::string> names = tuple<std::string>("identity", "Morton", 
+        "Hilbert", "RCM");
+      Array<CellReorderer> orderings 
+        = tuple<CellReorderer>(new IdentityReorderer(), 
+          new MortonReorderer(), new HilbertReorderer(), 
+          new RCMReorderer());
+
+      int nReps = 5;
+      double refNorm = 0.0;
+      double err = 0.0;
+      int refNumBdry = 0;
+      int badIter = 0;
+
+      for (int i=0; i<names.size(); i++)
+      {
+        MeshType meshType = new BasicSimplicialMeshType();
+        meshType.setReorderer(orderings[i]);
+        MeshSource meshReader = new TriangleMeshReader("disk.1", meshType);
+        Mesh mesh = meshReader.getMesh();
+
+        CellFilter interior = new MaximalCellFilter();
+        CellFilter bdry = new BoundaryCellFilter();
+
+        /* only a real reordering should force cell-by-cell walks */
+        CellSet maxCells = interior.getCells(mesh);
+        if (maxCells.begin().isContiguous() != (i==0)) badIter++;
+
+        for (int d=0; d<mesh.spatialDim(); d++)
+        {
+          CellFilter dimCells = new DimensionalCellFilter(d);
+          CellSet cells = dimCells.getCells(mesh);
+          int expected = 0;
+          for (CellIterator c=cells.begin(); c!=cells.end(); c++, expected++)
+          {
+            if (*c != expected) badIter++;
+          }
+          if (expected != mesh.numCells(d)) badIter++;
+        }
+
+        CellSet bdryCells = bdry.getCells(mesh);
+        int numBdry = 0;
+        for (CellIterator c=bdryCells.begin(); c!=bdryCells.end(); c++)
+        {
+          if (*c < 0 || *c >= mesh.numCells(1)) badIter++;
+          numBdry++;
+        }
+        if (i==0) refNumBdry = numBdry;
+        if (numBdry != refNumBdry || numBdry == 0) badIter++;
+
+        Expr u = new UnknownFunction(new Lagrange(1), "u");
+        Expr v = new TestFunction(new Lagrange(1), "v");
+        Expr grad = gradient(2);
+
+        QuadratureFamily quad = new GaussianQuadrature(2);
+        Expr eqn = Integral(interior, (grad*v)*(grad*u) + v, quad);
+        Expr bc = EssentialBC(bdry, v*u, quad);
+
+        LinearProblem prob(mesh, eqn, bc, v, u, vecType);
+
+        Time timer(names[i]);
+        LinearOperator<double> A;
+        for (int r=0; r<nReps; r++)
+        {
+          timer.start();
+          A = prob.getOperator();
+          timer.stop();
+        }
+
+        Expr soln = prob.solve(solver);
+        double norm = L2Norm(mesh, interior, soln, quad);
+        if (i==0) refNorm = norm;
+        err = std::max(err, std::fabs(norm - refNorm));
+
+        Out::root() << std::setw(10) << names[i] 
+                    << " assembly time = " 
+                    << timer.totalElapsedTime()/nReps
+                    << " bandwidth = " << bandwidth(A) 
+                    << " |u| = " << norm << std::endl;
+      }
+      
+      Out::root() << "cell iteration errors = " << badIter << std::endl;
+      if (badIter > 0) err = 1.0;
+      
+      Sundance::passFailTest(err, 1.0e-10);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
@@ -0,0 +1,160 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "Sundance.hpp"
+#include "SundanceAssembler.hpp"
+
+using Sundance::List;
+
+/* 
+ * Assembles a coupled two-field problem with one thread and again with
+ * several threads evaluating the integral groups. The matrices and 
+ * right-hand sides must agree exactly. Without OpenMP, both 
+ * assemblies are single-threaded and the test is trivially passed.
+ *
+ * Only the integral groups of a workset are threaded, so the test also
+ * times the assembly of a single-field Laplacian, whose interior 
+ * integrals form a single group, and reports the speedup. No speedup 
+ * is expected there; the timing is reported, not checked.
+ */
+
+/* Assembles a Laplacian with the given number of threads, returning 
+ * the operator and the time taken */
+static LinearOperator<double> timeLaplacian(const Mesh& mesh, 
+  const VectorType<double>& vecType, int nThreads, double& t)
+{
+  CellFilter interior = new MaximalCellFilter();
+  CellFilter bdry = new BoundaryCellFilter();
+  BasisFamily basis = new Lagrange(2);
+  Expr u = new UnknownFunction(basis, "u");
+  Expr v = new TestFunction(basis, "v");
+  Expr grad = gradient(2);
+  QuadratureFamily quad = new GaussianQuadrature(4);
+  Expr eqn = Integral(interior, (grad*v)*(grad*u), quad);
+  Expr bc = EssentialBC(bdry, v*u, quad);
+
+  Assembler::numAssemblyThreads() = nThreads;
+  LinearProblem prob(mesh, eqn, bc, v, u, vecType);
+  Time timer("laplacian");
+  timer.start();
+  LinearOperator<double> A = prob.getOperator();
+  timer.stop();
+  Assembler::numAssemblyThreads() = 1;
+
+  t = timer.totalElapsedTime();
+  return A;
+}
+
+int main(int argc, char** argv)
+{
+  try
+    {
+      Sundance::init(&argc, &argv);
+      int np = MPIComm::world().getNProc();
+
+      VectorType<double> vecType = new EpetraVectorType();
+
+      MeshType meshType = new BasicSimplicialMeshType();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, 16*np, np,
+        0.0, 1.0, 16, 1, meshType);
+      Mesh mesh = mesher.getMesh();
+
+      CellFilter interior = new MaximalCellFilter();
+      CellFilter bdry = new BoundaryCellFilter();
+
+      BasisFamily basis = new Lagrange(2);
+      Expr u = List(new UnknownFunction(basis, "u1"),
+        new UnknownFunction(basis, "u2"));
+      Expr v = List(new TestFunction(basis, "v1"),
+        new TestFunction(basis, "v2"));
+      Expr grad = gradient(2);
+      Expr x = new CoordExpr(0);
+      Expr y = new CoordExpr(1);
+
+      QuadratureFamily quad = new GaussianQuadrature(4);
+      Expr eqn = Integral(interior, 
+        (grad*v[0])*(grad*u[0]) + (grad*v[1])*(grad*u[1])
+        + x*v[0]*u[1] - y*v[1]*u[0] + v[0]*(x*y) + v[1], quad);
+      Expr bc = EssentialBC(bdry, v[0]*u[0] + v[1]*u[1], quad);
+
+      Assembler::numAssemblyThreads() = 1;
+      LinearProblem serialProb(mesh, eqn, bc, v, u, vecType);
+      LinearOperator<double> A1 = serialProb.getOperator();
+      Vector<double> b1 = serialProb.getSingleRHS();
+
+      Assembler::numAssemblyThreads() = 4;
+      LinearProblem threadedProb(mesh, eqn, bc, v, u, vecType);
+      LinearOperator<double> A2 = threadedProb.getOperator();
+      Vector<double> b2 = threadedProb.getSingleRHS();
+      Assembler::numAssemblyThreads() = 1;
+
+      Vector<double> z = A1.domain().createMember();
+      z.randomize();
+      double matErr = (A1*z - A2*z).normInf();
+      double rhsErr = (b1 - b2).normInf();
+      Out::root() << "|A1*z - A2*z| = " << matErr << std::endl;
+      Out::root() << "|b1 - b2| = " << rhsErr << std::endl;
+
+      MeshSource bigMesher = new PartitionedRectangleMesher(0.0, 1.0, 
+        64*np, np, 0.0, 1.0, 64, 1, meshType);
+      Mesh bigMesh = bigMesher.getMesh();
+      double t1 = 0.0;
+      double t4 = 0.0;
+      LinearOperator<double> L1 = timeLaplacian(bigMesh, vecType, 1, t1);
+      LinearOperator<double> L4 = timeLaplacian(bigMesh, vecType, 4, t4);
+      Vector<double> w = L1.domain().createMember();
+      w.randomize();
+      double lapErr = (L1*w - L4*w).normInf();
+      Out::root() << "single-group Laplacian: 1 thread " << t1 
+                  << "s, 4 threads " << t4 << "s, speedup " 
+                  << t1/std::max(t4, 1.0e-12) << std::endl;
+      Out::root() << "|L1*w - L4*w| = " << lapErr << std::endl;
+      
+      Sundance::passFailTest(matErr + rhsErr + lapErr, 0.0);
+    }
+  catch(std::exception& e)
+    {
+      Sundance::handleException(e);
+    }
+  Sundance::finalize();
+  return Sundance::testStatus();
+}
@@ -0,0 +1,186 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundanceMeshTransformation.hpp"
+#include "SundanceExtrusionMeshTransformation.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+#include "SundanceFieldWriter.hpp"
+#include "SundanceBinaryMeshWriter.hpp"
+#include "SundanceBinaryMeshReader.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/*
+ * Writes a 3D mesh to a binary checkpoint, reloads it, and checks 
+ * that cells, connectivity, numbering, labels and ownership all
+ * survive the round trip. Also reports build and reload times.
+ */
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+		{
+      GlobalMPISession session(&argc, &argv);
+
+      int n = 16;
+      if (argc > 1) n = atoi(argv[1]);
+      int np = MPIComm::world().getNProc();
+
+      MeshType meshType = new BasicSimplicialMeshType();
+
+      Time buildTimer("build");
+      buildTimer.start();
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n*np, np,
+                                                         0.0, 1.0, n, 1,
+                                                         meshType);
+      Mesh mesh2D = mesher.getMesh();
+      MeshTransformation extruder 
+        = new ExtrusionMeshTransformation(0.0, 1.0, n, meshType);
+      Mesh mesh = extruder.apply(mesh2D);
+      buildTimer.stop();
+
+      int dim = mesh.spatialDim();
+
+      /* put some labels on the boundary faces so we can check them */
+      for (int f=0; f<mesh.numCells(dim-1); f++)
+        {
+          if (mesh.numMaxCofacets(dim-1, f)==1) mesh.setLabel(dim-1, f, 7);
+        }
+
+      FieldWriter w = new BinaryMeshWriter("checkpointTest");
+      w.addMesh(mesh);
+      w.write();
+
+      Time reloadTimer("reload");
+      reloadTimer.start();
+      MeshSource reader = new BinaryMeshReader("checkpointTest", meshType);
+      Mesh restored = reader.getMesh();
+      reloadTimer.stop();
+
+      std::cout << "num elements = " << mesh.numCells(dim) << std::endl;
+      std::cout << "build time = " << buildTimer.totalElapsedTime() 
+                << "s, reload time = " << reloadTimer.totalElapsedTime() 
+                << "s" << std::endl;
+
+      for (int d=0; d<=dim; d++)
+        {
+          if (mesh.numCells(d) != restored.numCells(d))
+            {
+              std::cout << "mismatch in number of " << d << "-cells" 
+                        << std::endl;
+              stat = -1;
+              continue;
+            }
+          for (int c=0; c<mesh.numCells(d); c++)
+            {
+              if (mesh.label(d, c) != restored.label(d, c)
+                || mesh.ownerProcID(d, c) != restored.ownerProcID(d, c))
+                {
+                  stat = -1;
+                }
+              if (d==0 || d==dim)
+                {
+                  int gid = mesh.mapLIDToGID(d, c);
+                  if (restored.mapLIDToGID(d, c) != gid
+                    || restored.mapGIDToLID(d, gid) != c) stat = -1;
+                }
+              if (d < dim)
+                {
+                  int nc = mesh.numMaxCofacets(d, c);
+                  if (nc != restored.numMaxCofacets(d, c)) 
+                    {
+                      stat = -1;
+                      continue;
+                    }
+                  for (int j=0; j<nc; j++)
+                    {
+                      int f1, f2;
+                      if (mesh.maxCofacetLID(d, c, j, f1) 
+                        != restored.maxCofacetLID(d, c, j, f2) 
+                        || f1 != f2) stat = -1;
+                    }
+                }
+              else
+                {
+                  for (int fd=0; fd<dim; fd++)
+                    {
+                      int nf = mesh.numFacets(d, c, fd);
+                      for (int j=0; j<nf; j++)
+                        {
+                          int o1, o2;
+                          if (mesh.facetLID(d, c, fd, j, o1)
+                            != restored.facetLID(d, c, fd, j, o2)
+                            || o1 != o2) stat = -1;
+                        }
+                    }
+                }
+            }
+        }
+
+      double maxErr = 0.0;
+      for (int i=0; i<mesh.numCells(0); i++)
+        {
+          Point dx = mesh.nodePosition(i) - restored.nodePosition(i);
+          maxErr = std::max(maxErr, ::sqrt(dx*dx));
+        }
+      if (maxErr > 0.0) stat = -1;
+
+      if (stat == 0) std::cout << "test PASSED" << std::endl;
+      else std::cout << "test FAILED" << std::endl;
+    }
+	catch(std::exception& e)
+		{
+      stat = -1;
+      std::cerr << e.what() << std::endl;
+		}
+  return stat;
+}
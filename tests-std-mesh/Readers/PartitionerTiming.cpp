@@ -0,0 +1,168 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+#include "SundanceInertialPartitioner.hpp"
+#include "SundanceFileIOChacoPartitioner.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/*
+ * Times the in-memory inertial partitioner and reports edge cut and 
+ * load balance. If the second command-line argument is "chaco", the 
+ * same mesh is also partitioned through the file-based Chaco interface
+ * for comparison; this requires a chaco executable in the path. 
+ * Use n=708 for a mesh of about a million cells.
+ */
+
+static double partition(const SerialPartitionerBase& part, 
+  const Mesh& mesh, int np, Array<int>& assignments)
+{
+  Time timer("partition");
+  timer.start();
+  part.getAssignments(mesh, np, assignments);
+  timer.stop();
+
+  return timer.totalElapsedTime();
+}
+
+static void report(const std::string& name, double t, int np,
+  const Array<int>& ptr, const Array<int>& adj, 
+  const Array<int>& assignments,
+  int& edgeCut, double& imbalance)
+{
+  SerialPartitionerBase::getPartitionStatistics(np, ptr, adj, 
+    assignments, edgeCut, imbalance);
+  std::cout << name << ": time=" << t << "s edge cut=" << edgeCut
+            << " imbalance=" << imbalance << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+		{
+      GlobalMPISession session(&argc, &argv);
+
+      int n = 128;
+      if (argc > 1) n = atoi(argv[1]);
+      bool runChaco = (argc > 2) && std::string(argv[2])=="chaco";
+
+      MeshType meshType = new BasicSimplicialMeshType();
+
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+                                                         0.0, 1.0, n, 1,
+                                                         meshType);
+      Mesh mesh = mesher.getMesh();
+      int nElems = mesh.numCells(2);
+      std::cout << "num elements = " << nElems << std::endl;
+
+      InertialPartitioner rib(false);
+      InertialPartitioner part(true, 0.03);
+
+      Array<int> ptr;
+      Array<int> adj;
+      Time graphTimer("dual graph");
+      graphTimer.start();
+      part.getDualGraph(mesh, ptr, adj);
+      graphTimer.stop();
+      std::cout << "dual graph: time=" << graphTimer.totalElapsedTime() 
+                << "s edges=" << adj.size()/2 << std::endl;
+
+      /* the n by n rectangle has 3n^2-2n interior triangle sides */
+      if (adj.size()/2 != 3*n*n - 2*n) stat = -1;
+
+      int np[] = {2, 3, 8, 16};
+      for (int i=0; i<4; i++)
+        {
+          std::cout << "--- np=" << np[i] << std::endl;
+          int cut;
+          double imbalance;
+
+          Array<int> ribAssignments;
+          double tRib = partition(rib, mesh, np[i], ribAssignments);
+          report("bisection only", tRib, np[i], ptr, adj, ribAssignments, 
+            cut, imbalance);
+          int ribCut = cut;
+
+          Array<int> assignments;
+          double t = partition(part, mesh, np[i], assignments);
+          report("bisection+refinement", t, np[i], ptr, adj, assignments, 
+            cut, imbalance);
+
+          /* refinement must not make the cut worse or break balance */
+          if (cut > ribCut || imbalance > 1.03 + ((double) np[i])/nElems) stat = -1;
+
+          /* every processor must get some elements */
+          Array<int> partSize(np[i], 0);
+          for (int c=0; c<assignments.size(); c++) partSize[assignments[c]]++;
+          for (int p=0; p<np[i]; p++) if (partSize[p]==0) stat = -1;
+
+          if (runChaco)
+            {
+              FileIOChacoPartitioner chaco("partTiming");
+              Array<int> chacoAssignments;
+              double tChaco = partition(chaco, mesh, np[i], chacoAssignments);
+              report("chaco", tChaco, np[i], ptr, adj, chacoAssignments,
+                cut, imbalance);
+            }
+        }
+
+      if (stat == 0) std::cout << "test PASSED" << std::endl;
+      else std::cout << "test FAILED" << std::endl;
+    }
+	catch(std::exception& e)
+		{
+      stat = -1;
+      std::cerr << e.what() << std::endl;
+		}
+  return stat;
+}
@@ -0,0 +1,149 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+#include "SundanceFieldWriter.hpp"
+#include "SundanceTriangleWriter.hpp"
+#include "SundanceTriangleMeshReader.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/*
+ * Compares load times of the line-by-line and the in-place Triangle 
+ * mesh file parsers, and checks that both produce the same mesh.
+ */
+
+static double readMesh(const MeshType& meshType, bool fast, Mesh& mesh)
+{
+  MeshReaderBase::useFastParser() = fast;
+  MeshSource reader = new TriangleMeshReader("triReaderTiming", meshType);
+
+  Time timer("read");
+  timer.start();
+  mesh = reader.getMesh();
+  timer.stop();
+
+  return timer.totalElapsedTime();
+}
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+		{
+      GlobalMPISession session(&argc, &argv);
+
+      int n = 256;
+      if (argc > 1) n = atoi(argv[1]);
+
+      MeshType meshType = new BasicSimplicialMeshType();
+
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+                                                         0.0, 1.0, n, 1,
+                                                         meshType);
+      Mesh mesh = mesher.getMesh();
+
+      FieldWriter w = new TriangleWriter("triReaderTiming");
+      w.addMesh(mesh);
+      w.write();
+
+      Mesh refMesh;
+      Mesh fastMesh;
+      double tRef = readMesh(meshType, false, refMesh);
+      double tFast = readMesh(meshType, true, fastMesh);
+      MeshReaderBase::useFastParser() = true;
+
+      std::cout << "num elements = " << refMesh.numCells(2) << std::endl;
+      std::cout << "num nodes = " << refMesh.numCells(0) << std::endl;
+      std::cout << "reference parser: time=" << tRef << "s" << std::endl;
+      std::cout << "fast parser: time=" << tFast << "s"
+                << " speedup=" << tRef/std::max(tFast, 1.0e-12) << std::endl;
+
+      /* check that both parsers built the same mesh */
+      for (int d=0; d<=2; d++)
+        {
+          if (refMesh.numCells(d) != fastMesh.numCells(d))
+            {
+              std::cout << "mismatch in number of " << d << "-cells: "
+                        << refMesh.numCells(d) << " vs " 
+                        << fastMesh.numCells(d) << std::endl;
+              stat = -1;
+            }
+        }
+
+      double maxErr = 0.0;
+      for (int i=0; i<refMesh.numCells(0); i++)
+        {
+          Point dx = refMesh.nodePosition(i) - fastMesh.nodePosition(i);
+          maxErr = std::max(maxErr, ::sqrt(dx*dx));
+        }
+      for (int c=0; c<refMesh.numCells(2); c++)
+        {
+          for (int f=0; f<3; f++)
+            {
+              int o = 0;
+              if (refMesh.facetLID(2, c, 0, f, o) 
+                != fastMesh.facetLID(2, c, 0, f, o)) stat = -1;
+            }
+        }
+      std::cout << "max node position difference = " << maxErr << std::endl;
+      if (maxErr > 0.0) stat = -1;
+
+      if (stat == 0) std::cout << "test PASSED" << std::endl;
+      else std::cout << "test FAILED" << std::endl;
+    }
+	catch(std::exception& e)
+		{
+      stat = -1;
+      std::cerr << e.what() << std::endl;
+		}
+  return stat;
+}
@@ -0,0 +1,153 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceBasicSimplicialMesh.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundanceMeshTransformation.hpp"
+#include "SundanceExtrusionMeshTransformation.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/*
+ * Compares memory use and traversal time of the upward connectivity
+ * tables of a tetrahedral mesh before and after freezeTopology() packs
+ * them into compressed-sparse-row form.
+ */
+
+static double traverse(const Mesh& mesh, int nReps, int& checksum)
+{
+  int dim = mesh.spatialDim();
+  Array<int> cofacets;
+  checksum = 0;
+
+  Time timer("traverse");
+  timer.start();
+  for (int r=0; r<nReps; r++)
+    {
+      for (int d=0; d<dim; d++)
+        {
+          for (int c=0; c<mesh.numCells(d); c++)
+            {
+              mesh.getCofacets(d, c, dim, cofacets);
+              for (int i=0; i<cofacets.size(); i++) checksum += cofacets[i];
+              for (int cd=d+1; cd<dim; cd++)
+                {
+                  mesh.getCofacets(d, c, cd, cofacets);
+                  for (int i=0; i<cofacets.size(); i++) checksum += cofacets[i];
+                }
+            }
+        }
+    }
+  timer.stop();
+  return timer.totalElapsedTime();
+}
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+		{
+      GlobalMPISession session(&argc, &argv);
+
+      int n = 32;
+      if (argc > 1) n = atoi(argv[1]);
+      int nReps = 4;
+
+      MeshType meshType = new BasicSimplicialMeshType();
+
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+                                                         0.0, 1.0, n, 1,
+                                                         meshType);
+      Mesh mesh2D = mesher.getMesh();
+      MeshTransformation extruder 
+        = new ExtrusionMeshTransformation(0.0, 1.0, n, meshType);
+      Mesh mesh = extruder.apply(mesh2D);
+
+      const BasicSimplicialMesh* bsm 
+        = dynamic_cast<const BasicSimplicialMesh*>(mesh.ptr().get());
+      TEUCHOS_TEST_FOR_EXCEPT(bsm==0);
+
+      std::cout << "num elements = " << mesh.numCells(3) << std::endl;
+
+      int sumBefore = 0;
+      size_t bytesBefore = bsm->cofacetTableBytes();
+      double tBefore = traverse(mesh, nReps, sumBefore);
+
+      mesh.freezeTopology();
+
+      int sumAfter = 0;
+      size_t bytesAfter = bsm->cofacetTableBytes();
+      double tAfter = traverse(mesh, nReps, sumAfter);
+
+      std::cout << "row storage: " << bytesBefore << " bytes (plus one heap "
+                << "block per row), traversal time=" << tBefore << "s" 
+                << std::endl;
+      std::cout << "CSR storage: " << bytesAfter << " bytes, traversal time="
+                << tAfter << "s" << std::endl;
+      std::cout << "memory ratio=" 
+                << ((double) bytesAfter)/std::max(bytesBefore, (size_t) 1)
+                << " time ratio=" << tAfter/std::max(tBefore, 1.0e-12) 
+                << std::endl;
+
+      if (sumBefore != sumAfter) 
+        {
+          std::cout << "checksum mismatch: " << sumBefore << " vs " 
+                    << sumAfter << std::endl;
+          stat = -1;
+        }
+    }
+	catch(std::exception& e)
+		{
+      stat = -1;
+      std::cerr << e.what() << std::endl;
+		}
+  return stat;
+}
@@ -0,0 +1,277 @@
+/* @HEADER@ */
+// ************************************************************************
+// 
+//                             Sundance
+//                 Copyright 2011 Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Kevin Long (kevin.long@ttu.edu)
+// 
+
+/* @HEADER@ */
+
+
+#include "SundanceOut.hpp"
+#include "Teuchos_Time.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "SundanceMeshType.hpp"
+#include "SundanceBasicSimplicialMeshType.hpp"
+#include "SundanceMesh.hpp"
+#include "SundanceMeshSource.hpp"
+#include "SundanceMeshTransformation.hpp"
+#include "SundanceExtrusionMeshTransformation.hpp"
+#include "SundancePartitionedRectangleMesher.hpp"
+#include "SundanceFieldWriter.hpp"
+#include "SundanceVTKWriter.hpp"
+#include "SundanceCellLIDMappedFieldWrapper.hpp"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+
+using namespace Sundance;
+using namespace Teuchos;
+
+/*
+ * Compares write time and file size of the ASCII, inline binary, and 
+ * appended raw binary VTK formats for a 3D mesh with one point field
+ * and one cell field. The point coordinates and both fields are read 
+ * back from each binary file and compared with the ASCII file.
+ */
+
+static long fileSize(const std::string& name)
+{
+  std::ifstream is(name.c_str(), std::ios::in | std::ios::binary);
+  is.seekg(0, std::ios::end);
+  return is.tellg();
+}
+
+static std::string readFile(const std::string& name)
+{
+  std::ifstream is(name.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream ss;
+  ss << is.rdbuf();
+  return ss.str();
+}
+
+static std::string base64Decode(const std::string& s)
+{
+  static const std::string table = 
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string rtn;
+  unsigned int w = 0;
+  int nBits = 0;
+  for (unsigned int i=0; i<s.size() && s[i] != '='; i++)
+    {
+      w = (w << 6) | table.find(s[i]);
+      nBits += 6;
+      if (nBits >= 8)
+        {
+          nBits -= 8;
+          rtn += (char) ((w >> nBits) & 0xff);
+        }
+    }
+  return rtn;
+}
+
+/* Reads the Float32 DataArray whose opening tag follows the first 
+ * occurrence of key, in any of the three formats. Binary blocks are
+ * a 32-bit byte count followed by the data, in the writer's byte order,
+ * which is the byte order of this machine. */
+static Array<float> readFloatArray(const std::string& file, 
+  const std::string& key)
+{
+  Array<float> rtn;
+  std::string::size_type start = file.find(key);
+  TEUCHOS_TEST_FOR_EXCEPTION(start == std::string::npos, std::runtime_error,
+    "key [" << key << "] not found in VTK file");
+  /* the key is either inside the DataArray tag or precedes it */
+  std::string::size_type prev = file.rfind("<DataArray", start);
+  if (prev != std::string::npos && file.find(">", prev) > start) start = prev;
+  else start = file.find("<DataArray", start);
+  std::string::size_type tagEnd = file.find(">", start);
+  std::string::size_type end = file.find("</DataArray>", tagEnd);
+  std::string tag = file.substr(start, tagEnd - start);
+  std::string body = file.substr(tagEnd+1, end - tagEnd - 1);
+
+  std::string raw;
+  if (tag.find("format=\"ascii\"") != std::string::npos)
+    {
+      std::istringstream is(body);
+      float x;
+      while (is >> x) rtn.append(x);
+      return rtn;
+    }
+  else if (tag.find("format=\"binary\"") != std::string::npos)
+    {
+      std::istringstream is(body);
+      std::string encoded;
+      is >> encoded;
+      /* the 4-byte size header is encoded on its own, in 8 characters */
+      raw = base64Decode(encoded.substr(0, 8)) 
+        + base64Decode(encoded.substr(8));
+    }
+  else
+    {
+      std::string::size_type off = tag.find("offset=\"");
+      TEUCHOS_TEST_FOR_EXCEPTION(off == std::string::npos, std::runtime_error,
+        "DataArray [" << key << "] has no format or offset");
+      int offset = atoi(tag.c_str() + off + 8);
+      std::string::size_type data = file.find("<AppendedData");
+      data = file.find("_", data) + 1 + offset;
+      unsigned int nBytes = 0;
+      std::memcpy(&nBytes, file.data() + data, sizeof(nBytes));
+      raw = file.substr(data, sizeof(nBytes) + nBytes);
+    }
+
+  unsigned int nBytes = 0;
+  std::memcpy(&nBytes, raw.data(), sizeof(nBytes));
+  TEUCHOS_TEST_FOR_EXCEPTION(raw.size() != sizeof(nBytes) + nBytes, 
+    std::runtime_error, "DataArray [" << key << "] has a size header of "
+    << nBytes << " bytes but holds " << raw.size() - sizeof(nBytes));
+  rtn.resize(nBytes/sizeof(float));
+  if (rtn.size() > 0) 
+    std::memcpy(&(rtn[0]), raw.data() + sizeof(nBytes), nBytes);
+  return rtn;
+}
+
+/* Compares binary values with the ASCII ones, which are written with 
+ * six significant digits */
+static bool sameValues(const Array<float>& ascii, const Array<float>& bin)
+{
+  if (ascii.size() != bin.size()) return false;
+  for (int i=0; i<ascii.size(); i++)
+    {
+      if (fabs(ascii[i] - bin[i]) > 1.0e-5*fabs(bin[i]) + 1.0e-12) 
+        return false;
+    }
+  return true;
+}
+
+
+int main(int argc, char** argv)
+{
+  int stat = 0;
+  try
+		{
+      GlobalMPISession session(&argc, &argv);
+
+      int n = 32;
+      MeshType meshType = new BasicSimplicialMeshType();
+
+      MeshSource mesher = new PartitionedRectangleMesher(0.0, 1.0, n, 1,
+                                                         0.0, 1.0, n, 1,
+                                                         meshType);
+      Mesh mesh2D = mesher.getMesh();
+      MeshTransformation extruder 
+        = new ExtrusionMeshTransformation(0.0, 1.0, n, meshType);
+      Mesh mesh = extruder.apply(mesh2D);
+
+      int nNodes = mesh.numCells(0);
+      int nCells = mesh.numCells(3);
+
+      RCP<Array<double> > nodeData = rcp(new Array<double>(nNodes));
+      for (int i=0; i<nNodes; i++) (*nodeData)[i] = sin(0.01*i);
+      RCP<Array<double> > cellData = rcp(new Array<double>(nCells));
+      for (int c=0; c<nCells; c++) (*cellData)[c] = cos(0.01*c);
+
+      RCP<FieldBase> nodeField 
+        = rcp(new CellLIDMappedFieldWrapper(0, 1, nodeData));
+      RCP<FieldBase> cellField 
+        = rcp(new CellLIDMappedFieldWrapper(3, 1, cellData));
+
+      Array<VTKFormat> formats = tuple(VTKAscii, VTKBinary, VTKAppended);
+      Array<std::string> names = tuple<std::string>("ascii", "binary", 
+        "appended");
+
+      std::cout << "num elements = " << nCells << std::endl;
+      std::cout << "num nodes = " << nNodes << std::endl;
+
+      double tAscii = 0.0;
+      long sizeAscii = 0;
+      Array<std::string> keys = tuple<std::string>("<Points>", 
+        "Name=\"u\"", "Name=\"c\"");
+      Array<Array<float> > asciiVals(keys.size());
+      for (int i=0; i<formats.size(); i++)
+        {
+          std::string filename = "vtkTiming-" + names[i];
+          FieldWriter w = new VTKWriter(filename, formats[i]);
+          w.addMesh(mesh);
+          w.addField("u", nodeField);
+          w.addField("c", cellField);
+
+          Time timer("write");
+          timer.start();
+          w.write();
+          timer.stop();
+
+          double t = timer.totalElapsedTime();
+          long size = fileSize(filename + ".vtu");
+          if (i==0)
+            {
+              tAscii = t;
+              sizeAscii = size;
+            }
+          if (size <= 0) stat = -1;
+
+          std::string contents = readFile(filename + ".vtu");
+          for (int k=0; k<keys.size(); k++)
+            {
+              Array<float> vals = readFloatArray(contents, keys[k]);
+              if (i==0) 
+                {
+                  asciiVals[k] = vals;
+                }
+              else if (!sameValues(asciiVals[k], vals))
+                {
+                  std::cout << names[i] << ": DataArray " << keys[k] 
+                            << " differs from ascii" << std::endl;
+                  stat = -1;
+                }
+            }
+
+          std::cout << names[i] << ": time=" << t 
+                    << "s size=" << size << " bytes"
+                    << " time ratio to ascii=" << t/std::max(tAscii, 1.0e-12)
+                    << " size ratio to ascii=" 
+                    << ((double) size)/std::max(sizeAscii, 1L) 
+                    << std::endl;
+        }
+    }
+	catch(std::exception& e)
+		{
+      stat = -1;
+      std::cerr << e.what() << std::endl;
+		}
+  return stat;
+}